@@ -55,6 +55,33 @@
         } while(false)
 #endif
 
+#ifndef CPU_PAUSE
+/**
+ * @brief spin-wait hint
+ */
+#    if _WIN32 || _WIN64
+#        define CPU_PAUSE() YieldProcessor()
+#    elif __x86_64__ || __i386__
+#        define CPU_PAUSE() __builtin_ia32_pause()
+#    elif __aarch64__ || __arm__
+#        define CPU_PAUSE() __asm__ __volatile__("yield")
+#    else
+#        define CPU_PAUSE() pass
+#    endif
+#endif
+
+#ifndef CACHE_LINE_SIZE
+/**
+ * @brief destructive interference size, for alignas
+ * @note  fixed value: std::hardware_destructive_interference_size may differ by compiler flags (ABI)
+ */
+#    if __APPLE__ && __aarch64__
+#        define CACHE_LINE_SIZE 128
+#    else
+#        define CACHE_LINE_SIZE 64
+#    endif
+#endif
+
 #ifndef IN
 #    define IN
 #endif
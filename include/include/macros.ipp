@@ -21,9 +21,13 @@
 
 #if defined(__BYTE_ORDER__)
 #    if __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
-#        define BIG_ENDIAN
+#        ifndef BIG_ENDIAN // glibc endian.h: defined as a value
+#            define BIG_ENDIAN
+#        endif
 #    elif __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
-#        define LITTLE_ENDIAN
+#        ifndef LITTLE_ENDIAN
+#            define LITTLE_ENDIAN
+#        endif
 #    else
 #        error Unknown Endian
 #    endif
@@ -32,10 +36,15 @@
 #ifndef prop
 /**
  * @brief property
+ * @note  MSVC only: elsewhere the declaration is a member type, no storage and any use does not compile
  *
  * @param __VA_ARGS__ [in] get = getter, put = setter
  */
-#    define prop(...) __declspec(property(__VA_ARGS__))
+#    ifdef _MSC_VER
+#        define prop(...) __declspec(property(__VA_ARGS__))
+#    else
+#        define prop(...) typedef
+#    endif
 #endif
 
 // clang-format off
@@ -47,6 +56,33 @@
 #endif
 // clang-format on
 
+#ifndef CPU_PAUSE
+/**
+ * @brief spin-wait hint
+ */
+#    if _WIN32 || _WIN64
+#        define CPU_PAUSE() YieldProcessor()
+#    elif __x86_64__ || __i386__
+#        define CPU_PAUSE() __builtin_ia32_pause()
+#    elif __aarch64__ || __arm__
+#        define CPU_PAUSE() __asm__ __volatile__("yield")
+#    else
+#        define CPU_PAUSE() pass
+#    endif
+#endif
+
+#ifndef CACHE_LINE_SIZE
+/**
+ * @brief destructive interference size, for alignas
+ * @note  fixed value: std::hardware_destructive_interference_size may differ by compiler flags (ABI)
+ */
+#    if __APPLE__ && __aarch64__
+#        define CACHE_LINE_SIZE 128
+#    else
+#        define CACHE_LINE_SIZE 64
+#    endif
+#endif
+
 #ifndef interface
 #    define interface struct
 #endif
@@ -259,8 +295,8 @@
  * @brief removes expanded filled 1-bit for safe shift
  */
 #define TO_INT64(x)                                                                                                    \
-    (static_cast<unsigned __int64>(x) << ((sizeof(__int64) - sizeof((x))) << 3) >>                                     \
-     ((sizeof(unsigned __int64) - sizeof((x))) << 3))
+    (static_cast<uint64_t>(x) << ((sizeof(int64_t) - sizeof((x))) << 3) >>                                             \
+     ((sizeof(uint64_t) - sizeof((x))) << 3))
 
 /**
  * @brief shift rotate left
@@ -316,12 +352,14 @@
  * @param init      [in] initialize
  * @param procedure [in] procedure
  */
-#pragma warning(push)
-#pragma warning(disable:26819)
+#ifdef _MSC_VER
+#    pragma warning(push)
+#    pragma warning(disable:26819)
+#endif
 #define FAST_LOOP(count, init, procedure)                                                                              \
     do {                                                                                                               \
         init;                                                                                                          \
-        __int64 loop_count_in_fast_loop_macro = (static_cast<__int64>(count) + 7) >> 3;                                \
+        int64_t loop_count_in_fast_loop_macro = (static_cast<int64_t>(count) + 7) >> 3;                                \
         if(count > 0) switch(count & 0b111) {                                                                          \
                 case 0: do {                                                                                           \
                         procedure;                                                                                     \
@@ -335,7 +373,9 @@
                 } while(--loop_count_in_fast_loop_macro > 0);                                                          \
             }                                                                                                          \
     } while(false)                                                                                                    
-#pragma warning(pop)
+#ifdef _MSC_VER
+#    pragma warning(pop)
+#endif
 // clang-format on
 
 /**
@@ -0,0 +1,95 @@
+/**
+ * @file    LogFormat.cpp
+ * @author  LaverWinEmpty@google.com
+ * @brief   benchmark, compile-time format (Log<"...">()) vs variadic Log()
+ * @version 0.0.1
+ * @date    2026-10-18
+ *
+ * @copyright Copyright (c) 2023
+ *
+ * usage: LogFormat [records] [directory]
+ *        format: formatting only, LogFormatter<F>::Write vs LogWriter::Out::StreamW
+ *        async:  Log() into the staging buffer, writer thread running
+ *        sync:   Log() to the file
+ *
+ * build: g++ -std=c++20 -O2 LogFormat.cpp ../log/LogWriter.cpp ../log/LogBase.cpp ../log/LogBinary.cpp
+ *            ../../utilities/utilities/Timer.cpp ../../utilities/utilities/Clock.cpp
+ *            ../../utilities/utilities/Profiler.cpp -pthread -o LogFormat
+ */
+
+#include "iostream"
+#include "sstream"
+#include "chrono"
+#include "cstdlib"
+#include "filesystem"
+#include "../log/LogWriter.hpp"
+
+/**
+ * @brief elapsed nanoseconds per call
+ *
+ * @param count [in]
+ * @param func  [in]
+ * @return double
+ */
+template<typename F> static double Measure(IN size_t count, IN F&& func)
+{
+    auto begin = std::chrono::steady_clock::now();
+    for(size_t i = 0; i < count; ++i) {
+        func(i);
+    }
+    auto end = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::nano>(end - begin).count() / count;
+}
+
+/**
+ * @brief print a row
+ */
+static void Report(IN const char* name, IN double variadic, IN double format)
+{
+    std::cout << name << "\tvariadic " << variadic << " ns\tformat " << format << " ns\tx" << variadic / format
+              << std::endl;
+}
+
+int main(int argc, char* argv[])
+{
+    size_t       count     = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 1000000;
+    std::wstring directory = argc > 2 ? std::filesystem::path(argv[2]).wstring() : L"./LogFormat/";
+
+    // same output: "conn 12345 closed after 678 ms"
+    {
+        std::wostringstream stream;
+        std::wstring        line;
+        size_t              size = 0;
+
+        double variadic = Measure(count, [&](size_t i) {
+            stream.str(L"");
+            LogWriter::Out::StreamW(stream, L"", L"conn ", i, L" closed after ", i & 1023, L" ms");
+            size += stream.tellp();
+        });
+        double format = Measure(count, [&](size_t i) {
+            line.clear();
+            LogFormatter<"conn {} closed after {} ms">::Write(line, i, i & 1023);
+            size += line.size();
+        });
+        Report("format", variadic, format);
+        if(size == 0) {
+            std::cout << std::endl; // keep results alive
+        }
+    }
+
+    LogWriter writer(directory);
+
+    writer.Start();
+    double asyncVariadic = Measure(count, [&](size_t i) { writer.Log(L"conn ", i, L" closed after ", i & 1023, L" ms"); });
+    double asyncFormat   = Measure(count, [&](size_t i) { writer.Log<"conn {} closed after {} ms">(i, i & 1023); });
+    writer.Stop();
+    Report("async", asyncVariadic, asyncFormat);
+
+    // sync mode flushes every record: fewer records
+    size_t few          = count / 10 + 1;
+    double syncVariadic = Measure(few, [&](size_t i) { writer.Log(L"conn ", i, L" closed after ", i & 1023, L" ms"); });
+    double syncFormat   = Measure(few, [&](size_t i) { writer.Log<"conn {} closed after {} ms">(i, i & 1023); });
+    Report("sync", syncVariadic, syncFormat);
+
+    return 0;
+}
@@ -1,7 +1,7 @@
 #include "LogBase.hpp"
 
 LogBase::LogBase(const std::wstring& directory):
-    directory(directory), day(-1), timer(Timer::YYYY_MM_DD, Timer::HIDE_WEEKDAY), isExist(false)
+    directory(directory), timer(Timer::YYYY_MM_DD, Timer::HIDE_WEEKDAY), day(-1), isExist(false)
 {
     FixDirectory();
 }
@@ -17,7 +17,15 @@ bool LogBase::Update()
 {
     int temp = Timer::ReadSystemTime().tm_mday;
 
-    TypeLock<LogBase>::Spin spin;
+    // same day: readers only, every write passes here
+    {
+        TypeLock<LogBase>::ScalableShared lock(LockGuard::READ);
+        if(day == temp) {
+            return false;
+        }
+    }
+
+    TypeLock<LogBase>::ScalableShared lock(LockGuard::WRITE);
 
     if(day - temp) {
         day      = temp;   // update date
@@ -34,8 +42,7 @@ bool LogBase::Update()
 
 int LogBase::New()
 {
-    TypeLock<LogBase>::Spin lock;
-
+    // called by Update() with the lock
     if(isExist == false) {
         std::error_code code;
 
@@ -47,12 +54,13 @@ int LogBase::New()
         }
         isExist = true;
     }
+    return 0;
 }
 
-std::wstring LogBase::Path()
+std::wstring LogBase::Path(const wchar_t* extension)
 {
     std::string timestamp = timer.StampingFromSystemDate();
-    return directory + std::wstring(timestamp.begin(), timestamp.end()) + L".log";
+    return directory + std::wstring(timestamp.begin(), timestamp.end()) + extension;
 }
 
 void LogBase::FixDirectory()
@@ -61,9 +61,10 @@ protected:
     /**
      * @brief get the file path from time stamp
      *
+     * @param extension [in]
      * @return std::wstring (e.g. "path/to/1900-01-01.log")
      */
-    std::wstring Path();
+    std::wstring Path(IN const wchar_t* extension = L".log");
 
 private:
     /**
@@ -0,0 +1,81 @@
+#include "LogBinary.hpp"
+
+const char    LogBinary::MAGIC[4] = { 'L', 'W', 'E', 'B' };
+const uint8_t LogBinary::VERSION  = 1;
+
+uint32_t LogBinary::Register(const wchar_t* format, std::initializer_list<uint8_t> types)
+{
+    LockGuard::Scoped<LockGuard::WrappedSpin> guard(Lock());
+
+    std::vector<Site>& sites = Sites();
+    sites.push_back({ format, types });
+    return static_cast<uint32_t>(sites.size());
+}
+
+uint32_t LogBinary::GetSiteCount()
+{
+    LockGuard::Scoped<LockGuard::WrappedSpin> guard(Lock());
+    return static_cast<uint32_t>(Sites().size());
+}
+
+void LogBinary::EncodeHeader(std::string& out)
+{
+    out.push_back(static_cast<char>(HEADER));
+    out.append(MAGIC, sizeof(MAGIC));
+    Append(out, VERSION);
+    Append(out, static_cast<uint8_t>(sizeof(wchar_t)));
+}
+
+void LogBinary::EncodeSite(std::string& out, uint32_t id)
+{
+    LockGuard::Scoped<LockGuard::WrappedSpin> guard(Lock());
+
+    const Site& site = Sites()[id - 1];
+    out.push_back(static_cast<char>(SITE));
+    Append(out, id);
+    String(out, site.format);
+    Append(out, static_cast<uint32_t>(site.types.size()));
+    out.append(reinterpret_cast<const char*>(site.types.data()), site.types.size());
+}
+
+void LogBinary::String(std::string& out, const char* param)
+{
+    uint32_t length = static_cast<uint32_t>(std::strlen(param));
+    Append(out, length);
+    out.append(param, length);
+}
+
+void LogBinary::String(std::string& out, const wchar_t* param)
+{
+    uint32_t length = static_cast<uint32_t>(std::wcslen(param));
+    Append(out, length);
+    out.append(reinterpret_cast<const char*>(param), length * sizeof(wchar_t));
+}
+
+void LogBinary::String(std::string& out, const std::string& param)
+{
+    uint32_t length = static_cast<uint32_t>(param.size());
+    Append(out, length);
+    out.append(param.data(), length);
+}
+
+void LogBinary::String(std::string& out, const std::wstring& param)
+{
+    uint32_t length = static_cast<uint32_t>(param.size());
+    Append(out, length);
+    out.append(reinterpret_cast<const char*>(param.data()), length * sizeof(wchar_t));
+}
+
+LockGuard::WrappedSpin& LogBinary::Lock()
+{
+    // constructed on first use: TypeLock<LogBinary> may not be constructed yet during static initialization
+    static LockGuard::WrappedSpin lock;
+    return lock;
+}
+
+std::vector<LogBinary::Site>& LogBinary::Sites()
+{
+    // constructed on first use: sites register during static initialization
+    static std::vector<Site> sites;
+    return sites;
+}
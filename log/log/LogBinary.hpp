@@ -0,0 +1,221 @@
+/**
+ * @file    LogBinary.hpp
+ * @author  LaverWinEmpty@google.com
+ * @brief   binary (deferred format) log encoding
+ * @version 0.0.1
+ * @date    2026-10-17
+ *
+ * @copyright Copyright (c) 2023
+ *
+ */
+
+#ifndef LWE__LOGBINARY_HPP__
+#define LWE__LOGBINARY_HPP__
+
+#include "string"
+#include "vector"
+#include "chrono"
+#include "type_traits"
+#include "initializer_list"
+#include "../../utilities/utilities/LockGuard.hpp"
+
+/**
+ * @brief write binary log record (e.g. LOG_BINARY(writer, L"conn {} closed after {} ms", id, ms))
+ * @note  format is registered once per call site, runtime writes site id, timestamp and raw arguments only
+ *
+ * @param writer      [in] LogWriter
+ * @param format      [in] wide string literal, "{}" is a placeholder
+ * @param __VA_ARGS__ [in] arguments
+ */
+#define LOG_BINARY(writer, format, ...)                                                                                \
+    do {                                                                                                               \
+        struct LogSiteFormat                                                                                           \
+        {                                                                                                              \
+            static constexpr const wchar_t* Get() { return format; }                                                   \
+        };                                                                                                             \
+        (writer).Binary<LogSiteFormat>(__VA_ARGS__);                                                                   \
+    } while(false)
+
+/**
+ * @brief STATIC: binary log format
+ * @note  file: { 'H' header } { 'S' site }* { 'R' record }*, header again when reopened
+ *        'H': magic "LWEB", uint8_t version, uint8_t sizeof(wchar_t)
+ *        'S': uint32_t id, uint32_t length, wchar_t[length] format, uint32_t count, uint8_t[count] types
+ *        'R': uint32_t id, int64_t timestamp (ns since epoch), arguments
+ *        arguments: raw bytes, string: uint32_t length + characters
+ */
+class LogBinary
+{
+public:
+    DECLARE_LIMIT_LIFECYCLE(LogBinary);
+
+public:
+    /**
+     * @brief argument type code
+     */
+    enum EArgType : uint8_t
+    {
+        NONE,
+        I8,
+        I16,
+        I32,
+        I64,
+        U8,
+        U16,
+        U32,
+        U64,
+        F32,
+        F64,
+        BOOL,
+        CHAR,
+        WCHAR,
+        STR,
+        WSTR,
+    };
+
+    /**
+     * @brief record kind
+     */
+    enum EKind : uint8_t
+    {
+        HEADER = 'H',
+        SITE   = 'S',
+        RECORD = 'R',
+    };
+
+    /**
+     * @brief registered call site
+     */
+    struct Site
+    {
+        std::wstring         format;
+        std::vector<uint8_t> types;
+    };
+
+public:
+    /**
+     * @brief READONLY: file magic
+     */
+    static const char MAGIC[4];
+
+    /**
+     * @brief READONLY: format version
+     */
+    static const uint8_t VERSION;
+
+public:
+    /**
+     * @brief argument type to code
+     *
+     * @tparam T decayed argument type
+     */
+    template<typename T> static constexpr EArgType TypeOf();
+
+    /**
+     * @brief count "{}" in format
+     *
+     * @param format [in]
+     * @return size_t
+     */
+    static constexpr size_t CountPlaceholder(IN const wchar_t* format);
+
+public:
+    /**
+     * @brief register call site / thread safe
+     *
+     * @param format [in] "{}" is a placeholder
+     * @param types  [in] argument type codes
+     * @return uint32_t site id (1 ~)
+     */
+    static uint32_t Register(IN const wchar_t* format, IN std::initializer_list<uint8_t> types);
+
+    /**
+     * @brief get registered site count / thread safe
+     *
+     * @return uint32_t
+     */
+    static uint32_t GetSiteCount();
+
+public:
+    /**
+     * @brief append header
+     *
+     * @param std::string [out] bytes
+     */
+    static void EncodeHeader(OUT std::string&);
+
+    /**
+     * @brief append site definition / thread safe
+     *
+     * @param std::string [out] bytes
+     * @param uint32_t    [in] site id
+     */
+    static void EncodeSite(OUT std::string&, IN uint32_t);
+
+    /**
+     * @brief append record
+     *
+     * @tparam Types arguments
+     * @param std::string [out] bytes
+     * @param uint32_t    [in] site id
+     * @param Types       [in] arguments
+     */
+    template<typename... Types> static void EncodeRecord(OUT std::string&, IN uint32_t, IN const Types&...);
+
+private:
+    /**
+     * @brief append raw bytes
+     *
+     * @tparam T trivially copyable
+     * @param std::string [out] bytes
+     * @param T           [in]
+     */
+    template<typename T> static void Append(OUT std::string&, IN const T&);
+
+    /**
+     * @brief append argument
+     *
+     * @tparam T argument type, refer to TypeOf()
+     * @param std::string [out] bytes
+     * @param T           [in]
+     */
+    template<typename T> static void Argument(OUT std::string&, IN const T&);
+
+    /**
+     * @brief append length + characters
+     */
+    static void String(OUT std::string&, IN const char*);
+    static void String(OUT std::string&, IN const wchar_t*);
+    static void String(OUT std::string&, IN const std::string&);
+    static void String(OUT std::string&, IN const std::wstring&);
+
+private:
+    /**
+     * @brief lock of Sites()
+     */
+    static LockGuard::WrappedSpin& Lock();
+
+    /**
+     * @brief registered sites, index: id - 1
+     */
+    static std::vector<Site>& Sites();
+};
+
+/**
+ * @brief call site, registered before main()
+ *
+ * @tparam Tag   format holder (Tag::Get())
+ * @tparam Types decayed argument types
+ */
+template<typename Tag, typename... Types> struct LogSite
+{
+    static_assert(LogBinary::CountPlaceholder(Tag::Get()) == sizeof...(Types), "placeholder count mismatch");
+
+    /**
+     * @brief site id
+     */
+    static const uint32_t id;
+};
+
+#include "LogBinary.ipp"
+#endif
@@ -0,0 +1,81 @@
+template<typename Tag, typename... Types>
+const uint32_t LogSite<Tag, Types...>::id = LogBinary::Register(Tag::Get(), { LogBinary::TypeOf<Types>()... });
+
+template<typename T> constexpr LogBinary::EArgType LogBinary::TypeOf()
+{
+    if constexpr(std::is_same_v<T, bool>) {
+        return BOOL;
+    }
+    else if constexpr(std::is_same_v<T, char>) {
+        return CHAR;
+    }
+    else if constexpr(std::is_same_v<T, wchar_t>) {
+        return WCHAR;
+    }
+    else if constexpr(std::is_same_v<T, char*> || std::is_same_v<T, const char*> || std::is_same_v<T, std::string>) {
+        return STR;
+    }
+    else if constexpr(std::is_same_v<T, wchar_t*> || std::is_same_v<T, const wchar_t*> ||
+                      std::is_same_v<T, std::wstring>) {
+        return WSTR;
+    }
+    else if constexpr(std::is_floating_point_v<T>) {
+        static_assert(sizeof(T) == 4 || sizeof(T) == 8, "unsupported floating point type");
+        return sizeof(T) == 4 ? F32 : F64;
+    }
+    else if constexpr(std::is_integral_v<T> || std::is_enum_v<T>) {
+        constexpr bool isSigned = std::is_signed_v<T> || std::is_enum_v<T>;
+        switch(sizeof(T)) {
+            case 1: return isSigned ? I8 : U8;
+            case 2: return isSigned ? I16 : U16;
+            case 4: return isSigned ? I32 : U32;
+            default: return isSigned ? I64 : U64;
+        }
+    }
+    else {
+        static_assert(sizeof(T) == 0, "unsupported binary log argument type");
+        return NONE;
+    }
+}
+
+constexpr size_t LogBinary::CountPlaceholder(const wchar_t* format)
+{
+    size_t count = 0;
+    for(; *format; ++format) {
+        if(format[0] == L'{' && format[1] == L'}') {
+            ++count;
+            ++format;
+        }
+    }
+    return count;
+}
+
+template<typename... Types> void LogBinary::EncodeRecord(std::string& out, uint32_t id, const Types&... args)
+{
+    int64_t now = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                      std::chrono::system_clock::now().time_since_epoch())
+                      .count();
+
+    out.push_back(static_cast<char>(RECORD));
+    Append(out, id);
+    Append(out, now);
+    (Argument(out, args), ...);
+}
+
+template<typename T> void LogBinary::Append(std::string& out, const T& param)
+{
+    static_assert(std::is_trivially_copyable_v<T>, "raw bytes only");
+    out.append(reinterpret_cast<const char*>(&param), sizeof(T));
+}
+
+template<typename T> void LogBinary::Argument(std::string& out, const T& param)
+{
+    using Type = std::decay_t<T>;
+
+    if constexpr(TypeOf<Type>() == STR || TypeOf<Type>() == WSTR) {
+        String(out, param);
+    }
+    else {
+        Append(out, static_cast<Type>(param));
+    }
+}
@@ -0,0 +1,219 @@
+#include "LogDecoder.hpp"
+
+LogDecoder::LogDecoder(const std::wstring& dir): LogBase(dir), wcharSize(sizeof(wchar_t)), size(0)
+{
+    // records keep the full resolution of the writer
+    timer.SetTimeStampShowTypes(Timer::HIDE_WEEKDAY | Timer::SHOW_NANOSECONDS);
+}
+
+void LogDecoder::SetTimeStampShowTypes(int flag)
+{
+    timer.SetTimeStampShowTypes(flag);
+}
+
+bool LogDecoder::Decode(std::wostream& to)
+{
+    return Decode(Path(L".bin.log"), to);
+}
+
+bool LogDecoder::Decode(const std::wstring& from, std::wostream& to)
+{
+    std::ifstream file(std::filesystem::path(from), std::ios_base::in | std::ios_base::binary);
+    if(!file.is_open()) {
+        return false;
+    }
+
+    // bound of lengths read from the file
+    file.seekg(0, std::ios_base::end);
+    size = static_cast<uint64_t>(file.tellg());
+    file.seekg(0, std::ios_base::beg);
+
+    sites.clear();
+
+    uint8_t kind;
+    while(Read(file, kind)) {
+        bool isSucceeded = false;
+
+        switch(kind) {
+            case LogBinary::HEADER:
+                isSucceeded = ReadHeader(file);
+                break;
+            case LogBinary::SITE:
+                isSucceeded = ReadSite(file);
+                break;
+            case LogBinary::RECORD:
+                isSucceeded = ReadRecord(file, to);
+                break;
+        }
+
+        if(!isSucceeded) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool LogDecoder::ReadHeader(std::istream& is)
+{
+    char    magic[sizeof(LogBinary::MAGIC)];
+    uint8_t version;
+
+    if(!Read(is, magic) || std::memcmp(magic, LogBinary::MAGIC, sizeof(magic))) {
+        return false;
+    }
+    if(!Read(is, version) || version != LogBinary::VERSION) {
+        return false;
+    }
+    if(!Read(is, wcharSize) || (wcharSize != 2 && wcharSize != 4)) {
+        return false;
+    }
+
+    // ids are reassigned by each writer process
+    sites.clear();
+    return true;
+}
+
+bool LogDecoder::ReadSite(std::istream& is)
+{
+    uint32_t        id;
+    uint32_t        count;
+    LogBinary::Site site;
+
+    if(!Read(is, id) || !ReadString(is, wcharSize, site.format) || !Read(is, count)) {
+        return false;
+    }
+
+    if(!IsAvailable(is, count)) {
+        return false;
+    }
+
+    site.types.resize(count);
+    is.read(reinterpret_cast<char*>(site.types.data()), count);
+    if(static_cast<uint32_t>(is.gcount()) != count) {
+        return false;
+    }
+
+    sites[id] = std::move(site);
+    return true;
+}
+
+bool LogDecoder::ReadRecord(std::istream& is, std::wostream& os)
+{
+    uint32_t id;
+    int64_t  ns;
+
+    if(!Read(is, id) || !Read(is, ns)) {
+        return false;
+    }
+
+    auto iter = sites.find(id);
+    if(iter == sites.end()) {
+        return false;
+    }
+
+    const std::wstring& format    = iter->second.format;
+    std::string         temp      = timer.StampingFromTime(static_cast<time_t>(ns / 1000000000),
+                                                           static_cast<uint32_t>(ns % 1000000000));
+    std::wstring        timestamp = std::wstring(temp.begin(), temp.end());
+    size_t              index     = 0;
+
+    os << L'[' << timestamp << L"] => ";
+    for(size_t i = 0; i < format.size(); ++i) {
+        if(format[i] == L'{' && i + 1 < format.size() && format[i + 1] == L'}') {
+            if(index >= iter->second.types.size() || !ReadArgument(is, iter->second.types[index], os)) {
+                return false;
+            }
+            ++index;
+            ++i;
+            continue;
+        }
+        os << format[i];
+    }
+    os << L'\n';
+
+    return true;
+}
+
+bool LogDecoder::ReadArgument(std::istream& is, uint8_t type, std::wostream& os)
+{
+    // clang-format off
+    switch(type) {
+#define LOG_DECODE_CASE(code, type, cast)                                                                              \
+        case LogBinary::code: {                                                                                        \
+            type value;                                                                                                \
+            if(!Read(is, value)) return false;                                                                         \
+            os << static_cast<cast>(value);                                                                            \
+            return true;                                                                                               \
+        }
+        LOG_DECODE_CASE(I8,  int8_t,   int)
+        LOG_DECODE_CASE(I16, int16_t,  int16_t)
+        LOG_DECODE_CASE(I32, int32_t,  int32_t)
+        LOG_DECODE_CASE(I64, int64_t,  int64_t)
+        LOG_DECODE_CASE(U8,  uint8_t,  unsigned)
+        LOG_DECODE_CASE(U16, uint16_t, uint16_t)
+        LOG_DECODE_CASE(U32, uint32_t, uint32_t)
+        LOG_DECODE_CASE(U64, uint64_t, uint64_t)
+        LOG_DECODE_CASE(F32, float,    float)
+        LOG_DECODE_CASE(F64, double,   double)
+        LOG_DECODE_CASE(BOOL, bool,    bool)
+        LOG_DECODE_CASE(CHAR, uint8_t, wchar_t) // as unsigned: no sign extension of 0x80 ~ 0xFF
+#undef LOG_DECODE_CASE
+
+        case LogBinary::WCHAR: {
+            char     bytes[4] = { 0 };
+            uint32_t unit     = 0;
+            is.read(bytes, wcharSize);
+            if(is.gcount() != wcharSize) return false;
+            std::memcpy(&unit, bytes, wcharSize); // little endian
+            os << static_cast<wchar_t>(unit);
+            return true;
+        }
+
+        case LogBinary::STR:
+        case LogBinary::WSTR: {
+            std::wstring value;
+            if(!ReadString(is, type == LogBinary::STR ? 1 : wcharSize, value)) {
+                return false;
+            }
+            os << value;
+            return true;
+        }
+    }
+    // clang-format on
+    return false;
+}
+
+bool LogDecoder::ReadString(std::istream& is, size_t charSize, std::wstring& out)
+{
+    uint32_t length;
+    if(!Read(is, length)) {
+        return false;
+    }
+
+    if(!IsAvailable(is, static_cast<uint64_t>(length) * charSize)) {
+        return false;
+    }
+
+    std::string bytes(length * charSize, '\0');
+    is.read(bytes.data(), bytes.size());
+    if(static_cast<size_t>(is.gcount()) != bytes.size()) {
+        return false;
+    }
+
+    out.resize(length);
+    for(uint32_t i = 0; i < length; ++i) {
+        uint32_t unit = 0;
+        std::memcpy(&unit, bytes.data() + i * charSize, charSize); // little endian
+        out[i] = static_cast<wchar_t>(unit);
+    }
+    return true;
+}
+
+bool LogDecoder::IsAvailable(std::istream& is, uint64_t bytes) const
+{
+    std::streamoff position = is.tellg();
+    if(position < 0) {
+        return false;
+    }
+    return bytes <= size - MIN(static_cast<uint64_t>(position), size);
+}
@@ -0,0 +1,104 @@
+/**
+ * @file    LogDecoder.hpp
+ * @author  LaverWinEmpty@google.com
+ * @brief   binary log decoder
+ * @version 0.0.1
+ * @date    2026-10-17
+ *
+ * @copyright Copyright (c) 2023
+ *
+ */
+
+#ifndef LWE__LOGDECODER_HPP__
+#define LWE__LOGDECODER_HPP__
+
+#include "unordered_map"
+#include "LogBase.hpp"
+#include "LogBinary.hpp"
+
+/**
+ * @brief convert binary log file (LogWriter::Binary) to text (e.g. ["time"] => "content")
+ *        used offline, or for files copied from servers
+ */
+class LogDecoder: public LogBase
+{
+public:
+    /**
+     * @brief Construct a new LogDecoder object, timestamps with nanoseconds
+     *
+     * @param directory [in] log files storage path
+     */
+    LogDecoder(IN const std::wstring& directory = L"Log/");
+
+public:
+    /**
+     * @brief set timestamp options of decoded records (e.g. Timer::HIDE_WEEKDAY | Timer::SHOW_MICROSECONDS)
+     *
+     * @param flag [in] Timer::ETimeStampDisplayFlag bits
+     */
+    void SetTimeStampShowTypes(IN int flag);
+
+public:
+    /**
+     * @brief decode binary log file
+     *
+     * @param from [in] binary log file path
+     * @param to   [out] text output
+     * @return true: succeeded / false: not exist or broken file (decoded until the broken record)
+     */
+    bool Decode(IN const std::wstring& from, OUT std::wostream& to);
+
+    /**
+     * @brief decode today's binary log file in the directory
+     *
+     * @param to [out] text output
+     * @return true: succeeded / false: not exist or broken file
+     */
+    bool Decode(OUT std::wostream& to);
+
+private:
+    bool ReadHeader(IN std::istream&);
+    bool ReadSite(IN std::istream&);
+    bool ReadRecord(IN std::istream&, OUT std::wostream&);
+    bool ReadArgument(IN std::istream&, IN uint8_t type, OUT std::wostream&);
+    bool ReadString(IN std::istream&, IN size_t charSize, OUT std::wstring&);
+
+    /**
+     * @brief check the rest of the file holds the bytes, before allocating for a length read from it
+     *
+     * @param std::istream [in]
+     * @param bytes        [in]
+     * @return true: available / false: corrupt or truncated length
+     */
+    bool IsAvailable(IN std::istream&, IN uint64_t bytes) const;
+
+private:
+    /**
+     * @brief read raw bytes
+     *
+     * @tparam T
+     * @param std::istream [in]
+     * @param T            [out]
+     * @return true: succeeded / false: end of file
+     */
+    template<typename T> static bool Read(IN std::istream&, OUT T&);
+
+private:
+    /**
+     * @brief sites of the current header, key: id
+     */
+    std::unordered_map<uint32_t, LogBinary::Site> sites;
+
+    /**
+     * @brief sizeof(wchar_t) of the writer
+     */
+    uint8_t wcharSize;
+
+    /**
+     * @brief bytes of the file being decoded
+     */
+    uint64_t size;
+};
+
+#include "LogDecoder.ipp"
+#endif
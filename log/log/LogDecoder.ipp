@@ -0,0 +1,5 @@
+template<typename T> bool LogDecoder::Read(std::istream& is, T& out)
+{
+    is.read(reinterpret_cast<char*>(&out), sizeof(T));
+    return static_cast<size_t>(is.gcount()) == sizeof(T);
+}
@@ -0,0 +1,159 @@
+/**
+ * @file    LogFormat.hpp
+ * @author  LaverWinEmpty@google.com
+ * @brief   compile time log format string
+ * @version 0.0.1
+ * @date    2026-10-17
+ *
+ * @copyright Copyright (c) 2023
+ *
+ */
+
+#ifndef LWE__LOGFORMAT_HPP__
+#define LWE__LOGFORMAT_HPP__
+
+#include "string"
+#include "string_view"
+#include "sstream"
+#include "charconv"
+#include "utility"
+#include "type_traits"
+#include "../../include/include/includes.hpp"
+
+/**
+ * @brief format string as template parameter (e.g. Log<"conn {} closed after {} ms">(id, ms))
+ * @note  "{}": placeholder, "{{" / "}}": brace
+ *
+ * @tparam N length with null
+ */
+template<size_t N> struct LogFormat
+{
+    /**
+     * @brief Construct a new LogFormat object, implicitly from string literal
+     *
+     * @param param [in] string literal
+     */
+    constexpr LogFormat(IN const char (&param)[N]);
+
+    /**
+     * @brief get placeholder count
+     *
+     * @return size_t (SIZE_MAX: invalid format)
+     */
+    constexpr size_t Count() const;
+
+    /**
+     * @brief format string
+     */
+    char text[N];
+};
+
+/**
+ * @brief STATIC: text appender used by LogFormatter, no stream for built-in types
+ */
+class LogText
+{
+public:
+    DECLARE_LIMIT_LIFECYCLE(LogText);
+
+public:
+    /**
+     * @brief append argument as text
+     * @note  arithmetic, char / wchar_t and strings are converted directly, others use operator<<
+     *
+     * @tparam T
+     * @param std::wstring [out]
+     * @param T            [in]
+     */
+    template<typename T> static void Append(OUT std::wstring&, IN const T&);
+
+private:
+    /**
+     * @brief append arithmetic value (float: same as stream default, 6 digits)
+     *
+     * @tparam T
+     * @param std::wstring [out]
+     * @param T            [in]
+     */
+    template<typename T> static void Number(OUT std::wstring&, IN T);
+
+    /**
+     * @brief append ascii string
+     *
+     * @param std::wstring     [out]
+     * @param std::string_view [in]
+     */
+    static void Widen(OUT std::wstring&, IN std::string_view);
+};
+
+/**
+ * @brief STATIC: formatter generated from the format string
+ * @note  format is parsed and validated at compile time,
+ *        runtime appends literal piece and argument alternately (no loop, no parse)
+ *
+ * @tparam F format string
+ */
+template<LogFormat F> class LogFormatter
+{
+public:
+    DECLARE_LIMIT_LIFECYCLE(LogFormatter);
+
+public:
+    /**
+     * @brief READONLY: placeholder count
+     */
+    static constexpr size_t COUNT = F.Count();
+
+    static_assert(COUNT != SIZE_MAX, "invalid log format: use {} as placeholder, {{ and }} as brace");
+
+public:
+    /**
+     * @brief append formatted text
+     *
+     * @tparam Types
+     * @param std::wstring [out]
+     * @param Types        [in] arguments, count must be COUNT
+     */
+    template<typename... Types> static void Write(OUT std::wstring&, IN Types&&...);
+
+private:
+    /**
+     * @brief literal pieces between placeholders, widened and unescaped
+     */
+    struct Piece
+    {
+        wchar_t text[sizeof(F.text)];
+        size_t  offset[COUNT + 1];
+        size_t  length[COUNT + 1];
+    };
+
+    /**
+     * @brief parse format
+     *
+     * @return Piece
+     */
+    static constexpr Piece Parse();
+
+    /**
+     * @brief unroll arguments
+     */
+    template<size_t... I, typename... Types>
+    static void Write(IN std::index_sequence<I...>, OUT std::wstring&, IN Types&&...);
+
+    /**
+     * @brief append I-th literal piece
+     *
+     * @tparam I
+     * @param std::wstring [out]
+     */
+    template<size_t I> static void Literal(OUT std::wstring&);
+
+private:
+    /**
+     * @brief READONLY: parsed format
+     */
+    static constexpr Piece PIECE = Parse();
+};
+
+#include "LogFormat.ipp"
+#endif
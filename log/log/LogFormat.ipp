@@ -0,0 +1,129 @@
+template<size_t N> constexpr LogFormat<N>::LogFormat(const char (&param)[N]): text{}
+{
+    for(size_t i = 0; i < N; ++i) {
+        text[i] = param[i];
+    }
+}
+
+template<size_t N> constexpr size_t LogFormat<N>::Count() const
+{
+    size_t count = 0;
+    for(size_t i = 0; i + 1 < N; ++i) {
+        if(text[i] == '{') {
+            if(text[i + 1] != '{' && text[i + 1] != '}') {
+                return SIZE_MAX;
+            }
+            count += text[i + 1] == '}';
+            ++i;
+        }
+        else if(text[i] == '}') {
+            if(text[i + 1] != '}') {
+                return SIZE_MAX;
+            }
+            ++i;
+        }
+    }
+    return count;
+}
+
+template<typename T> void LogText::Append(std::wstring& out, const T& arg)
+{
+    using Type = std::remove_cv_t<T>;
+
+    if constexpr(std::is_same_v<Type, bool>) {
+        out.push_back(arg ? L'1' : L'0');
+    }
+    else if constexpr(std::is_same_v<Type, wchar_t>) {
+        out.push_back(arg);
+    }
+    else if constexpr(std::is_same_v<Type, char>) {
+        out.push_back(static_cast<wchar_t>(static_cast<unsigned char>(arg)));
+    }
+    else if constexpr(std::is_arithmetic_v<Type>) {
+        Number(out, arg);
+    }
+    else if constexpr(std::is_convertible_v<const T&, std::wstring_view>) {
+        out.append(std::wstring_view(arg));
+    }
+    else if constexpr(std::is_convertible_v<const T&, std::string_view>) {
+        Widen(out, std::string_view(arg));
+    }
+    else {
+        thread_local std::wostringstream stream;
+        stream.str(L"");
+        stream << const_cast<T&>(arg); // ILoggable takes non-const reference
+        out.append(stream.str());
+    }
+}
+
+template<typename T> void LogText::Number(std::wstring& out, T arg)
+{
+    char             buffer[32];
+    std::to_chars_result result;
+
+    if constexpr(std::is_floating_point_v<T>) {
+        result = std::to_chars(buffer, buffer + sizeof(buffer), arg, std::chars_format::general, 6);
+    }
+    else {
+        result = std::to_chars(buffer, buffer + sizeof(buffer), arg);
+    }
+    Widen(out, std::string_view(buffer, result.ptr - buffer));
+}
+
+inline void LogText::Widen(std::wstring& out, std::string_view param)
+{
+    size_t size = out.size();
+    out.resize(size + param.size());
+    for(size_t i = 0; i < param.size(); ++i) {
+        out[size + i] = static_cast<wchar_t>(static_cast<unsigned char>(param[i]));
+    }
+}
+
+template<LogFormat F> constexpr typename LogFormatter<F>::Piece LogFormatter<F>::Parse()
+{
+    Piece  piece{};
+    size_t index = 0;
+    size_t size  = 0;
+
+    for(size_t i = 0; i + 1 < sizeof(F.text); ++i) {
+        char ch = F.text[i];
+
+        // placeholder: close current piece
+        if(ch == '{' && F.text[i + 1] == '}') {
+            piece.length[index] = size - piece.offset[index];
+            piece.offset[++index] = size;
+            ++i;
+            continue;
+        }
+
+        // escaped brace
+        if(ch == '{' || ch == '}') {
+            ++i;
+        }
+        piece.text[size++] = static_cast<wchar_t>(static_cast<unsigned char>(ch));
+    }
+    piece.length[index] = size - piece.offset[index];
+
+    return piece;
+}
+
+template<LogFormat F> template<typename... Types> void LogFormatter<F>::Write(std::wstring& out, Types&&... args)
+{
+    static_assert(sizeof...(Types) == COUNT, "log format placeholder count mismatch");
+    Write(std::index_sequence_for<Types...>{}, out, std::forward<Types>(args)...);
+}
+
+template<LogFormat F>
+template<size_t... I, typename... Types>
+void LogFormatter<F>::Write(std::index_sequence<I...>, std::wstring& out, Types&&... args)
+{
+    ((Literal<I>(out), LogText::Append(out, args)), ...);
+    Literal<COUNT>(out);
+}
+
+template<LogFormat F> template<size_t I> void LogFormatter<F>::Literal(std::wstring& out)
+{
+    if constexpr(PIECE.length[I] != 0) {
+        out.append(PIECE.text + PIECE.offset[I], PIECE.length[I]);
+    }
+}
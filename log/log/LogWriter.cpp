@@ -1,4 +1,5 @@
 #include "LogWriter.hpp"
+#include "algorithm"
 
 ILoggable::ILoggable(const char* to): a(to), w(a.begin(), a.end()) {}
 
@@ -22,19 +23,32 @@ void ILoggable::OnWrite(std::wofstream& wfos)
     wfos << w;
 }
 
-LogWriter::LogWriter(const char* locale): LogBase()
+const size_t                    LogWriter::DEF_QUEUE_CAPACITY  = 1 << 12;
+const size_t                    LogWriter::DEF_BATCH_SIZE      = 1 << 6;
+const size_t                    LogWriter::DEF_STAGING_KB      = 16;
+const std::chrono::milliseconds LogWriter::DEF_STAGING_TIMEOUT = std::chrono::milliseconds(50);
+
+std::vector<uint64_t> LogWriter::actives;
+
+LogWriter::LogWriter(const char* locale):
+    LogBase(), stamp(timer), emitted(0), queue(nullptr), id(0), stagingSize(0), stagingTimeout(0), isRunning(false), signals(0),
+    isSleeping(false), dropped(0), policy(BLOCK)
 {
     SetLocale(locale);
 }
 
-LogWriter::LogWriter(const std::wstring& dir, const char* locale): LogBase(dir)
+LogWriter::LogWriter(const std::wstring& dir, const char* locale):
+    LogBase(dir), stamp(timer), emitted(0), queue(nullptr), id(0), stagingSize(0), stagingTimeout(0), isRunning(false),
+    signals(0), isSleeping(false), dropped(0), policy(BLOCK)
 {
     SetLocale(locale);
 }
 
 LogWriter::~LogWriter()
 {
+    Stop();
     fout.close();
+    bout.close();
 }
 
 void LogWriter::SetLocale(IN const char* param)
@@ -50,10 +64,323 @@ bool LogWriter::Update()
         if(fout.is_open()) {
             fout.close();
         }
-        fout.open(Path(), std::ios_base::out | std::ios_base::app);
+        fout.open(std::filesystem::path(Path()), std::ios_base::out | std::ios_base::app);
         if(!fout.is_open()) {
             throw std::strerror(fout.rdstate());
         }
+
+        // reopen on next binary record
+        if(bout.is_open()) {
+            bout.close();
+        }
     }
     return isUpdated;
+}
+
+void LogWriter::Start(size_t capacity, EOverflowPolicy param, size_t stagingKB, std::chrono::milliseconds timeout)
+{
+    static std::atomic<uint64_t> generator = 0;
+
+    if(queue) {
+        throw std::runtime_error("already started");
+    }
+
+    id             = generator.fetch_add(1, std::memory_order_relaxed) + 1;
+    policy         = param;
+    stagingSize    = stagingKB << 10;
+    stagingTimeout = timeout;
+    dropped.store(0, std::memory_order_relaxed);
+    queue = new RingQueue<Block>(capacity);
+    {
+        TypeLock<Staging>::Spin lock;
+        actives.push_back(id);
+    }
+
+    isRunning.store(true, std::memory_order_release);
+    writer = std::thread(&LogWriter::Run, this);
+}
+
+void LogWriter::Stop()
+{
+    if(queue == nullptr) {
+        return;
+    }
+
+    isRunning.store(false, std::memory_order_release);
+    Notify();
+    if(writer.joinable()) {
+        writer.join();
+    }
+
+    TypeLock<Staging>::Spin lock;
+    for(Staging* staging : stagings) {
+        SAFE_DELETE(staging);
+    }
+    stagings.clear();
+    SAFE_DELETE(queue);
+
+    // cached pointers to the freed buffers are dropped by the next Local() of each thread
+    actives.erase(std::find(actives.begin(), actives.end(), id));
+    id = 0;
+}
+
+uint64_t LogWriter::GetDropped() const
+{
+    return dropped.load(std::memory_order_relaxed);
+}
+
+void LogWriter::Flush()
+{
+    if(queue == nullptr) {
+        TypeLock<LogWriter>::Mutex lock;
+        fout.flush();
+        return;
+    }
+
+    Staging* staging = Local();
+    Acquire(staging);
+    if(staging->records) {
+        Handoff(staging, true);
+    }
+    Release(staging);
+}
+
+LogWriter::Staging::Staging(const Timer& timer): stamp(timer), records(0)
+{
+    busy.clear();
+}
+
+LogWriter::Staging* LogWriter::Local()
+{
+    // { Start() id, staging } pairs, usually one
+    thread_local std::vector<std::pair<uint64_t, Staging*>> cache;
+
+    for(auto& pair : cache) {
+        if(pair.first == id) {
+            return pair.second;
+        }
+    }
+
+    Staging* staging = new Staging(timer);
+    staging->stream.imbue(fout.getloc());
+    {
+        TypeLock<Staging>::Spin lock;
+        stagings.push_back(staging);
+
+        // stopped: freed, ids are never reused
+        std::erase_if(cache, [](const std::pair<uint64_t, Staging*>& pair) {
+            return std::find(actives.begin(), actives.end(), pair.first) == actives.end();
+        });
+    }
+    cache.push_back({ id, staging });
+    return staging;
+}
+
+void LogWriter::Acquire(Staging* staging)
+{
+    while(staging->busy.test_and_set(std::memory_order_acquire)) {
+        std::this_thread::yield();
+    }
+}
+
+void LogWriter::Release(Staging* staging)
+{
+    staging->busy.clear(std::memory_order_release);
+}
+
+bool LogWriter::IsExpired(Staging* staging) const
+{
+    size_t size = static_cast<size_t>(staging->stream.tellp()) * sizeof(wchar_t) + staging->binary.size();
+    if(size >= stagingSize) {
+        return true;
+    }
+    return std::chrono::steady_clock::now() - staging->first >= stagingTimeout;
+}
+
+bool LogWriter::Handoff(Staging* staging, bool isWait)
+{
+    PROFILE_ZONE("LogWriter::Handoff");
+
+    Block block;
+    block.text    = staging->stream.str();
+    block.binary  = std::move(staging->binary);
+    block.records = staging->records;
+
+    if(isWait) {
+        Enqueue(std::move(block));
+    }
+    else if(!queue->Push(std::move(block))) {
+        staging->binary = std::move(block.binary); // not moved by a failed push
+        return false;
+    }
+
+    staging->stream.str(L"");
+    staging->binary.clear();
+    staging->records = 0;
+
+    Notify();
+    return true;
+}
+
+void LogWriter::Enqueue(Block&& block)
+{
+    uint32_t records = block.records;
+
+    switch(policy) {
+        case BLOCK:
+            while(!queue->Push(std::move(block))) {
+                std::this_thread::yield();
+            }
+            break;
+
+        case DROP_NEWEST:
+            if(!queue->Push(std::move(block))) {
+                dropped.fetch_add(records, std::memory_order_relaxed);
+            }
+            break;
+
+        case DROP_OLDEST:
+            while(!queue->Push(std::move(block))) {
+                Block oldest;
+                if(queue->Pop(oldest)) {
+                    dropped.fetch_add(oldest.records, std::memory_order_relaxed);
+                }
+            }
+            break;
+    }
+}
+
+bool LogWriter::Collect(bool isForce, std::chrono::steady_clock::time_point* next)
+{
+    bool isEmpty = true;
+
+    TypeLock<Staging>::Spin lock;
+    for(Staging* staging : stagings) {
+        // in use by the owner thread: it checks by itself, look again soon
+        if(staging->busy.test_and_set(std::memory_order_acquire)) {
+            if(next) {
+                *next = MIN(*next, std::chrono::steady_clock::now() + std::chrono::milliseconds(1));
+            }
+            isEmpty = false;
+            continue;
+        }
+
+        if(staging->records) {
+            // never wait: the writer thread is the consumer
+            if(!(isForce || IsExpired(staging)) || !Handoff(staging, false)) {
+                if(next) {
+                    *next = MIN(*next, staging->first + stagingTimeout);
+                }
+                isEmpty = false;
+            }
+        }
+        Release(staging);
+    }
+    return isEmpty;
+}
+
+void LogWriter::Notify()
+{
+    signals.fetch_add(1, std::memory_order_seq_cst);
+    if(isSleeping.load(std::memory_order_seq_cst)) {
+        std::lock_guard<std::mutex> guard(signalLock);
+        signal.notify_one();
+    }
+}
+
+void LogWriter::WriteBinary(const std::string& records)
+{
+    std::string header;
+
+    if(!bout.is_open()) {
+        bout.open(std::filesystem::path(Path(L".bin.log")), std::ios_base::out | std::ios_base::app | std::ios_base::binary);
+        if(!bout.is_open()) {
+            throw std::runtime_error(std::strerror(errno));
+        }
+
+        // site ids are valid for this process only
+        LogBinary::EncodeHeader(header);
+        emitted = 0;
+    }
+
+    uint32_t count = LogBinary::GetSiteCount();
+    while(emitted < count) {
+        LogBinary::EncodeSite(header, ++emitted);
+    }
+
+    if(header.size()) {
+        bout.write(header.data(), header.size());
+    }
+    bout.write(records.data(), records.size());
+}
+
+void LogWriter::Run()
+{
+    PROFILE_THREAD("LogWriter");
+
+    while(isRunning.load(std::memory_order_acquire)) {
+        // read before checking: a later Notify() changes it and the wait returns at once
+        uint64_t seen = signals.load(std::memory_order_seq_cst);
+
+        std::chrono::steady_clock::time_point next  = std::chrono::steady_clock::time_point::max();
+        size_t                                count = Drain(DEF_BATCH_SIZE);
+        Collect(false, &next);
+        if(count) {
+            continue;
+        }
+
+        // sleep until a block is queued, a buffer gets its first record or the oldest staged record times out
+        auto isSignaled = [&] {
+            return signals.load(std::memory_order_seq_cst) != seen || !isRunning.load(std::memory_order_acquire);
+        };
+
+        std::unique_lock<std::mutex> guard(signalLock);
+        isSleeping.store(true, std::memory_order_seq_cst);
+        if(next == std::chrono::steady_clock::time_point::max()) {
+            signal.wait(guard, isSignaled);
+        }
+        else {
+            signal.wait_until(guard, next, isSignaled);
+        }
+        isSleeping.store(false, std::memory_order_relaxed);
+    }
+
+    // remaining
+    bool isEmpty = false;
+    while(!isEmpty) {
+        isEmpty = Collect(true);
+        while(Drain(DEF_BATCH_SIZE)) continue;
+    }
+}
+
+size_t LogWriter::Drain(size_t max)
+{
+    Block  block;
+    size_t count = 0;
+
+    while(count < max && queue->Pop(block)) {
+        // check date once per batch
+        if(count == 0) {
+            try {
+                Update();
+            }
+            catch(...) {
+                pass; // keep the current file, retry next batch
+            }
+        }
+        if(block.text.size()) {
+            fout << block.text;
+        }
+        if(block.binary.size()) {
+            WriteBinary(block.binary);
+        }
+        ++count;
+    }
+
+    if(count) {
+        PROFILE_ZONE("LogWriter::Drain::Flush");
+        fout.flush();
+        bout.flush();
+    }
+    return count;
 }
\ No newline at end of file
@@ -12,11 +12,23 @@
 #ifndef LWE__LOGWRITER_H__
 #define LWE__LOGWRITER_H__
 
-#include "windows.h"
+#if _WIN32 || _WIN64
+#    include "windows.h"
+#endif
 #include "iostream"
 #include "fstream"
+#include "sstream"
+#include "thread"
+#include "atomic"
+#include "vector"
+#include "mutex"
+#include "condition_variable"
 #include "LogBase.hpp"
+#include "LogBinary.hpp"
+#include "LogFormat.hpp"
 #include "../../utilities/utilities/LockGuard.hpp"
+#include "../../utilities/utilities/Profiler.hpp"
+#include "../../utilities/utilities/RingQueue.hpp"
 
 interface ILoggable abstract
 {
@@ -77,6 +89,38 @@ private:
 
 class LogWriter: public LogBase
 {
+public:
+    /**
+     * @brief async mode: behavior of Log() when the queue is full
+     */
+    enum EOverflowPolicy
+    {
+        BLOCK,       // wait for the writer thread
+        DROP_NEWEST, // discard the record being logged
+        DROP_OLDEST, // discard the oldest queued record
+    };
+
+public:
+    /**
+     * @brief READONLY: default async queue capacity (records)
+     */
+    static const size_t DEF_QUEUE_CAPACITY;
+
+    /**
+     * @brief READONLY: max blocks written per batch by the writer thread
+     */
+    static const size_t DEF_BATCH_SIZE;
+
+    /**
+     * @brief READONLY: default per-thread staging buffer size (KiB)
+     */
+    static const size_t DEF_STAGING_KB;
+
+    /**
+     * @brief READONLY: default staging buffer flush timeout
+     */
+    static const std::chrono::milliseconds DEF_STAGING_TIMEOUT;
+
 public:
     /**
      * @brief log writer constructor with set locale
@@ -191,6 +235,29 @@ public:
          */
         template<typename T, typename... Types>
         static void FileW(IN std::wofstream&, IN const std::wstring&, IN T, IN Types...);
+
+    public:
+        /**
+         * @brief STATIC: wide string write to memory stream / variadic template method
+         *
+         * @tparam T
+         * @param std::wostream [in] stream
+         * @param std::wstring  [in] delemeter
+         * @param T             [in] parameter
+         */
+        template<typename T> static void StreamW(IN std::wostream&, IN const std::wstring&, IN T);
+
+        /**
+         * @brief STATIC: wide string write to memory stream / variadic template method
+         *
+         * @tparam T
+         * @param std::wostream [in] stream
+         * @param std::wstring  [in] delemeter
+         * @param T             [in] parameter
+         * @param Types         [in] parameter pack
+         */
+        template<typename T, typename... Types>
+        static void StreamW(IN std::wostream&, IN const std::wstring&, IN T, IN Types...);
     };
 
 
@@ -208,6 +275,7 @@ public:
 public:
     /**
      * @brief wrtie to the file (e.g. ["time"] => "content") / thread safe
+     * @note  async mode: formats to the per-thread staging buffer only, refer to Start()
      * @warning using FileW => std::wstring
      *
      * @tparam T [in] parameter
@@ -216,6 +284,16 @@ public:
      */
     template<typename T, typename... Types> void Log(IN T, IN Types...);
 
+    /**
+     * @brief wrtie to the file with format (e.g. Log<"conn {} closed after {} ms">(id, ms)) / thread safe
+     * @note  format is parsed at compile time, refer to LogFormatter
+     *
+     * @tparam F     format string
+     * @tparam Types [in] parameter pack, forwarded
+     * @throw std::runtime_error
+     */
+    template<LogFormat F, typename... Types> void Log(IN Types&&...);
+
     /**
      * @brief wrtie to console (e.g. ["time"] => "content") / thread safe
      * @warning using ConsolW => std::wstring
@@ -225,6 +303,17 @@ public:
      */
     template<typename T, typename... Types> void Print(IN T, IN Types...);
 
+    /**
+     * @brief   wrtie binary record to the file (e.g. "path/to/1900-01-01.bin.log") / thread safe
+     * @note    use LOG_BINARY(), the call site is registered once and the file is decoded by LogDecoder
+     * @warning arguments: arithmetic, char / wchar_t string only
+     *
+     * @tparam Tag   format holder, refer to LOG_BINARY()
+     * @tparam Types [in] parameter pack
+     * @throw std::runtime_error
+     */
+    template<typename Tag, typename... Types> void Binary(IN const Types&...);
+
 public:
     /**
      * @brief check date
@@ -235,12 +324,252 @@ public:
      */
     bool Update();
 
+public:
+    /**
+     * @brief   begin async mode, Log() formats into the staging buffer of the calling thread,
+     *          full blocks are enqueued and the writer thread writes them to the file
+     * @note    the staging buffer is handed off when full, timed out or Flush() called
+     * @warning not thread safe with Log(), call before logging starts
+     *
+     * @param capacity  [in] queue capacity (blocks)
+     * @param policy    [in] behavior when the queue is full
+     * @param stagingKB [in] per-thread staging buffer size, 0: hand off every record
+     * @param timeout   [in] max time a record stays in the staging buffer
+     * @throw std::runtime_error already started
+     */
+    void Start(IN size_t                    capacity  = DEF_QUEUE_CAPACITY,
+               IN EOverflowPolicy           policy    = BLOCK,
+               IN size_t                    stagingKB = DEF_STAGING_KB,
+               IN std::chrono::milliseconds timeout   = DEF_STAGING_TIMEOUT);
+
+    /**
+     * @brief   write all queued records, then end async mode
+     * @warning not thread safe with Log(), call after logging ends
+     */
+    void Stop();
+
+    /**
+     * @brief get count of records discarded by the overflow policy
+     *
+     * @return uint64_t
+     */
+    uint64_t GetDropped() const;
+
+    /**
+     * @brief async mode: hand off the staging buffer of the calling thread
+     *        sync mode:  flush the file stream
+     */
+    void Flush();
+
+private:
+    /**
+     * @brief records handed off at once
+     */
+    struct Block
+    {
+        std::wstring text;
+        std::string  binary;
+        uint32_t     records;
+    };
+
+    /**
+     * @brief per-thread formatting buffer
+     * @note  owned by the writer, touched by the owner thread and the writer thread (timeout)
+     */
+    struct Staging
+    {
+        Staging(IN const Timer&);
+
+        Timer::StampCache                     stamp;
+        std::wostringstream                   stream;
+        std::string                           binary;
+        std::chrono::steady_clock::time_point first;
+        uint32_t                              records;
+        std::atomic_flag                      busy;
+    };
+
+private:
+    /**
+     * @brief get the staging buffer of the calling thread, create if not exist
+     * @note  creating drops the entries of stopped Start() calls from the thread local cache
+     *
+     * @return Staging*
+     */
+    Staging* Local();
+
+    /**
+     * @brief lock staging buffer, it is contended with the writer thread only
+     *
+     * @param Staging [in]
+     */
+    static void Acquire(IN Staging*);
+
+    /**
+     * @brief unlock staging buffer
+     *
+     * @param Staging [in]
+     */
+    static void Release(IN Staging*);
+
+    /**
+     * @brief check staging buffer hand off condition
+     *
+     * @param Staging [in]
+     * @return true: full or timed out
+     */
+    bool IsExpired(IN Staging*) const;
+
+    /**
+     * @brief move the staging buffer to the queue
+     * @warning staging buffer must be acquired
+     *
+     * @param Staging [in]
+     * @param isWait  [in] true: follow the overflow policy / false: fail when the queue is full
+     * @return true: handed off / false: queue is full
+     */
+    bool Handoff(IN Staging*, IN bool isWait);
+
+    /**
+     * @brief push a block to the queue according to the overflow policy
+     *
+     * @param Block [in] moved when succeeded
+     */
+    void Enqueue(IN Block&&);
+
+    /**
+     * @brief writer thread: hand off idle staging buffers
+     *
+     * @param isForce [in] true: ignore timeout
+     * @param next    [out, opt] earliest timeout of the records left, unchanged: none
+     * @return true: all staging buffers are empty
+     */
+    bool Collect(IN bool isForce, OUT OPT std::chrono::steady_clock::time_point* next = nullptr);
+
+    /**
+     * @brief wake the writer thread if it sleeps
+     * @note  called after a block is queued or a staging buffer gets its first record
+     */
+    void Notify();
+
+    /**
+     * @brief make text record (e.g. ["time"] => "content")
+     *
+     * @tparam F     format string
+     * @tparam Types [in] parameter pack
+     * @param line  [out] cleared before writing
+     * @param cache [in] updated timestamp
+     */
+    template<LogFormat F, typename... Types>
+    static void Format(OUT std::wstring& line, IN const Timer::StampCache& cache, IN Types&&...);
+
+    /**
+     * @brief write binary records, open the file and write new site definitions if needed
+     * @warning writer thread or locked
+     *
+     * @param std::string [in] encoded records
+     */
+    void WriteBinary(IN const std::string&);
+
+    /**
+     * @brief writer thread procedure
+     */
+    void Run();
+
+    /**
+     * @brief write queued blocks to the file
+     *
+     * @param max [in] max blocks
+     * @return size_t written blocks count
+     */
+    size_t Drain(IN size_t max);
 
 private:
     /**
      * @brief
      */
     std::wofstream fout;
+
+    /**
+     * @brief timestamp for sync mode and Print(), used under lock
+     */
+    Timer::StampCache stamp;
+
+    /**
+     * @brief binary log file, opened on first binary record
+     */
+    std::ofstream bout;
+
+    /**
+     * @brief site definitions written to the current binary file
+     */
+    uint32_t emitted;
+
+private:
+    /**
+     * @brief async block queue, nullptr: sync mode
+     */
+    RingQueue<Block>* queue;
+
+    /**
+     * @brief staging buffers of all threads that logged
+     */
+    std::vector<Staging*> stagings;
+
+    /**
+     * @brief identifies a Start() call, for the thread local staging lookup, 0: stopped
+     */
+    uint64_t id;
+
+    /**
+     * @brief ids of Start() calls not stopped yet, of all writers, TypeLock<Staging>
+     */
+    static std::vector<uint64_t> actives;
+
+    /**
+     * @brief staging buffer size (byte)
+     */
+    size_t stagingSize;
+
+    /**
+     * @brief staging buffer flush timeout
+     */
+    std::chrono::milliseconds stagingTimeout;
+
+    /**
+     * @brief writer thread
+     */
+    std::thread writer;
+
+    /**
+     * @brief writer thread loop condition
+     */
+    std::atomic<bool> isRunning;
+
+    /**
+     * @brief writer thread sleeps on it while there is nothing to write
+     */
+    std::condition_variable signal;
+    std::mutex              signalLock;
+
+    /**
+     * @brief bumped by Notify(), the writer thread sleeps only while it is unchanged
+     */
+    std::atomic<uint64_t> signals;
+
+    /**
+     * @brief writer thread is in or entering the wait
+     */
+    std::atomic<bool> isSleeping;
+
+    /**
+     * @brief discarded record count
+     */
+    std::atomic<uint64_t> dropped;
+
+    /**
+     * @brief async overflow policy
+     */
+    EOverflowPolicy policy;
 };
 
 #include "LogWriter.ipp"
@@ -1,26 +1,138 @@
 template<typename T, typename... Types> void LogWriter::Log(T arg, Types... args)
 {
+    if(queue) {
+        Staging* staging = Local();
+
+        Acquire(staging);
+        bool isFirst = staging->records == 0;
+        if(isFirst) {
+            staging->first = std::chrono::steady_clock::now();
+        }
+        staging->stamp.Update();
+        staging->stream << L'[' << staging->stamp.GetTimeW() << "] => ";
+        Out::StreamW(staging->stream, L"", arg, args...);
+        ++staging->records;
+
+        if(IsExpired(staging)) {
+            Handoff(staging, true);
+            isFirst = false; // notified by the hand off
+        }
+        Release(staging);
+
+        // the writer thread may sleep without a timeout while no record is staged
+        if(isFirst) {
+            Notify();
+        }
+        return;
+    }
+
     TypeLock<LogWriter>::Mutex lock;
 
     Update();
-    std::string  temp = timer.StampingFromSystemTime();
-    std::wstring timestamp(temp.begin(), temp.end());
+    stamp.Update();
 
-    fout << L'[' << timestamp << "] => ";
+    fout << L'[' << stamp.GetTimeW() << "] => ";
     Out::FileW(fout, L"", arg, args...);
 }
 
-template<typename T, typename... Types> void LogWriter::Print(T arg, Types... args)
+template<LogFormat F, typename... Types> void LogWriter::Log(Types&&... args)
 {
+    thread_local std::wstring line;
+
+    if(queue) {
+        Staging* staging = Local();
+
+        Acquire(staging);
+        bool isFirst = staging->records == 0;
+        if(isFirst) {
+            staging->first = std::chrono::steady_clock::now();
+        }
+        staging->stamp.Update();
+        Format<F>(line, staging->stamp, std::forward<Types>(args)...);
+        staging->stream.write(line.data(), line.size());
+        ++staging->records;
+
+        if(IsExpired(staging)) {
+            Handoff(staging, true);
+            isFirst = false; // notified by the hand off
+        }
+        Release(staging);
+
+        // the writer thread may sleep without a timeout while no record is staged
+        if(isFirst) {
+            Notify();
+        }
+        return;
+    }
+
     TypeLock<LogWriter>::Mutex lock;
 
-    std::string  temp = timer.StampingFromSystemTime();
-    std::wstring timestamp(temp.begin(), temp.end());
+    Update();
+    stamp.Update();
+    Format<F>(line, stamp, std::forward<Types>(args)...);
+    fout.write(line.data(), line.size());
+    fout.flush();
+}
+
+template<LogFormat F, typename... Types>
+void LogWriter::Format(std::wstring& line, const Timer::StampCache& cache, Types&&... args)
+{
+    line.clear();
+    line.push_back(L'[');
+    line.append(cache.GetTimeW(), cache.GetTimeLength());
+    line.append(L"] => ");
+    LogFormatter<F>::Write(line, std::forward<Types>(args)...);
+    line.push_back(L'\n');
+}
 
-    std::wcout << L'[' << timestamp << "] => ";
+template<typename T, typename... Types> void LogWriter::Print(T arg, Types... args)
+{
+    TypeLock<LogWriter>::Mutex lock;
+
+    stamp.Update();
+    std::wcout << L'[' << stamp.GetTimeW() << "] => ";
     Out::ConsoleW(L"", arg, args...);
 }
 
+template<typename Tag, typename... Types> void LogWriter::Binary(const Types&... args)
+{
+    uint32_t id = LogSite<Tag, std::decay_t<Types>...>::id;
+
+    if(queue) {
+        Staging* staging = Local();
+
+        Acquire(staging);
+        bool isFirst = staging->records == 0;
+        if(isFirst) {
+            staging->first = std::chrono::steady_clock::now();
+        }
+        LogBinary::EncodeRecord(staging->binary, id, args...);
+        ++staging->records;
+
+        if(IsExpired(staging)) {
+            Handoff(staging, true);
+            isFirst = false; // notified by the hand off
+        }
+        Release(staging);
+
+        // the writer thread may sleep without a timeout while no record is staged
+        if(isFirst) {
+            Notify();
+        }
+        return;
+    }
+
+    thread_local std::string bytes;
+    bytes.clear();
+    LogBinary::EncodeRecord(bytes, id, args...);
+
+    TypeLock<LogWriter>::Mutex lock;
+
+    Update();
+    WriteBinary(bytes);
+    bout.flush();
+}
+
 template<typename T> void LogWriter::Out::ConsoleA(const std::string& delimiter, T arg)
 {
     std::cout << arg << std::endl;
@@ -79,4 +191,19 @@ void LogWriter::Out::FileW(std::wofstream& fout, const std::wstring& delimiter,
         fout << delimiter;
     }
     FileW(fout, delimiter, args...);
+}
+
+template<typename T> void LogWriter::Out::StreamW(std::wostream& stream, const std::wstring& delimiter, T arg)
+{
+    stream << arg << L'\n';
+}
+
+template<typename T, typename... Types>
+void LogWriter::Out::StreamW(std::wostream& stream, const std::wstring& delimiter, T arg, Types... args)
+{
+    stream << arg;
+    if(delimiter.size()) {
+        stream << delimiter;
+    }
+    StreamW(stream, delimiter, args...);
 }
\ No newline at end of file
@@ -0,0 +1,117 @@
+/**
+ * @file    LogDecode.cpp
+ * @author  LaverWinEmpty@google.com
+ * @brief   binary log decoder tool, LogWriter::Binary() files to text (e.g. ["time"] => "content")
+ * @version 0.0.1
+ * @date    2026-10-18
+ *
+ * @copyright Copyright (c) 2023
+ *
+ * usage: LogDecode [-s | -ms | -us | -ns] [-o text] (-d directory | file.bin.log...)
+ *        -s ~ -ns: sub-second digits of timestamps, default -ns
+ *        -o:       append to the text file, default console
+ *        -d:       today's binary log file of the directory
+ *
+ * build: g++ -std=c++20 -O2 LogDecode.cpp ../log/LogDecoder.cpp ../log/LogBase.cpp ../log/LogBinary.cpp
+ *            ../../utilities/utilities/Timer.cpp ../../utilities/utilities/Clock.cpp -o LogDecode
+ */
+
+#include "iostream"
+#include "fstream"
+#include "cstring"
+#include "../log/LogDecoder.hpp"
+
+/**
+ * @brief print usage
+ */
+static void Usage()
+{
+    std::wcerr << L"usage: LogDecode [-s | -ms | -us | -ns] [-o text] (-d directory | file.bin.log...)" << std::endl;
+}
+
+/**
+ * @brief command line argument to wide string
+ *
+ * @param arg [in]
+ * @return std::wstring
+ */
+static std::wstring Widen(IN const char* arg)
+{
+    return std::filesystem::path(arg).wstring();
+}
+
+int main(int argc, char* argv[])
+{
+    int                       types = Timer::HIDE_WEEKDAY | Timer::SHOW_NANOSECONDS;
+    std::wstring              output;
+    std::wstring              directory;
+    std::vector<std::wstring> inputs;
+
+    for(int i = 1; i < argc; ++i) {
+        if(!std::strcmp(argv[i], "-s")) {
+            types = Timer::HIDE_WEEKDAY;
+        }
+        else if(!std::strcmp(argv[i], "-ms")) {
+            types = Timer::HIDE_WEEKDAY | Timer::SHOW_MILLISECONDS;
+        }
+        else if(!std::strcmp(argv[i], "-us")) {
+            types = Timer::HIDE_WEEKDAY | Timer::SHOW_MICROSECONDS;
+        }
+        else if(!std::strcmp(argv[i], "-ns")) {
+            types = Timer::HIDE_WEEKDAY | Timer::SHOW_NANOSECONDS;
+        }
+        else if(!std::strcmp(argv[i], "-o") && i + 1 < argc) {
+            output = Widen(argv[++i]);
+        }
+        else if(!std::strcmp(argv[i], "-d") && i + 1 < argc) {
+            directory = Widen(argv[++i]);
+        }
+        else if(argv[i][0] == '-') {
+            Usage();
+            return 2;
+        }
+        else {
+            inputs.push_back(Widen(argv[i]));
+        }
+    }
+
+    if(inputs.empty() == directory.empty()) {
+        Usage();
+        return 2;
+    }
+
+    // environment locale: non-ASCII text is not written by the default "C" locale
+    LogBase::SetLocaleGlobal("");
+    LogBase::SetLocaleConsole("");
+
+    std::wofstream file;
+    if(output.size()) {
+        file.imbue(std::locale(""));
+        file.open(std::filesystem::path(output), std::ios_base::out | std::ios_base::app);
+        if(!file.is_open()) {
+            std::wcerr << L"cannot open " << output << std::endl;
+            return 1;
+        }
+    }
+    std::wostream& to = output.size() ? static_cast<std::wostream&>(file) : std::wcout;
+
+    // keep going: a broken file is decoded until the broken record
+    int result = 0;
+    if(directory.size()) {
+        LogDecoder decoder(directory);
+        decoder.SetTimeStampShowTypes(types);
+        if(!decoder.Decode(to)) {
+            std::wcerr << L"not exist or broken: today's file of " << directory << std::endl;
+            result = 1;
+        }
+    }
+    for(const std::wstring& input : inputs) {
+        LogDecoder decoder;
+        decoder.SetTimeStampShowTypes(types);
+        if(!decoder.Decode(input, to)) {
+            std::wcerr << L"not exist or broken: " << input << std::endl;
+            result = 1;
+        }
+    }
+    return result;
+}
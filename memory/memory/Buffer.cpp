@@ -0,0 +1,251 @@
+#include "Buffer.hpp"
+#include "new"
+
+const size_t BufferChunk::DEF_CAPACITY = (16 << 10) - sizeof(BufferChunk);
+
+BufferChunk::BufferChunk(size_t capacity, bool isPooled):
+    refs(1), capacity(static_cast<uint32_t>(capacity)), isPooled(isPooled)
+{
+}
+
+BufferChunk* BufferChunk::Create(size_t capacity)
+{
+    if(capacity <= DEF_CAPACITY) {
+        return new(Pool().Allocate()) BufferChunk(DEF_CAPACITY, true);
+    }
+
+    void* block = ::operator new(sizeof(BufferChunk) + capacity, std::align_val_t(alignof(BufferChunk)));
+    return new(block) BufferChunk(capacity, false);
+}
+
+SlabAllocator::Stats BufferChunk::GetStats()
+{
+    return Pool().GetStats();
+}
+
+SlabAllocator& BufferChunk::Pool()
+{
+    // never destroyed: references may be released by threads still running at exit
+    static SlabAllocator* pool = new SlabAllocator(sizeof(BufferChunk) + DEF_CAPACITY, alignof(BufferChunk));
+    return *pool;
+}
+
+BufferRef::BufferRef(size_t capacity): chunk(BufferChunk::Create(capacity)), offset(0), size(0)
+{
+    size = static_cast<uint32_t>(chunk->GetCapacity());
+}
+
+BufferRef BufferRef::Slice(size_t offset, size_t size) const
+{
+    BufferRef result;
+    if(chunk == nullptr || offset >= this->size) {
+        return result;
+    }
+
+    chunk->AddRef();
+    result.chunk  = chunk;
+    result.offset = this->offset + static_cast<uint32_t>(offset);
+    result.size   = static_cast<uint32_t>(MIN(size, this->size - offset));
+    return result;
+}
+
+void BufferRef::Advance(size_t size)
+{
+    uint32_t count = static_cast<uint32_t>(MIN(size, static_cast<size_t>(this->size)));
+    offset += count;
+    this->size -= count;
+}
+
+void BufferRef::Truncate(size_t size)
+{
+    this->size = static_cast<uint32_t>(MIN(size, static_cast<size_t>(this->size)));
+}
+
+BufferChain::BufferChain(): size(0) {}
+
+void BufferChain::Append(const BufferRef& ref)
+{
+    if(!ref.IsEmpty()) {
+        refs.push_back(ref);
+        size += ref.GetSize();
+    }
+}
+
+void BufferChain::Append(BufferRef&& ref)
+{
+    if(!ref.IsEmpty()) {
+        size += ref.GetSize();
+        refs.push_back(std::move(ref));
+    }
+}
+
+void BufferChain::Append(const BufferChain& other)
+{
+    if(&other == this) {
+        BufferChain copy = other;
+        Append(copy);
+        return;
+    }
+
+    for(const BufferRef& ref : other.refs) {
+        refs.push_back(ref);
+    }
+    size += other.size;
+}
+
+void BufferChain::Write(const void* data, size_t size)
+{
+    // empty body (e.g. nullptr, 0): memcpy from nullptr is undefined even for 0 bytes
+    if(size == 0) {
+        return;
+    }
+
+    const char* source = static_cast<const char*>(data);
+
+    // extend the last range in place: no other reference can see the tailroom
+    if(!refs.empty()) {
+        BufferRef& back = refs.back();
+        if(back.chunk->IsUnique() && back.GetTailroom()) {
+            size_t count = MIN(size, back.GetTailroom());
+            memcpy(back.GetData() + back.size, source, count);
+            back.size += static_cast<uint32_t>(count);
+            this->size += count;
+            source += count;
+            size -= count;
+        }
+    }
+
+    while(size) {
+        BufferRef ref(MIN(size, BufferChunk::DEF_CAPACITY));
+        size_t    count = MIN(size, ref.GetSize());
+        memcpy(ref.GetData(), source, count);
+        ref.Truncate(count);
+        Append(std::move(ref));
+        source += count;
+        size -= count;
+    }
+}
+
+size_t BufferChain::Read(void* data, size_t size, size_t offset) const
+{
+    char*  target = static_cast<char*>(data);
+    size_t copied = 0;
+
+    for(const BufferRef& ref : refs) {
+        if(copied == size) {
+            break;
+        }
+        if(offset >= ref.GetSize()) {
+            offset -= ref.GetSize();
+            continue;
+        }
+
+        size_t count = MIN(size - copied, ref.GetSize() - offset);
+        memcpy(target + copied, ref.GetData() + offset, count);
+        copied += count;
+        offset = 0;
+    }
+    return copied;
+}
+
+void BufferChain::Consume(size_t size)
+{
+    size = MIN(size, this->size);
+    this->size -= size;
+
+    while(size) {
+        BufferRef& front = refs.front();
+        if(size < front.GetSize()) {
+            front.Advance(size);
+            return;
+        }
+        size -= front.GetSize();
+        refs.pop_front();
+    }
+}
+
+BufferChain BufferChain::Split(size_t size)
+{
+    BufferChain result;
+
+    size = MIN(size, this->size);
+    this->size -= size;
+
+    while(size) {
+        BufferRef& front = refs.front();
+        if(size < front.GetSize()) {
+            result.Append(front.Slice(0, size));
+            front.Advance(size);
+            break;
+        }
+        size -= front.GetSize();
+        result.Append(std::move(front));
+        refs.pop_front();
+    }
+    return result;
+}
+
+BufferChain BufferChain::Slice(size_t offset, size_t size) const
+{
+    BufferChain result;
+
+    for(const BufferRef& ref : refs) {
+        if(size == 0) {
+            break;
+        }
+        if(offset >= ref.GetSize()) {
+            offset -= ref.GetSize();
+            continue;
+        }
+
+        BufferRef part = ref.Slice(offset, size);
+        size -= part.GetSize();
+        offset = 0;
+        result.Append(std::move(part));
+    }
+    return result;
+}
+
+BufferRef BufferChain::Contiguous(size_t size) const
+{
+    size = MIN(size, this->size);
+    if(size == 0) {
+        return BufferRef();
+    }
+
+    if(refs.front().GetSize() >= size) {
+        return refs.front().Slice(0, size);
+    }
+
+    BufferRef result(size);
+    Read(result.GetData(), size);
+    result.Truncate(size);
+    return result;
+}
+
+size_t BufferChain::Gather(iovec* vectors, size_t count, size_t offset) const
+{
+    size_t used = 0;
+
+    for(const BufferRef& ref : refs) {
+        if(used == count) {
+            break;
+        }
+        if(offset >= ref.GetSize()) {
+            offset -= ref.GetSize();
+            continue;
+        }
+
+        vectors[used].iov_base = ref.GetData() + offset;
+        vectors[used].iov_len  = ref.GetSize() - offset;
+        ++used;
+        offset = 0;
+    }
+    return used;
+}
+
+void BufferChain::Clear()
+{
+    refs.clear();
+    size = 0;
+}
@@ -0,0 +1,285 @@
+/**
+ * @file    Buffer.hpp
+ * @author  LaverWinEmpty@google.com
+ * @brief   reference counted chained buffer
+ * @version 0.0.1
+ * @date    2026-10-17
+ *
+ * @copyright Copyright (c) 2023
+ *
+ */
+
+#ifndef LWE__BUFFER_HPP__
+#define LWE__BUFFER_HPP__
+
+#include "deque"
+#include "atomic"
+#include "SlabPool.hpp"
+#include "../../include/include/includes.hpp"
+
+#if _WIN32 || _WIN64
+/**
+ * @brief scatter / gather element, same layout as POSIX
+ */
+struct iovec
+{
+    void*  iov_base;
+    size_t iov_len;
+};
+#else
+#    include "sys/uio.h"
+#endif
+
+/**
+ * @brief reference counted memory block, header followed by data
+ * @note  DEF_CAPACITY or less: from a process wide slab pool, otherwise heap
+ */
+class alignas(CACHE_LINE_SIZE) BufferChunk
+{
+public:
+    /**
+     * @brief READONLY: pooled data size (16 KiB block with header)
+     */
+    static const size_t DEF_CAPACITY;
+
+public:
+    /**
+     * @brief create with one reference
+     * @throw std::bad_alloc
+     *
+     * @param capacity [in] data size
+     * @return BufferChunk*
+     */
+    static BufferChunk* Create(IN size_t capacity = DEF_CAPACITY);
+
+    /**
+     * @brief chunk pool counters
+     *
+     * @return SlabAllocator::Stats
+     */
+    static SlabAllocator::Stats GetStats();
+
+public:
+    DECLARE_NO_COPY(BufferChunk);
+
+public:
+    /**
+     * @brief add reference / thread safe
+     */
+    void AddRef();
+
+    /**
+     * @brief remove reference, free at 0 / thread safe
+     */
+    void Release();
+
+    /**
+     * @brief check sole owner: writable without affecting other references
+     */
+    bool IsUnique() const;
+
+    char*  GetData();
+    size_t GetCapacity() const;
+
+private:
+    BufferChunk(IN size_t capacity, IN bool isPooled);
+
+    /**
+     * @brief pool of DEF_CAPACITY chunks
+     */
+    static SlabAllocator& Pool();
+
+private:
+    std::atomic<uint32_t> refs;
+    uint32_t              capacity;
+    bool                  isPooled;
+};
+
+/**
+ * @brief counted view of a chunk range, copy shares the chunk
+ * @note  not thread safe, copies are independent (e.g. one copy per session for broadcast)
+ */
+class BufferRef
+{
+public:
+    /**
+     * @brief empty reference
+     */
+    BufferRef();
+
+    /**
+     * @brief new chunk, whole capacity (e.g. recv target, then Truncate(received))
+     * @throw std::bad_alloc
+     *
+     * @param capacity [in]
+     */
+    explicit BufferRef(IN size_t capacity);
+
+    BufferRef(IN const BufferRef&);
+    BufferRef(IN BufferRef&&) noexcept;
+    BufferRef& operator=(IN const BufferRef&);
+    BufferRef& operator=(IN BufferRef&&) noexcept;
+    ~BufferRef();
+
+public:
+    /**
+     * @brief sub range sharing the chunk, zero-copy
+     *
+     * @param offset [in] clamped
+     * @param size   [in] clamped
+     * @return BufferRef
+     */
+    BufferRef Slice(IN size_t offset, IN size_t size) const;
+
+    /**
+     * @brief drop front bytes
+     *
+     * @param size [in] clamped
+     */
+    void Advance(IN size_t size);
+
+    /**
+     * @brief drop back bytes
+     *
+     * @param size [in] new size, clamped
+     */
+    void Truncate(IN size_t size);
+
+    /**
+     * @brief release chunk
+     */
+    void Reset();
+
+public:
+    char*        GetData() const;
+    size_t       GetSize() const;
+    BufferChunk* GetChunk() const;
+    bool         IsEmpty() const;
+
+    /**
+     * @brief unused bytes after the range, writable when the chunk is unique
+     */
+    size_t GetTailroom() const;
+
+private:
+    friend class BufferChain;
+
+    BufferChunk* chunk;
+    uint32_t     offset;
+    uint32_t     size;
+};
+
+/**
+ * @brief byte sequence over multiple references, no contiguous storage
+ * @note  Split() / Slice() / Append(): reference counting only, no memcpy
+ *        Gather(): iovec for readv / writev / io_uring
+ *        not thread safe
+ */
+class BufferChain
+{
+public:
+    BufferChain();
+
+public:
+    /**
+     * @brief append reference, shares the chunk
+     *
+     * @param BufferRef [in] ignored if empty
+     */
+    void Append(IN const BufferRef&);
+    void Append(IN BufferRef&&);
+
+    /**
+     * @brief append all references of other chain
+     *
+     * @param BufferChain [in]
+     */
+    void Append(IN const BufferChain&);
+
+    /**
+     * @brief copy bytes, into the tailroom of the last chunk if unique, new chunks otherwise
+     * @throw std::bad_alloc
+     *
+     * @param data [in]
+     * @param size [in]
+     */
+    void Write(IN const void* data, IN size_t size);
+
+    /**
+     * @brief copy bytes out without consuming (e.g. header across chunks)
+     *
+     * @param data   [out]
+     * @param size   [in]
+     * @param offset [in] from front
+     * @return size_t copied, less than size if short
+     */
+    size_t Read(OUT void* data, IN size_t size, IN size_t offset = 0) const;
+
+    /**
+     * @brief drop front bytes (e.g. after writev)
+     *
+     * @param size [in] clamped
+     */
+    void Consume(IN size_t size);
+
+    /**
+     * @brief remove front bytes as a chain, zero-copy
+     *
+     * @param size [in] clamped
+     * @return BufferChain
+     */
+    BufferChain Split(IN size_t size);
+
+    /**
+     * @brief range as a chain, zero-copy
+     *
+     * @param offset [in] clamped
+     * @param size   [in] clamped
+     * @return BufferChain
+     */
+    BufferChain Slice(IN size_t offset, IN size_t size) const;
+
+    /**
+     * @brief front bytes as one reference, copied only if they span chunks
+     * @throw std::bad_alloc
+     *
+     * @param size [in] clamped
+     * @return BufferRef
+     */
+    BufferRef Contiguous(IN size_t size) const;
+
+    /**
+     * @brief fill iovec from front
+     *
+     * @param vectors [out]
+     * @param count   [in] vectors size (e.g. IOV_MAX)
+     * @param offset  [in] skip front bytes
+     * @return size_t used vectors
+     */
+    size_t Gather(OUT iovec* vectors, IN size_t count, IN size_t offset = 0) const;
+
+    /**
+     * @brief release all references
+     */
+    void Clear();
+
+public:
+    size_t GetSize() const;
+    size_t GetCount() const;
+    bool   IsEmpty() const;
+
+    /**
+     * @brief get reference
+     *
+     * @param index [in] < GetCount()
+     * @return const BufferRef&
+     */
+    const BufferRef& operator[](IN size_t index) const;
+
+private:
+    std::deque<BufferRef> refs;
+    size_t                size;
+};
+
+#include "Buffer.ipp"
+#endif
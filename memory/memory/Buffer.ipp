@@ -0,0 +1,139 @@
+inline void BufferChunk::AddRef()
+{
+    refs.fetch_add(1, std::memory_order_relaxed);
+}
+
+inline void BufferChunk::Release()
+{
+    if(refs.fetch_sub(1, std::memory_order_acq_rel) != 1) {
+        return;
+    }
+
+    if(isPooled) {
+        this->~BufferChunk();
+        Pool().Release(this);
+    }
+    else {
+        this->~BufferChunk();
+        ::operator delete(this, std::align_val_t(alignof(BufferChunk)));
+    }
+}
+
+inline bool BufferChunk::IsUnique() const
+{
+    return refs.load(std::memory_order_acquire) == 1;
+}
+
+inline char* BufferChunk::GetData()
+{
+    return reinterpret_cast<char*>(this + 1);
+}
+
+inline size_t BufferChunk::GetCapacity() const
+{
+    return capacity;
+}
+
+inline BufferRef::BufferRef(): chunk(nullptr), offset(0), size(0) {}
+
+inline BufferRef::BufferRef(const BufferRef& other): chunk(other.chunk), offset(other.offset), size(other.size)
+{
+    if(chunk) {
+        chunk->AddRef();
+    }
+}
+
+inline BufferRef::BufferRef(BufferRef&& other) noexcept: chunk(other.chunk), offset(other.offset), size(other.size)
+{
+    other.chunk  = nullptr;
+    other.offset = 0;
+    other.size   = 0;
+}
+
+inline BufferRef& BufferRef::operator=(const BufferRef& other)
+{
+    if(this != &other) {
+        if(other.chunk) {
+            other.chunk->AddRef();
+        }
+        Reset();
+        chunk  = other.chunk;
+        offset = other.offset;
+        size   = other.size;
+    }
+    return *this;
+}
+
+inline BufferRef& BufferRef::operator=(BufferRef&& other) noexcept
+{
+    if(this != &other) {
+        Reset();
+        chunk        = other.chunk;
+        offset       = other.offset;
+        size         = other.size;
+        other.chunk  = nullptr;
+        other.offset = 0;
+        other.size   = 0;
+    }
+    return *this;
+}
+
+inline BufferRef::~BufferRef()
+{
+    Reset();
+}
+
+inline void BufferRef::Reset()
+{
+    if(chunk) {
+        chunk->Release();
+        chunk = nullptr;
+    }
+    offset = 0;
+    size   = 0;
+}
+
+inline char* BufferRef::GetData() const
+{
+    return chunk ? chunk->GetData() + offset : nullptr;
+}
+
+inline size_t BufferRef::GetSize() const
+{
+    return size;
+}
+
+inline BufferChunk* BufferRef::GetChunk() const
+{
+    return chunk;
+}
+
+inline bool BufferRef::IsEmpty() const
+{
+    return size == 0;
+}
+
+inline size_t BufferRef::GetTailroom() const
+{
+    return chunk ? chunk->GetCapacity() - offset - size : 0;
+}
+
+inline size_t BufferChain::GetSize() const
+{
+    return size;
+}
+
+inline size_t BufferChain::GetCount() const
+{
+    return refs.size();
+}
+
+inline bool BufferChain::IsEmpty() const
+{
+    return size == 0;
+}
+
+inline const BufferRef& BufferChain::operator[](size_t index) const
+{
+    return refs[index];
+}
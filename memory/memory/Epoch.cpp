@@ -0,0 +1,177 @@
+#include "Epoch.hpp"
+#include "thread"
+
+std::atomic<uint64_t>       Epoch::global(0);
+std::atomic<Epoch::Record*> Epoch::records(nullptr);
+std::atomic<uint64_t>       Epoch::advances(0);
+std::atomic<bool>           Epoch::hasOrphans(false);
+std::vector<Epoch::Retired> Epoch::orphans;
+uint64_t                    Epoch::orphanFrees = 0;
+
+uint64_t Epoch::Stats::GetPending() const
+{
+    return retires - frees;
+}
+
+void Epoch::Retire(void* pointer, Deleter deleter)
+{
+    if(pointer == nullptr) {
+        return;
+    }
+
+    Record* record = Local();
+    record->retired.push_back({ pointer, deleter, global.load(std::memory_order_acquire) });
+    Add(record->retires, 1);
+
+    // every BATCH: a blocked epoch does not turn each Retire() into a scan
+    if(record->retired.size() % BATCH == 0) {
+        Reclaim(record);
+    }
+}
+
+void Epoch::Quiescent()
+{
+    Record* record = Local();
+    if(record->depth) {
+        Announce(record);
+    }
+    if(!record->retired.empty() || hasOrphans.load(std::memory_order_relaxed)) {
+        Reclaim(record);
+    }
+}
+
+size_t Epoch::Collect()
+{
+    return Reclaim(Local());
+}
+
+void Epoch::Drain()
+{
+    Record* record = Local();
+    while(true) {
+        Reclaim(record);
+        if(record->retired.empty() && !hasOrphans.load(std::memory_order_acquire)) {
+            return;
+        }
+        std::this_thread::yield();
+    }
+}
+
+Epoch::Stats Epoch::GetStats()
+{
+    Stats result = {};
+    result.epoch    = global.load(std::memory_order_relaxed);
+    result.advances = advances.load(std::memory_order_relaxed);
+
+    for(Record* record = records.load(std::memory_order_acquire); record; record = record->next) {
+        result.retires += record->retires.load(std::memory_order_relaxed);
+        result.frees   += record->frees.load(std::memory_order_relaxed);
+    }
+
+    TypeLock<Epoch>::Adaptive lock;
+    result.frees += orphanFrees;
+    return result;
+}
+
+Epoch::Owner::~Owner()
+{
+    if(record == nullptr) {
+        return;
+    }
+
+    record->depth = 0;
+    record->state.store(0, std::memory_order_release);
+
+    if(!record->retired.empty()) {
+        TypeLock<Epoch>::Adaptive lock;
+        orphans.insert(orphans.end(), record->retired.begin(), record->retired.end());
+        hasOrphans.store(true, std::memory_order_release);
+    }
+    record->retired.clear();
+    record->isUsed.store(false, std::memory_order_release);
+}
+
+Epoch::Record* Epoch::Register()
+{
+    // released by an exited thread
+    for(Record* record = records.load(std::memory_order_acquire); record; record = record->next) {
+        bool expected = false;
+        if(!record->isUsed.load(std::memory_order_relaxed) &&
+           record->isUsed.compare_exchange_strong(expected, true, std::memory_order_acquire)) {
+            return record;
+        }
+    }
+
+    Record* record = new Record();
+    record->state.store(0, std::memory_order_relaxed);
+    record->isUsed.store(true, std::memory_order_relaxed);
+    record->depth = 0;
+    record->retires.store(0, std::memory_order_relaxed);
+    record->frees.store(0, std::memory_order_relaxed);
+
+    record->next = records.load(std::memory_order_relaxed);
+    while(!records.compare_exchange_weak(record->next, record, std::memory_order_release)) {
+        pass;
+    }
+    return record;
+}
+
+void Epoch::Announce(Record* record)
+{
+    // visible before any shared load of the critical section
+    uint64_t epoch = global.load(std::memory_order_relaxed);
+    record->state.store((epoch << 1) | 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+}
+
+bool Epoch::TryAdvance()
+{
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    uint64_t epoch = global.load(std::memory_order_acquire);
+
+    // an active thread still in an older epoch may hold nodes retired in (epoch - 1)
+    for(Record* record = records.load(std::memory_order_acquire); record; record = record->next) {
+        uint64_t state = record->state.load(std::memory_order_acquire);
+        if((state & 1) && (state >> 1) != epoch) {
+            return false;
+        }
+    }
+
+    if(global.compare_exchange_strong(epoch, epoch + 1, std::memory_order_acq_rel)) {
+        advances.fetch_add(1, std::memory_order_relaxed);
+        return true;
+    }
+    return false;
+}
+
+size_t Epoch::Free(std::vector<Retired>& list)
+{
+    uint64_t epoch = global.load(std::memory_order_acquire);
+
+    // retire order: epochs are not decreasing, free the safe prefix
+    size_t count = 0;
+    while(count < list.size() && list[count].epoch + 2 <= epoch) {
+        list[count].deleter(list[count].pointer);
+        ++count;
+    }
+    list.erase(list.begin(), list.begin() + count);
+    return count;
+}
+
+size_t Epoch::Reclaim(Record* record)
+{
+    TryAdvance();
+
+    size_t count = Free(record->retired);
+    Add(record->frees, count);
+
+    if(hasOrphans.load(std::memory_order_acquire)) {
+        TypeLock<Epoch>::Adaptive lock;
+
+        size_t freed = Free(orphans);
+        orphanFrees += freed;
+        count       += freed;
+        hasOrphans.store(!orphans.empty(), std::memory_order_release);
+    }
+    return count;
+}
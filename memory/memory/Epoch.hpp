@@ -0,0 +1,232 @@
+/**
+ * @file    Epoch.hpp
+ * @author  LaverWinEmpty@google.com
+ * @brief   epoch based memory reclamation
+ * @version 0.0.1
+ * @date    2026-10-17
+ *
+ * @copyright Copyright (c) 2023
+ *
+ */
+
+#ifndef LWE__EPOCH_HPP__
+#define LWE__EPOCH_HPP__
+
+#include "atomic"
+#include "vector"
+#include "../../utilities/utilities/LockGuard.hpp"
+#include "../../include/include/includes.hpp"
+
+/**
+ * @brief STATIC: deferred free for lock-free structures (Fraser)
+ * @note  reader: Guard while touching shared nodes, no store to the node (no reference count)
+ *        writer: unlink, then Retire(), freed after every thread in a Guard has left or passed Quiescent()
+ *        retired nodes wait in the list of the retiring thread, freed in batches of BATCH
+ *        worker loop: Quiescent() between tasks (e.g. after each Dequeue() handler)
+ *        thread exit: pending nodes are handed over and freed by other threads
+ * @warning a thread staying in a Guard blocks all reclamation
+ */
+class Epoch
+{
+public:
+    DECLARE_LIMIT_LIFECYCLE(Epoch);
+
+public:
+    /**
+     * @brief READONLY: retired count that triggers reclamation
+     */
+    static const size_t BATCH = 64;
+
+public:
+    /**
+     * @brief free function of a retired pointer
+     */
+    using Deleter = void (*)(void* pointer);
+
+    /**
+     * @brief counters
+     */
+    struct Stats
+    {
+        uint64_t epoch;    // global epoch
+        uint64_t retires;  // Retire()
+        uint64_t frees;    // freed
+        uint64_t advances; // epoch advanced by reclamation
+
+        /**
+         * @brief retired, not freed yet
+         */
+        uint64_t GetPending() const;
+    };
+
+    /**
+     * @brief critical section scope, nestable
+     */
+    class Guard
+    {
+    public:
+        Guard();
+        ~Guard();
+
+    public:
+        DECLARE_NO_COPY(Guard);
+    };
+
+public:
+    /**
+     * @brief begin critical section, nestable
+     */
+    static void Enter();
+
+    /**
+     * @brief end critical section
+     */
+    static void Leave();
+
+    /**
+     * @brief defer free until no thread can hold the pointer
+     * @note  call after unlinking, inside or outside of a critical section
+     * @throw std::bad_alloc
+     *
+     * @param pointer [in] nullable
+     * @param deleter [in]
+     */
+    static void Retire(IN void* pointer, IN Deleter deleter);
+
+    /**
+     * @brief defer delete
+     *
+     * @tparam T
+     * @param pointer [in] from new, nullable
+     */
+    template<typename T> static void Retire(IN T* pointer);
+
+    /**
+     * @brief quiescent state: the calling thread holds no shared node
+     * @note  inside a long lived Guard (e.g. whole worker loop), refreshes it without leaving
+     */
+    static void Quiescent();
+
+    /**
+     * @brief advance if possible and free what is safe
+     *
+     * @return size_t freed count
+     */
+    static size_t Collect();
+
+    /**
+     * @brief free all nodes retired by the calling thread and exited threads (e.g. before shutdown)
+     * @warning outside of a Guard, waits for the other threads to leave theirs
+     */
+    static void Drain();
+
+    /**
+     * @brief merge counters of all threads
+     *
+     * @return Stats
+     */
+    static Stats GetStats();
+
+private:
+    /**
+     * @brief retired pointer
+     */
+    struct Retired
+    {
+        void*    pointer;
+        Deleter  deleter;
+        uint64_t epoch;
+    };
+
+    /**
+     * @brief per-thread state, reused after the thread exits
+     * @note  state: epoch << 1 | active, written by the owner thread only
+     */
+    struct alignas(CACHE_LINE_SIZE) Record
+    {
+        std::atomic<uint64_t> state;
+        std::atomic<bool>     isUsed;
+        Record*               next; // READONLY after registration
+        uint32_t              depth;
+        std::vector<Retired>  retired;
+        std::atomic<uint64_t> retires;
+        std::atomic<uint64_t> frees;
+    };
+
+    /**
+     * @brief releases the record at thread exit
+     */
+    struct Owner
+    {
+        ~Owner();
+
+        Record* record = nullptr;
+    };
+
+private:
+    /**
+     * @brief get the record of the calling thread, acquire if not exist
+     *
+     * @return Record*
+     */
+    static Record* Local();
+
+    /**
+     * @brief reuse a released record or create one
+     *
+     * @return Record*
+     */
+    static Record* Register();
+
+    /**
+     * @brief announce the current epoch
+     *
+     * @param record [in, out]
+     */
+    static void Announce(IN OUT Record* record);
+
+    /**
+     * @brief advance the global epoch when every active thread has seen it
+     *
+     * @return true: advanced
+     */
+    static bool TryAdvance();
+
+    /**
+     * @brief free retired before (global epoch - 1)
+     *
+     * @param list [in, out] in retire order
+     * @return size_t freed count
+     */
+    static size_t Free(IN OUT std::vector<Retired>& list);
+
+    /**
+     * @brief advance and free own list and orphans
+     *
+     * @param record [in, out]
+     * @return size_t freed count
+     */
+    static size_t Reclaim(IN OUT Record* record);
+
+    /**
+     * @brief single writer increment
+     */
+    static void Add(IN OUT std::atomic<uint64_t>&, IN uint64_t value);
+
+    /**
+     * @brief deleter of Retire<T>()
+     */
+    template<typename T> static void Delete(IN void* pointer);
+
+private:
+    static std::atomic<uint64_t> global;
+    static std::atomic<Record*>  records; // list, never shrinks
+    static std::atomic<uint64_t> advances;
+
+    static std::atomic<bool>    hasOrphans;
+    static std::vector<Retired> orphans; // of exited threads, TypeLock<Epoch>
+    static uint64_t             orphanFrees;
+};
+
+#include "Epoch.ipp"
+#endif
@@ -0,0 +1,49 @@
+inline Epoch::Guard::Guard()
+{
+    Enter();
+}
+
+inline Epoch::Guard::~Guard()
+{
+    Leave();
+}
+
+inline void Epoch::Enter()
+{
+    Record* record = Local();
+    if(record->depth++ == 0) {
+        Announce(record);
+    }
+}
+
+inline void Epoch::Leave()
+{
+    Record* record = Local();
+    if(--record->depth == 0) {
+        record->state.store(record->state.load(std::memory_order_relaxed) & ~1ull, std::memory_order_release);
+    }
+}
+
+template<typename T> void Epoch::Retire(T* pointer)
+{
+    Retire(pointer, &Delete<T>);
+}
+
+template<typename T> void Epoch::Delete(void* pointer)
+{
+    delete static_cast<T*>(pointer);
+}
+
+inline Epoch::Record* Epoch::Local()
+{
+    thread_local Owner owner;
+    if(owner.record == nullptr) {
+        owner.record = Register();
+    }
+    return owner.record;
+}
+
+inline void Epoch::Add(std::atomic<uint64_t>& counter, uint64_t value)
+{
+    counter.store(counter.load(std::memory_order_relaxed) + value, std::memory_order_relaxed);
+}
@@ -0,0 +1,222 @@
+#include "SlabPool.hpp"
+#include "new"
+
+#if _WIN32 || _WIN64
+#    include "windows.h"
+#else
+#    include "unistd.h"
+#    include "sys/mman.h"
+#    include "sys/syscall.h"
+#endif
+
+const size_t SlabAllocator::DEF_SLAB_SIZE = 1 << 20;
+
+// allocator id source, not reused: stale thread cache entries are never matched
+static std::atomic<uint64_t> ids(0);
+
+SlabAllocator::SlabAllocator(size_t size, size_t align, size_t slabSize):
+    size(0), align(MAX(align, alignof(void*))), slabSize(0), id(ids.fetch_add(1, std::memory_order_relaxed)),
+    fulls(nullptr), empties(nullptr), cursors{}, depot{}
+{
+    // block holds at least a pointer, rounded up to the alignment
+    this->size     = (MAX(size, sizeof(void*)) + this->align - 1) & ~(this->align - 1);
+    this->slabSize = MAX(slabSize, this->size * MAGAZINE + this->align);
+}
+
+SlabAllocator::~SlabAllocator()
+{
+    for(Cache* cache : caches) {
+        delete cache->loaded;
+        delete cache->previous;
+        delete cache;
+    }
+
+    for(Magazine* list : { fulls, empties }) {
+        while(list) {
+            Magazine* next = list->next;
+            delete list;
+            list = next;
+        }
+    }
+
+    for(void* slab : slabs) {
+        Unmap(slab, slabSize);
+    }
+}
+
+void SlabAllocator::Reserve(size_t count)
+{
+    LockGuard::Scoped guard(lock);
+
+    while(depot.capacity < count) {
+        Magazine* magazine = Empty();
+        Carve(magazine);
+
+        magazine->next = fulls;
+        fulls          = magazine;
+    }
+}
+
+SlabAllocator::Stats SlabAllocator::GetStats() const
+{
+    LockGuard::Scoped guard(lock);
+
+    Stats result = depot;
+    for(Cache* cache : caches) {
+        result.allocations += cache->allocations.load(std::memory_order_relaxed);
+        result.releases    += cache->releases.load(std::memory_order_relaxed);
+        result.exchanges   += cache->exchanges.load(std::memory_order_relaxed);
+    }
+    return result;
+}
+
+SlabAllocator::Cache* SlabAllocator::Register(std::vector<Cache*>& local)
+{
+    Cache* cache = new Cache();
+
+    {
+        LockGuard::Scoped guard(lock);
+        cache->loaded   = Empty();
+        cache->previous = Empty();
+        caches.push_back(cache);
+    }
+
+    if(local.size() <= id) {
+        local.resize(id + 1, nullptr);
+    }
+    local[id] = cache;
+    return cache;
+}
+
+void* SlabAllocator::AllocateSlow(Cache* cache)
+{
+    // previous has blocks: swap, no depot access
+    if(cache->previous->count == 0) {
+        LockGuard::Scoped guard(lock);
+
+        // return the empty one, take a full one or carve new blocks into it
+        if(fulls) {
+            Magazine* full = fulls;
+            fulls          = full->next;
+
+            cache->previous->next = empties;
+            empties               = cache->previous;
+            cache->previous       = full;
+        }
+        else {
+            Carve(cache->previous);
+        }
+        Add(cache->exchanges, 1);
+    }
+
+    Magazine* magazine = cache->previous;
+    cache->previous    = cache->loaded;
+    cache->loaded      = magazine;
+
+    Add(cache->allocations, 1);
+    return magazine->blocks[--magazine->count];
+}
+
+void SlabAllocator::ReleaseSlow(Cache* cache, void* block)
+{
+    // previous has room: swap, no depot access
+    if(cache->previous->count == MAGAZINE) {
+        LockGuard::Scoped guard(lock);
+
+        cache->previous->next = fulls;
+        fulls                 = cache->previous;
+        cache->previous       = Empty();
+
+        Add(cache->exchanges, 1);
+    }
+
+    Magazine* magazine = cache->previous;
+    cache->previous    = cache->loaded;
+    cache->loaded      = magazine;
+
+    Add(cache->releases, 1);
+    magazine->blocks[magazine->count++] = block;
+}
+
+void SlabAllocator::Carve(Magazine* magazine)
+{
+    Cursor& cursor = cursors[Node()];
+
+    while(magazine->count < MAGAZINE) {
+        if(cursor.begin + size > cursor.end) {
+            char* slab = static_cast<char*>(Map(slabSize));
+            slabs.push_back(slab);
+            ++depot.slabs;
+
+            uintptr_t aligned = (reinterpret_cast<uintptr_t>(slab) + align - 1) & ~(align - 1);
+            cursor.begin      = reinterpret_cast<char*>(aligned);
+            cursor.end        = slab + slabSize;
+        }
+
+        magazine->blocks[magazine->count++] = cursor.begin;
+        cursor.begin += size;
+        ++depot.capacity;
+    }
+}
+
+SlabAllocator::Magazine* SlabAllocator::Empty()
+{
+    if(empties) {
+        Magazine* magazine = empties;
+        empties            = magazine->next;
+        return magazine;
+    }
+
+    Magazine* magazine = new Magazine();
+    ++depot.magazines;
+    return magazine;
+}
+
+uint32_t SlabAllocator::Node()
+{
+    uint32_t node = 0;
+
+#if _WIN32 || _WIN64
+    PROCESSOR_NUMBER number;
+    USHORT           result = 0;
+    GetCurrentProcessorNumberEx(&number);
+    if(GetNumaProcessorNodeEx(&number, &result)) {
+        node = result;
+    }
+#elif __linux__
+    unsigned cpu = 0;
+    unsigned at  = 0;
+    if(syscall(SYS_getcpu, &cpu, &at, nullptr) == 0) {
+        node = at;
+    }
+#endif
+
+    return MIN(node, NODES - 1);
+}
+
+void* SlabAllocator::Map(size_t size)
+{
+#if _WIN32 || _WIN64
+    void* address = VirtualAlloc(nullptr, size, MEM_RESERVE | MEM_COMMIT, PAGE_READWRITE);
+    if(address == nullptr) {
+        throw std::bad_alloc();
+    }
+#else
+    void* address = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if(address == MAP_FAILED) {
+        throw std::bad_alloc();
+    }
+#endif
+
+    return address;
+}
+
+void SlabAllocator::Unmap(void* address, size_t size)
+{
+#if _WIN32 || _WIN64
+    VirtualFree(address, 0, MEM_RELEASE);
+    (void)size;
+#else
+    munmap(address, size);
+#endif
+}
@@ -0,0 +1,293 @@
+/**
+ * @file    SlabPool.hpp
+ * @author  LaverWinEmpty@google.com
+ * @brief   fixed size object pool
+ * @version 0.0.1
+ * @date    2026-10-17
+ *
+ * @copyright Copyright (c) 2023
+ *
+ */
+
+#ifndef LWE__SLABPOOL_HPP__
+#define LWE__SLABPOOL_HPP__
+
+#include "atomic"
+#include "vector"
+#include "cstddef"
+#include "utility"
+#include "../../utilities/utilities/LockGuard.hpp"
+#include "../../include/include/includes.hpp"
+
+/**
+ * @brief fixed size block allocator, magazine layer over slabs (Bonwick)
+ * @note  Allocate() / Release(): lock-free, each thread pops / pushes own magazine (MAGAZINE blocks)
+ *        depot: full / empty magazines, locked once per MAGAZINE operations of a thread
+ *        slabs: per NUMA node, mapped untouched, pages are placed by the first touching thread
+ *        steady state: no heap allocation, refer to Stats::GetHeapAllocations()
+ * @warning blocks cached by an exited thread are not reused
+ */
+class SlabAllocator
+{
+public:
+    /**
+     * @brief READONLY: blocks per magazine
+     */
+    static const uint32_t MAGAZINE = 64;
+
+    /**
+     * @brief READONLY: max NUMA nodes, others share the last
+     */
+    static const uint32_t NODES = 8;
+
+    /**
+     * @brief READONLY: default slab size
+     */
+    static const size_t DEF_SLAB_SIZE;
+
+public:
+    /**
+     * @brief counters
+     */
+    struct Stats
+    {
+        uint64_t allocations; // Allocate()
+        uint64_t releases;    // Release()
+        uint64_t exchanges;   // depot access
+        uint64_t slabs;       // slab heap allocation
+        uint64_t magazines;   // magazine heap allocation
+        uint64_t capacity;    // carved blocks
+
+        /**
+         * @brief blocks not released
+         */
+        uint64_t GetInUse() const;
+
+        /**
+         * @brief slabs + magazines, no increase in steady state
+         */
+        uint64_t GetHeapAllocations() const;
+    };
+
+public:
+    /**
+     * @brief Construct a new SlabAllocator object
+     *
+     * @param size     [in] block size
+     * @param align    [in] block alignment, power of 2
+     * @param slabSize [in] bytes per slab, at least one magazine of blocks
+     */
+    SlabAllocator(IN size_t size, IN size_t align = alignof(std::max_align_t), IN size_t slabSize = DEF_SLAB_SIZE);
+
+    /**
+     * @brief Destroy the SlabAllocator object, release all slabs
+     * @warning no Allocate() / Release() after destruction
+     */
+    ~SlabAllocator();
+
+public:
+    DECLARE_NO_COPY(SlabAllocator);
+
+public:
+    /**
+     * @brief get block / lock-free when the thread magazine is not empty
+     * @throw std::bad_alloc
+     *
+     * @return void* uninitialized
+     */
+    void* Allocate();
+
+    /**
+     * @brief return block / lock-free when the thread magazine is not full
+     *
+     * @param block [in] from Allocate() of this allocator, any thread
+     */
+    void Release(IN void* block);
+
+    /**
+     * @brief carve blocks into the depot in advance
+     * @note  pages are touched by the caller, call on the node that uses them
+     *
+     * @param count [in] total capacity to reach
+     */
+    void Reserve(IN size_t count);
+
+    /**
+     * @brief merge counters of all threads
+     *
+     * @return Stats
+     */
+    Stats GetStats() const;
+
+    /**
+     * @brief get block size
+     *
+     * @return size_t aligned
+     */
+    size_t GetSize() const;
+
+private:
+    /**
+     * @brief block stack
+     */
+    struct Magazine
+    {
+        Magazine* next;
+        uint32_t  count;
+        void*     blocks[MAGAZINE];
+    };
+
+    /**
+     * @brief per-thread magazines and counters, written by the owner thread only
+     */
+    struct alignas(CACHE_LINE_SIZE) Cache
+    {
+        Magazine*             loaded;
+        Magazine*             previous;
+        std::atomic<uint64_t> allocations;
+        std::atomic<uint64_t> releases;
+        std::atomic<uint64_t> exchanges;
+    };
+
+    /**
+     * @brief slab being carved
+     */
+    struct Cursor
+    {
+        char* begin;
+        char* end;
+    };
+
+private:
+    /**
+     * @brief get the cache of the calling thread, create if not exist
+     *
+     * @return Cache*
+     */
+    Cache* Local();
+
+    /**
+     * @brief create and register cache
+     *
+     * @param local [in, out] thread cache table, indexed by id
+     * @return Cache*
+     */
+    Cache* Register(IN OUT std::vector<Cache*>& local);
+
+    /**
+     * @brief loaded magazine is empty
+     *
+     * @param cache [in, out]
+     * @return void*
+     */
+    void* AllocateSlow(IN OUT Cache* cache);
+
+    /**
+     * @brief loaded magazine is full
+     *
+     * @param cache [in, out]
+     * @param block [in]
+     */
+    void ReleaseSlow(IN OUT Cache* cache, IN void* block);
+
+    /**
+     * @brief fill magazine from the slab of the calling node, under lock
+     *
+     * @param magazine [out] empty
+     */
+    void Carve(OUT Magazine* magazine);
+
+    /**
+     * @brief get empty magazine, under lock
+     *
+     * @return Magazine*
+     */
+    Magazine* Empty();
+
+    /**
+     * @brief single writer increment
+     */
+    static void Add(IN OUT std::atomic<uint64_t>&, IN uint64_t value);
+
+    /**
+     * @brief NUMA node of the calling thread
+     *
+     * @return uint32_t 0 ~ NODES - 1
+     */
+    static uint32_t Node();
+
+    /**
+     * @brief page allocation, not touched
+     */
+    static void* Map(IN size_t size);
+    static void  Unmap(IN void* address, IN size_t size);
+
+private:
+    size_t   size;
+    size_t   align;
+    size_t   slabSize;
+    uint64_t id; // thread cache key
+
+    // depot
+    Magazine*           fulls;
+    Magazine*           empties;
+    Cursor              cursors[NODES];
+    std::vector<void*>  slabs;
+    std::vector<Cache*> caches;
+    Stats               depot; // slabs, magazines, capacity
+
+    mutable LockGuard::WrappedAdaptive lock;
+};
+
+/**
+ * @brief typed object pool (e.g. SlabPool<IoContext> pool; auto* p = pool.New(session); pool.Delete(p);)
+ *
+ * @tparam T object type
+ */
+template<typename T> class SlabPool
+{
+public:
+    /**
+     * @brief Construct a new SlabPool object
+     *
+     * @param slabSize [in] bytes per slab
+     */
+    SlabPool(IN size_t slabSize = SlabAllocator::DEF_SLAB_SIZE);
+
+public:
+    DECLARE_NO_COPY(SlabPool);
+
+public:
+    /**
+     * @brief allocate and construct
+     * @throw std::bad_alloc, exception of the constructor
+     *
+     * @tparam Args constructor parameter types
+     * @param Args  [in] constructor parameters
+     * @return T*
+     */
+    template<typename... Args> T* New(IN Args&&...);
+
+    /**
+     * @brief destruct and release
+     *
+     * @param T* [in] from New(), nullable
+     */
+    void Delete(IN T*);
+
+    /**
+     * @brief refer to SlabAllocator::Reserve()
+     */
+    void Reserve(IN size_t count);
+
+    /**
+     * @brief refer to SlabAllocator::GetStats()
+     */
+    SlabAllocator::Stats GetStats() const;
+
+private:
+    SlabAllocator allocator;
+};
+
+#include "SlabPool.ipp"
+#endif
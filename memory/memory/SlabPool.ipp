@@ -0,0 +1,89 @@
+inline void SlabAllocator::Add(std::atomic<uint64_t>& counter, uint64_t value)
+{
+    counter.store(counter.load(std::memory_order_relaxed) + value, std::memory_order_relaxed);
+}
+
+inline SlabAllocator::Cache* SlabAllocator::Local()
+{
+    // indexed by allocator id, ids are not reused
+    thread_local std::vector<Cache*> local;
+
+    if(id < local.size() && local[id]) {
+        return local[id];
+    }
+    return Register(local);
+}
+
+inline void* SlabAllocator::Allocate()
+{
+    Cache*    cache    = Local();
+    Magazine* magazine = cache->loaded;
+
+    if(magazine->count == 0) {
+        return AllocateSlow(cache);
+    }
+
+    Add(cache->allocations, 1);
+    return magazine->blocks[--magazine->count];
+}
+
+inline void SlabAllocator::Release(void* block)
+{
+    Cache*    cache    = Local();
+    Magazine* magazine = cache->loaded;
+
+    if(magazine->count == MAGAZINE) {
+        ReleaseSlow(cache, block);
+        return;
+    }
+
+    Add(cache->releases, 1);
+    magazine->blocks[magazine->count++] = block;
+}
+
+inline size_t SlabAllocator::GetSize() const
+{
+    return size;
+}
+
+inline uint64_t SlabAllocator::Stats::GetInUse() const
+{
+    return allocations - releases;
+}
+
+inline uint64_t SlabAllocator::Stats::GetHeapAllocations() const
+{
+    return slabs + magazines;
+}
+
+template<typename T> SlabPool<T>::SlabPool(size_t slabSize): allocator(sizeof(T), alignof(T), slabSize) {}
+
+template<typename T> template<typename... Args> T* SlabPool<T>::New(Args&&... args)
+{
+    void* block = allocator.Allocate();
+    try {
+        return new(block) T(std::forward<Args>(args)...);
+    }
+    catch(...) {
+        allocator.Release(block);
+        throw;
+    }
+}
+
+template<typename T> void SlabPool<T>::Delete(T* object)
+{
+    if(object) {
+        object->~T();
+        allocator.Release(object);
+    }
+}
+
+template<typename T> void SlabPool<T>::Reserve(size_t count)
+{
+    allocator.Reserve(count);
+}
+
+template<typename T> SlabAllocator::Stats SlabPool<T>::GetStats() const
+{
+    return allocator.GetStats();
+}
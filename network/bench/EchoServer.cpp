@@ -0,0 +1,240 @@
+/**
+ * @file    EchoServer.cpp
+ * @author  LaverWinEmpty@google.com
+ * @brief   benchmark, loopback echo server on the completion port
+ * @version 0.0.1
+ * @date    2026-10-18
+ *
+ * @copyright Copyright (c) 2023
+ *
+ * usage: EchoServer [epoll | uring] [connections] [messages] [bytes] [workers]
+ *        server: port workers echo every received chunk (Recv => Send => Recv)
+ *        client: one blocking thread per connection, send a message, wait for the whole echo
+ *
+ * build: g++ -std=c++20 -O2 EchoServer.cpp ../network/CompletionPort.cpp ../network/EpollPort.cpp
+ *            ../network/UringPort.cpp ../../utilities/utilities/Clock.cpp ../../utilities/utilities/Histogram.cpp
+ *            -pthread -o EchoServer
+ */
+
+#include "cstdio"
+#include "cstdlib"
+#include "cstring"
+#include "thread"
+#include "vector"
+#include "unistd.h"
+#include "arpa/inet.h"
+#include "netinet/in.h"
+#include "netinet/tcp.h"
+#include "sys/socket.h"
+#include "../network/CompletionPort.hpp"
+#include "../../utilities/utilities/Clock.hpp"
+#include "../../utilities/utilities/Histogram.hpp"
+
+/**
+ * @brief READONLY: server receive buffer
+ */
+static const size_t CHUNK = 16 << 10;
+
+/**
+ * @brief server side connection, one operation at a time
+ */
+struct Connection: Overlapped
+{
+    Socket target;
+    char   data[CHUNK];
+};
+
+static CompletionPort* port;
+static Socket          listener;
+static Overlapped      acceptor;
+
+/**
+ * @brief close server side connection
+ *
+ * @param connection [in] deleted
+ */
+static void Close(IN Connection* connection)
+{
+    port->Dissociate(connection->target);
+    close(connection->target);
+    delete connection;
+}
+
+/**
+ * @brief port handler: accept, echo
+ */
+static void OnCompletion(IN const Completion& completion, IN void*)
+{
+    if(completion.overlapped == &acceptor) {
+        if(completion.error == ECANCELED) {
+            return;
+        }
+        if(completion.error == 0) {
+            Connection* connection = new Connection();
+            connection->target     = acceptor.socket;
+
+            int on = 1;
+            setsockopt(connection->target, IPPROTO_TCP, TCP_NODELAY, &on, sizeof(on));
+            port->Associate(connection->target, 0);
+
+            connection->buffer = connection->data;
+            connection->length = CHUNK;
+            if(!port->Recv(connection->target, connection)) {
+                Close(connection);
+            }
+        }
+        port->Accept(listener, &acceptor);
+        return;
+    }
+
+    Connection* connection = static_cast<Connection*>(completion.overlapped);
+    if(connection == nullptr || completion.error == ECANCELED) {
+        return;
+    }
+
+    if(completion.error || (connection->operation == Overlapped::RECV && completion.bytes == 0)) {
+        Close(connection);
+        return;
+    }
+
+    bool isIssued = false;
+    if(connection->operation == Overlapped::RECV) {
+        connection->length = completion.bytes;
+        isIssued           = port->Send(connection->target, connection);
+    }
+    else {
+        connection->length = CHUNK;
+        isIssued           = port->Recv(connection->target, connection);
+    }
+    if(!isIssued) {
+        Close(connection);
+    }
+}
+
+/**
+ * @brief client thread: ping-pong
+ *
+ * @param address   [in]
+ * @param messages  [in]
+ * @param bytes     [in]
+ * @param histogram [out] round trip
+ * @return bool false: failed or mismatched echo
+ */
+static bool Client(IN const sockaddr_in& address, IN uint32_t messages, IN size_t bytes, OUT Histogram& histogram)
+{
+    Socket client = socket(AF_INET, SOCK_STREAM, 0);
+    if(connect(client, reinterpret_cast<const sockaddr*>(&address), sizeof(address)) != 0) {
+        close(client);
+        return false;
+    }
+
+    int on = 1;
+    setsockopt(client, IPPROTO_TCP, TCP_NODELAY, &on, sizeof(on));
+
+    std::vector<char> message(bytes);
+    std::vector<char> echo(bytes);
+    bool              result = true;
+
+    for(uint32_t i = 0; i < messages && result; ++i) {
+        std::memset(message.data(), 'a' + i % 26, bytes);
+
+        uint64_t begin = Clock::Ticks();
+        for(size_t sent = 0; sent < bytes;) {
+            ssize_t n = send(client, message.data() + sent, bytes - sent, 0);
+            if(n <= 0) {
+                result = false;
+                break;
+            }
+            sent += n;
+        }
+        for(size_t received = 0; received < bytes && result;) {
+            ssize_t n = recv(client, echo.data() + received, bytes - received, 0);
+            if(n <= 0) {
+                result = false;
+                break;
+            }
+            received += n;
+        }
+        histogram.Record(Clock::ToNS(Clock::Ticks() - begin));
+
+        if(result && std::memcmp(message.data(), echo.data(), bytes) != 0) {
+            result = false;
+        }
+    }
+
+    close(client);
+    return result;
+}
+
+int main(int argc, char* argv[])
+{
+    CompletionPort::EBackend backend = CompletionPort::DEFAULT;
+    if(argc > 1) {
+        backend = std::strcmp(argv[1], "epoll") == 0 ? CompletionPort::EPOLL : CompletionPort::URING;
+    }
+    uint32_t connections = argc > 2 ? static_cast<uint32_t>(std::strtoul(argv[2], nullptr, 10)) : 16;
+    uint32_t messages    = argc > 3 ? static_cast<uint32_t>(std::strtoul(argv[3], nullptr, 10)) : 10000;
+    size_t   bytes       = argc > 4 ? std::strtoul(argv[4], nullptr, 10) : 64;
+    size_t   workers     = argc > 5 ? std::strtoul(argv[5], nullptr, 10) : 0;
+
+    port = CompletionPort::Create(backend);
+    if(port == nullptr) {
+        std::printf("backend not available\n");
+        return 1;
+    }
+
+    listener = socket(AF_INET, SOCK_STREAM, 0);
+    int on   = 1;
+    setsockopt(listener, SOL_SOCKET, SO_REUSEADDR, &on, sizeof(on));
+
+    // ephemeral port
+    sockaddr_in address     = {};
+    address.sin_family      = AF_INET;
+    address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    socklen_t length        = sizeof(address);
+    if(bind(listener, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0 || listen(listener, SOMAXCONN) != 0 ||
+       getsockname(listener, reinterpret_cast<sockaddr*>(&address), &length) != 0) {
+        std::printf("listen failed\n");
+        return 1;
+    }
+
+    port->Associate(listener, 0);
+    port->Accept(listener, &acceptor);
+    port->Start(workers, &OnCompletion);
+
+    Histogram                histogram("round trip");
+    std::atomic<uint32_t>    failed(0);
+    std::vector<std::thread> clients;
+
+    uint64_t begin = Clock::Now();
+    for(uint32_t i = 0; i < connections; ++i) {
+        clients.emplace_back([&]() {
+            if(!Client(address, messages, bytes, histogram)) {
+                failed.fetch_add(1, std::memory_order_relaxed);
+            }
+        });
+    }
+    for(std::thread& client : clients) {
+        client.join();
+    }
+    uint64_t elapsed = Clock::Now() - begin;
+
+    Histogram::Snapshot snapshot = histogram.Collect();
+    double              seconds  = static_cast<double>(elapsed) / 1e9;
+    std::printf("%s: %u connections x %u messages x %zu bytes, failed %u\n",
+                argc > 1 ? argv[1] : "default",
+                connections,
+                messages,
+                bytes,
+                failed.load());
+    std::printf("%.0f messages/s, %.1f MB/s\n",
+                static_cast<double>(snapshot.GetCount()) / seconds,
+                static_cast<double>(snapshot.GetCount() * bytes) / seconds / 1e6);
+    std::printf("%s\n", snapshot.ToString().c_str());
+
+    port->Stop();
+    port->Dissociate(listener);
+    close(listener);
+    delete port;
+    return failed.load() ? 1 : 0;
+}
@@ -0,0 +1,185 @@
+/**
+ * @file    PacketParse.cpp
+ * @author  LaverWinEmpty@google.com
+ * @brief   benchmark, PacketFramer parsing and table dispatch of a received stream
+ * @version 0.0.1
+ * @date    2026-10-18
+ *
+ * @copyright Copyright (c) 2023
+ *
+ * usage: PacketParse [megabytes per run] [repeats]
+ *        stream:   packets of a body size written by the framer, cut into receives (16 KiB, 1460 byte segments)
+ *        next:     Next() / Read() of the first 4 bytes / Pop()
+ *        dispatch: Dispatch() through a PacketTable of 8 ids
+ *        in place: packets whose body is in one chunk (GetData() != nullptr)
+ *
+ * build: g++ -std=c++20 -O2 PacketParse.cpp ../network/Packet.cpp ../../memory/memory/Buffer.cpp
+ *            ../../memory/memory/SlabPool.cpp ../../utilities/utilities/Clock.cpp -pthread -o PacketParse
+ */
+
+#include "cstdio"
+#include "cstdlib"
+#include "cstring"
+#include "vector"
+#include "../network/Packet.hpp"
+#include "../../utilities/utilities/Clock.hpp"
+
+/**
+ * @brief READONLY: ids of the table
+ */
+static const uint16_t IDS = 8;
+
+/**
+ * @brief handler argument
+ */
+struct Sink
+{
+    uint64_t value   = 0;
+    uint64_t inPlace = 0;
+};
+
+/**
+ * @brief read the first word, as a handler would read a fixed layout header
+ */
+template<uint16_t ID> static void OnPacket(IN Sink& sink, IN const Packet& packet)
+{
+    uint32_t word = 0;
+    if(const char* data = packet.GetData()) {
+        std::memcpy(&word, data, MIN(sizeof(word), packet.GetSize()));
+        ++sink.inPlace;
+    }
+    else {
+        packet.Read(&word, sizeof(word));
+    }
+    sink.value += word + ID;
+}
+
+using Table = PacketTable<Sink,
+                          PacketRoute<0, &OnPacket<0>>,
+                          PacketRoute<1, &OnPacket<1>>,
+                          PacketRoute<2, &OnPacket<2>>,
+                          PacketRoute<3, &OnPacket<3>>,
+                          PacketRoute<4, &OnPacket<4>>,
+                          PacketRoute<5, &OnPacket<5>>,
+                          PacketRoute<6, &OnPacket<6>>,
+                          PacketRoute<7, &OnPacket<7>>>;
+
+/**
+ * @brief encoded stream cut into receive buffers, built before timing
+ *
+ * @param prefix  [in]
+ * @param body    [in] body size
+ * @param bytes   [in] approximate stream size
+ * @param receive [in] bytes per receive
+ * @param count   [out] packets
+ * @return std::vector<BufferRef>
+ */
+static std::vector<BufferRef> Build(IN PacketFramer::EPrefix prefix, IN size_t body, IN size_t bytes, IN size_t receive,
+                                    OUT size_t& count)
+{
+    PacketFramer      framer(prefix);
+    BufferChain       wire;
+    std::vector<char> data(body);
+
+    count = 0;
+    while(wire.GetSize() < bytes) {
+        std::memset(data.data(), static_cast<int>(count), body);
+        framer.Write(wire, static_cast<uint16_t>(count % IDS), data.data(), body);
+        ++count;
+    }
+
+    std::vector<BufferRef> receives;
+    for(size_t offset = 0; offset < wire.GetSize(); offset += receive) {
+        size_t    size = MIN(receive, wire.GetSize() - offset);
+        BufferRef ref(size);
+        wire.Read(ref.GetData(), size, offset);
+        ref.Truncate(size);
+        receives.push_back(std::move(ref));
+    }
+    return receives;
+}
+
+/**
+ * @brief parse the stream, append as received
+ *
+ * @param receives   [in] shared, not consumed
+ * @param isDispatch [in] false: Next() / Pop()
+ * @param sink       [out]
+ * @return size_t parsed packets
+ */
+static size_t Parse(IN const std::vector<BufferRef>& receives, IN PacketFramer::EPrefix prefix, IN bool isDispatch,
+                    OUT Sink& sink)
+{
+    PacketFramer framer(prefix);
+    size_t       count = 0;
+
+    for(const BufferRef& ref : receives) {
+        framer.Append(ref);
+
+        if(isDispatch) {
+            count += framer.Dispatch<Table>(sink);
+            continue;
+        }
+
+        Packet packet;
+        while(framer.Next(packet)) {
+            OnPacket<0>(sink, packet);
+            framer.Pop();
+            ++count;
+        }
+    }
+
+    if(framer.IsBroken() || framer.GetSize()) {
+        std::printf("broken: error %d, left %zu\n", framer.GetError(), framer.GetSize());
+        std::exit(1);
+    }
+    return count;
+}
+
+/**
+ * @brief best of repeats
+ */
+static void Run(IN const char* name, IN PacketFramer::EPrefix prefix, IN size_t body, IN size_t receive, IN size_t bytes,
+                IN uint32_t repeats)
+{
+    size_t                 count    = 0;
+    std::vector<BufferRef> receives = Build(prefix, body, bytes, receive, count);
+
+    std::printf("%-6s body %5zu recv %5zu", name, body, receive);
+    for(bool isDispatch : { false, true }) {
+        uint64_t best = UINT64_MAX;
+        Sink     sink;
+
+        for(uint32_t i = 0; i < repeats; ++i) {
+            sink          = Sink();
+            uint64_t from = Clock::Now();
+            if(Parse(receives, prefix, isDispatch, sink) != count) {
+                std::printf("\nlost packets\n");
+                std::exit(1);
+            }
+            best = MIN(best, Clock::Now() - from);
+        }
+
+        double seconds = static_cast<double>(best) / 1e9;
+        std::printf("\t%s %7.2f Mpkt/s %7.0f MB/s in place %5.1f%%",
+                    isDispatch ? "dispatch" : "next",
+                    static_cast<double>(count) / seconds / 1e6,
+                    static_cast<double>(count * body) / seconds / 1e6,
+                    100.0 * static_cast<double>(sink.inPlace) / static_cast<double>(count));
+    }
+    std::printf("\n");
+}
+
+int main(int argc, char* argv[])
+{
+    size_t   bytes   = (argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 64) << 20;
+    uint32_t repeats = argc > 2 ? static_cast<uint32_t>(std::strtoul(argv[2], nullptr, 10)) : 5;
+
+    for(size_t receive : { static_cast<size_t>(16 << 10), static_cast<size_t>(1460) }) {
+        for(size_t body : { 16, 256, 4096 }) {
+            Run("fixed", PacketFramer::FIXED, body, receive, bytes, repeats);
+            Run("varint", PacketFramer::VARINT, body, receive, bytes, repeats);
+        }
+    }
+    return 0;
+}
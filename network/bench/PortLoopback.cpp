@@ -0,0 +1,331 @@
+/**
+ * @file    PortLoopback.cpp
+ * @author  LaverWinEmpty@google.com
+ * @brief   benchmark, loopback throughput / latency of EpollPort against UringPort
+ * @version 0.0.1
+ * @date    2026-10-18
+ *
+ * @copyright Copyright (c) 2023
+ *
+ * usage: PortLoopback [connections] [megabytes per connection] [round trips] [workers]
+ *        latency:    one connection, 64 byte ping-pong, round trip percentiles
+ *        throughput: client threads stream 16 KiB writes, a reader per connection drains the echo
+ *        backends:   epoll, uring, uring + registered buffers, uring + SQPOLL
+ *
+ * build: g++ -std=c++20 -O2 PortLoopback.cpp ../network/CompletionPort.cpp ../network/EpollPort.cpp
+ *            ../network/UringPort.cpp ../../utilities/utilities/Clock.cpp ../../utilities/utilities/Histogram.cpp
+ *            -pthread -o PortLoopback
+ */
+
+#include "cstdio"
+#include "cstdlib"
+#include "cstring"
+#include "thread"
+#include "vector"
+#include "unistd.h"
+#include "arpa/inet.h"
+#include "netinet/in.h"
+#include "netinet/tcp.h"
+#include "sys/socket.h"
+#include "../network/EpollPort.hpp"
+#include "../network/UringPort.hpp"
+#include "../../utilities/utilities/Clock.hpp"
+#include "../../utilities/utilities/Histogram.hpp"
+
+/**
+ * @brief READONLY: receive buffer per server connection
+ */
+static const size_t CHUNK = 16 << 10;
+
+/**
+ * @brief READONLY: server connections of a run
+ */
+static const size_t SLOTS = 256;
+
+/**
+ * @brief server side connection, buffer in the slab
+ */
+struct Connection: Overlapped
+{
+    Socket target;
+    char*  data;
+};
+
+/**
+ * @brief echo server on a port, receive buffers in one slab (registered by the uring + fixed variant)
+ */
+class Server
+{
+public:
+    Server(IN CompletionPort* port): port(port), slab(SLOTS * CHUNK), used(0)
+    {
+        listener = socket(AF_INET, SOCK_STREAM, 0);
+        int on   = 1;
+        setsockopt(listener, SOL_SOCKET, SO_REUSEADDR, &on, sizeof(on));
+
+        // ephemeral port
+        address                 = {};
+        address.sin_family      = AF_INET;
+        address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        socklen_t length        = sizeof(address);
+        bind(listener, reinterpret_cast<sockaddr*>(&address), sizeof(address));
+        listen(listener, SOMAXCONN);
+        getsockname(listener, reinterpret_cast<sockaddr*>(&address), &length);
+
+        port->Associate(listener, 0);
+        port->Accept(listener, &acceptor);
+    }
+
+    ~Server()
+    {
+        port->Stop();
+        port->Dissociate(listener);
+        close(listener);
+        for(Connection* connection : connections) {
+            port->Dissociate(connection->target);
+            close(connection->target);
+            delete connection;
+        }
+    }
+
+public:
+    /**
+     * @brief port handler: accept, echo
+     */
+    static void Handler(IN const Completion& completion, IN void* context)
+    {
+        Server* server = static_cast<Server*>(context);
+
+        if(completion.error == ECANCELED || completion.overlapped == nullptr) {
+            return;
+        }
+        if(completion.overlapped == &server->acceptor) {
+            server->OnAccept(completion);
+            return;
+        }
+
+        // closed connections stay in the list until the server is destroyed
+        Connection* connection = static_cast<Connection*>(completion.overlapped);
+        if(completion.error || (connection->operation == Overlapped::RECV && completion.bytes == 0)) {
+            return;
+        }
+
+        if(connection->operation == Overlapped::RECV) {
+            connection->length = completion.bytes;
+            server->port->Send(connection->target, connection);
+        }
+        else {
+            connection->length = CHUNK;
+            server->port->Recv(connection->target, connection);
+        }
+    }
+
+    const sockaddr_in& GetAddress() const { return address; }
+
+    std::vector<char>& GetSlab() { return slab; }
+
+private:
+    void OnAccept(IN const Completion& completion)
+    {
+        if(completion.error == 0 && used < SLOTS) {
+            Connection* connection = new Connection();
+            connection->target     = acceptor.socket;
+            connection->data       = slab.data() + used++ * CHUNK;
+            connections.push_back(connection);
+
+            int on = 1;
+            setsockopt(connection->target, IPPROTO_TCP, TCP_NODELAY, &on, sizeof(on));
+            port->Associate(connection->target, 0);
+
+            connection->buffer = connection->data;
+            connection->length = CHUNK;
+            port->Recv(connection->target, connection);
+        }
+        else if(completion.error == 0) {
+            close(acceptor.socket);
+        }
+        port->Accept(listener, &acceptor);
+    }
+
+private:
+    CompletionPort*          port;
+    Socket                   listener;
+    sockaddr_in              address;
+    Overlapped               acceptor;
+    std::vector<char>        slab;
+    size_t                   used; // accepted by one worker at a time: one Accept() in flight
+    std::vector<Connection*> connections;
+};
+
+/**
+ * @brief connect with TCP_NODELAY
+ *
+ * @return Socket -1: failed
+ */
+static Socket Connect(IN const sockaddr_in& address)
+{
+    Socket client = socket(AF_INET, SOCK_STREAM, 0);
+    if(connect(client, reinterpret_cast<const sockaddr*>(&address), sizeof(address)) != 0) {
+        close(client);
+        return -1;
+    }
+    int on = 1;
+    setsockopt(client, IPPROTO_TCP, TCP_NODELAY, &on, sizeof(on));
+    return client;
+}
+
+/**
+ * @brief one connection ping-pong
+ *
+ * @return Histogram::Snapshot round trip
+ */
+static Histogram::Snapshot Latency(IN const sockaddr_in& address, IN uint32_t trips)
+{
+    Histogram histogram;
+    Socket    client = Connect(address);
+    char      message[64];
+    char      echo[64];
+
+    std::memset(message, 'x', sizeof(message));
+    for(uint32_t i = 0; i < trips && client >= 0; ++i) {
+        uint64_t begin = Clock::Ticks();
+        if(send(client, message, sizeof(message), 0) != sizeof(message)) {
+            break;
+        }
+        size_t received = 0;
+        while(received < sizeof(echo)) {
+            ssize_t n = recv(client, echo + received, sizeof(echo) - received, 0);
+            if(n <= 0) {
+                break;
+            }
+            received += n;
+        }
+        histogram.Record(Clock::ToNS(Clock::Ticks() - begin));
+    }
+    if(client >= 0) {
+        close(client);
+    }
+    return histogram.Collect();
+}
+
+/**
+ * @brief streaming connections, echo drained by a reader thread each
+ *
+ * @return double MB/s of echoed bytes
+ */
+static double Throughput(IN const sockaddr_in& address, IN uint32_t connections, IN size_t bytes)
+{
+    std::vector<std::thread> threads;
+    std::atomic<uint64_t>    echoed(0);
+
+    uint64_t begin = Clock::Now();
+    for(uint32_t i = 0; i < connections; ++i) {
+        Socket client = Connect(address);
+        if(client < 0) {
+            continue;
+        }
+        threads.emplace_back([client, bytes]() {
+            std::vector<char> block(CHUNK, 'y');
+            for(size_t sent = 0; sent < bytes;) {
+                ssize_t n = send(client, block.data(), MIN(block.size(), bytes - sent), 0);
+                if(n <= 0) {
+                    break;
+                }
+                sent += n;
+            }
+        });
+        threads.emplace_back([client, bytes, &echoed]() {
+            std::vector<char> block(CHUNK);
+            size_t            received = 0;
+            while(received < bytes) {
+                ssize_t n = recv(client, block.data(), block.size(), 0);
+                if(n <= 0) {
+                    break;
+                }
+                received += n;
+            }
+            echoed.fetch_add(received, std::memory_order_relaxed);
+            close(client);
+        });
+    }
+    for(std::thread& thread : threads) {
+        thread.join();
+    }
+    uint64_t elapsed = Clock::Now() - begin;
+
+    return static_cast<double>(echoed.load()) / (static_cast<double>(elapsed) / 1e9) / 1e6;
+}
+
+/**
+ * @brief run both tests on a port
+ *
+ * @param name  [in]
+ * @param port  [in] deleted
+ * @param isFixed [in] register the slab
+ */
+static void Run(IN const char* name, IN CompletionPort* port, IN uint32_t connections, IN size_t bytes, IN uint32_t trips,
+                IN size_t workers, IN bool isFixed = false)
+{
+    if(port == nullptr) {
+        std::printf("%-14s not available\n", name);
+        return;
+    }
+
+    {
+        Server server(port);
+        if(isFixed) {
+            iovec region = { server.GetSlab().data(), server.GetSlab().size() };
+            if(!static_cast<UringPort*>(port)->RegisterBuffers(&region, 1)) {
+                std::printf("%-14s register failed (RLIMIT_MEMLOCK?)\n", name);
+            }
+        }
+        port->Start(workers, &Server::Handler, &server);
+
+        Histogram::Snapshot latency    = Latency(server.GetAddress(), trips);
+        double              throughput = Throughput(server.GetAddress(), connections, bytes);
+
+        std::printf("%-14s %9.1f MB/s\tp50 %6.1f us\tp99 %6.1f us\tp99.9 %6.1f us\n",
+                    name,
+                    throughput,
+                    static_cast<double>(latency.Percentile(50)) / 1e3,
+                    static_cast<double>(latency.Percentile(99)) / 1e3,
+                    static_cast<double>(latency.Percentile(99.9)) / 1e3);
+    }
+    delete port;
+}
+
+/**
+ * @brief create io_uring port
+ *
+ * @return UringPort* nullptr: unavailable
+ */
+static UringPort* CreateUring(IN bool isPolling)
+{
+    try {
+        return new UringPort(UringPort::DEF_ENTRIES, isPolling);
+    }
+    catch(...) {
+        return nullptr;
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    uint32_t connections = argc > 1 ? static_cast<uint32_t>(std::strtoul(argv[1], nullptr, 10)) : 8;
+    size_t   bytes       = (argc > 2 ? std::strtoul(argv[2], nullptr, 10) : 64) << 20;
+    uint32_t trips       = argc > 3 ? static_cast<uint32_t>(std::strtoul(argv[3], nullptr, 10)) : 20000;
+    size_t   workers     = argc > 4 ? std::strtoul(argv[4], nullptr, 10) : 0;
+
+    connections = MIN(connections, static_cast<uint32_t>(SLOTS - 1));
+
+    Run("epoll", new EpollPort(), connections, bytes, trips, workers);
+    Run("uring", CreateUring(false), connections, bytes, trips, workers);
+    Run("uring fixed", CreateUring(false), connections, bytes, trips, workers, true);
+
+    UringPort* polling = CreateUring(true);
+    if(polling && !polling->IsPolling()) {
+        std::printf("uring sqpoll   not permitted, runs without SQPOLL\n");
+    }
+    Run("uring sqpoll", polling, connections, bytes, trips, workers);
+    return 0;
+}
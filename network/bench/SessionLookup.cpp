@@ -0,0 +1,271 @@
+/**
+ * @file    SessionLookup.cpp
+ * @author  LaverWinEmpty@google.com
+ * @brief   benchmark, SessionTable with 1M concurrent simulated sessions against a map under TypeLock
+ * @version 0.0.1
+ * @date    2026-10-18
+ *
+ * @copyright Copyright (c) 2023
+ *
+ * usage: SessionLookup [sessions] [max threads] [milliseconds per run]
+ *        insert: sessions inserted by all threads, Minsert/s
+ *        lookup: Find() of a random live handle per simulated completion, Mlookup/s
+ *        churn:  lookups while 1 / 16 of the operations disconnect and reconnect a session,
+ *                stale handles of disconnected sessions must not be found
+ *        remove: all sessions removed by all threads
+ *        table: SessionTable<Simulated>, map: std::unordered_map under TypeLock<Simulated>::Mutex
+ *
+ * build: g++ -std=c++20 -O2 SessionLookup.cpp -pthread -o SessionLookup
+ */
+
+#include "cstdio"
+#include "cstdlib"
+#include "thread"
+#include "vector"
+#include "atomic"
+#include "chrono"
+#include "random"
+#include "unordered_map"
+#include "../network/SessionTable.hpp"
+
+/**
+ * @brief session state touched by a completion
+ */
+struct Simulated
+{
+    Simulated(IN uint64_t id): id(id), received(0) {}
+
+    uint64_t              id;
+    std::atomic<uint64_t> received;
+    char                  state[48];
+};
+
+/**
+ * @brief shared state of a run, one handle slot per simulated connection
+ */
+struct Connections
+{
+    Connections(IN size_t count): handles(count), stale(0) {}
+
+    std::vector<std::atomic<uint64_t>> handles;
+    std::atomic<uint64_t>              stale; // found by a handle of a disconnected session
+};
+
+/**
+ * @brief SessionTable adapter
+ */
+class Table
+{
+public:
+    Table(IN size_t capacity): table(capacity) {}
+
+    uint64_t Insert(IN uint64_t id) { return table.Insert(id); }
+
+    bool Remove(IN uint64_t handle) { return table.Remove(handle); }
+
+    bool Touch(IN uint64_t handle)
+    {
+        SessionTable<Simulated>::Ref ref = table.Find(handle);
+        if(!ref) {
+            return false;
+        }
+        ref->received.fetch_add(1, std::memory_order_relaxed);
+        return true;
+    }
+
+private:
+    SessionTable<Simulated> table;
+};
+
+/**
+ * @brief global map adapter, the only shared state tool before SessionTable
+ */
+class Map
+{
+public:
+    Map(IN size_t capacity): next(1) { map.reserve(capacity); }
+
+    ~Map()
+    {
+        for(auto& iter : map) {
+            delete iter.second;
+        }
+    }
+
+    uint64_t Insert(IN uint64_t id)
+    {
+        Simulated* session = new Simulated(id);
+
+        TypeLock<Simulated>::Mutex lock;
+        uint64_t                   handle = next++;
+        map.emplace(handle, session);
+        return handle;
+    }
+
+    bool Remove(IN uint64_t handle)
+    {
+        Simulated* session = nullptr;
+        {
+            TypeLock<Simulated>::Mutex lock;
+            auto                       iter = map.find(handle);
+            if(iter == map.end()) {
+                return false;
+            }
+            session = iter->second;
+            map.erase(iter);
+        }
+        delete session;
+        return true;
+    }
+
+    // held while touching: no reference count to keep the session alive
+    bool Touch(IN uint64_t handle)
+    {
+        TypeLock<Simulated>::Mutex lock;
+        auto                       iter = map.find(handle);
+        if(iter == map.end()) {
+            return false;
+        }
+        iter->second->received.fetch_add(1, std::memory_order_relaxed);
+        return true;
+    }
+
+private:
+    std::unordered_map<uint64_t, Simulated*> map;
+    uint64_t                                 next;
+};
+
+/**
+ * @brief run function on threads, each over its range of connections
+ *
+ * @return double seconds
+ */
+template<typename Function> static double Parallel(IN uint32_t threads, IN size_t count, IN Function&& function)
+{
+    std::vector<std::thread> workers;
+
+    auto begin = std::chrono::steady_clock::now();
+    for(uint32_t t = 0; t < threads; ++t) {
+        workers.emplace_back([&, t]() { function(t, count * t / threads, count * (t + 1) / threads); });
+    }
+    for(std::thread& worker : workers) {
+        worker.join();
+    }
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count();
+}
+
+/**
+ * @brief lookups of random connections for the duration
+ *
+ * @param churn [in] 1 / churn of the operations reconnect, 0: none
+ * @return double operations per microsecond
+ */
+template<typename R> static double Lookup(IN R& registry, IN Connections& connections, IN uint32_t threads,
+                                          IN std::chrono::milliseconds duration, IN uint32_t churn)
+{
+    std::atomic<bool>     isRunning(true);
+    std::atomic<uint64_t> total(0);
+    std::thread           timer([&]() {
+        std::this_thread::sleep_for(duration);
+        isRunning.store(false, std::memory_order_relaxed);
+    });
+
+    size_t count   = connections.handles.size();
+    double seconds = Parallel(threads, count, [&](uint32_t t, size_t, size_t) {
+        std::mt19937_64 random(t + 1);
+        uint64_t        operations = 0;
+
+        while(isRunning.load(std::memory_order_relaxed)) {
+            for(uint32_t i = 0; i < 256; ++i, ++operations) {
+                std::atomic<uint64_t>& slot   = connections.handles[random() % count];
+                uint64_t               handle = slot.load(std::memory_order_acquire);
+
+                if(churn && operations % churn == 0) {
+                    // disconnect: one thread wins the slot, its old handle must stay dead
+                    if(handle == 0 || !slot.compare_exchange_strong(handle, 0, std::memory_order_acq_rel)) {
+                        continue;
+                    }
+                    registry.Remove(handle);
+                    if(registry.Touch(handle)) {
+                        connections.stale.fetch_add(1, std::memory_order_relaxed);
+                    }
+                    slot.store(registry.Insert(handle), std::memory_order_release);
+                    continue;
+                }
+                if(handle) {
+                    registry.Touch(handle);
+                }
+            }
+        }
+        total.fetch_add(operations, std::memory_order_relaxed);
+    });
+    timer.join();
+
+    return static_cast<double>(total.load()) / (seconds * 1e6);
+}
+
+/**
+ * @brief all phases on a registry
+ */
+template<typename R> static void Run(IN const char* name, IN size_t sessions, IN uint32_t threads,
+                                     IN std::chrono::milliseconds duration)
+{
+    R           registry(sessions);
+    Connections connections(sessions);
+
+    double insert = Parallel(threads, sessions, [&](uint32_t, size_t begin, size_t end) {
+        for(size_t i = begin; i < end; ++i) {
+            connections.handles[i].store(registry.Insert(i), std::memory_order_relaxed);
+        }
+    });
+    for(std::atomic<uint64_t>& handle : connections.handles) {
+        if(handle.load() == 0) {
+            std::printf("insert failed: full\n");
+            std::exit(1);
+        }
+    }
+
+    double lookup = Lookup(registry, connections, threads, duration, 0);
+    double churn  = Lookup(registry, connections, threads, duration, 16);
+
+    std::atomic<uint64_t> failed(0);
+    double                remove = Parallel(threads, sessions, [&](uint32_t, size_t begin, size_t end) {
+        for(size_t i = begin; i < end; ++i) {
+            uint64_t handle = connections.handles[i].exchange(0);
+            if(handle && !registry.Remove(handle)) {
+                failed.fetch_add(1, std::memory_order_relaxed);
+            }
+        }
+    });
+
+    std::printf("%-6s threads %3u\tinsert %6.2f M/s\tlookup %7.2f /us\tchurn %7.2f /us\tremove %6.2f M/s\n",
+                name,
+                threads,
+                static_cast<double>(sessions) / insert / 1e6,
+                lookup,
+                churn,
+                static_cast<double>(sessions) / remove / 1e6);
+
+    if(connections.stale.load() || failed.load()) {
+        std::printf("broken: %llu stale handles found, %llu removes failed\n",
+                    static_cast<unsigned long long>(connections.stale.load()),
+                    static_cast<unsigned long long>(failed.load()));
+        std::exit(1);
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    size_t   sessions = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 1 << 20;
+    uint32_t cores    = MAX(std::thread::hardware_concurrency(), 1u);
+    uint32_t maximum  = argc > 2 ? static_cast<uint32_t>(std::strtoul(argv[2], nullptr, 10)) : cores;
+    auto     duration = std::chrono::milliseconds(argc > 3 ? std::strtoul(argv[3], nullptr, 10) : 500);
+
+    std::printf("%zu sessions, %zu bytes each\n", sessions, sizeof(Simulated));
+    for(uint32_t threads = 1; threads <= maximum; threads *= 2) {
+        Run<Table>("table", sessions, threads, duration);
+        Run<Map>("map", sessions, threads, duration);
+        std::fflush(stdout);
+    }
+    return 0;
+}
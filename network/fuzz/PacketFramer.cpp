@@ -0,0 +1,204 @@
+/**
+ * @file    PacketFramer.cpp
+ * @author  LaverWinEmpty@google.com
+ * @brief   fuzz target, PacketFramer parsing of arbitrary receive streams
+ * @version 0.0.1
+ * @date    2026-10-18
+ *
+ * @copyright Copyright (c) 2023
+ *
+ * input: [options][chunk][stream...]
+ *        options: bit 0 prefix (FIXED / VARINT), bit 1 ~ 3 max size (16 << n), bit 4 read back in one chunk,
+ *                 bit 5 receive between Next() and Pop()
+ *        chunk:   receive size 1 ~ 256, the stream is appended in pieces of it
+ * checks: packet size within the limit, Read() / Contiguous() / Slice() / GetData() agree,
+ *         Next() repeats until Pop(), consumed + buffered == appended, broken stays broken,
+ *         a receive between Next() and Pop() keeps the parsed packet,
+ *         every packet survives Write() => Next() of a fresh framer
+ *
+ * build: clang++ -std=c++20 -g -O1 -fsanitize=fuzzer,address,undefined PacketFramer.cpp ../network/Packet.cpp
+ *            ../../memory/memory/Buffer.cpp ../../memory/memory/SlabPool.cpp -o PacketFramerFuzz
+ *        replay without libFuzzer: g++ -std=c++20 -g -O1 -fsanitize=address -DSTANDALONE ... (same sources)
+ *            PacketFramerFuzz [crash or corpus files], none: random inputs
+ */
+
+#include "cstdio"
+#include "cstdlib"
+#include "cstring"
+#include "vector"
+#include "../network/Packet.hpp"
+
+/**
+ * @brief abort on broken invariant, the fuzzer keeps the input
+ */
+static void Check(IN bool condition, IN const char* message)
+{
+    if(!condition) {
+        std::fprintf(stderr, "PacketFramer: %s\n", message);
+        std::abort();
+    }
+}
+
+/**
+ * @brief copy bytes into a receive buffer
+ */
+static BufferRef Receive(IN const uint8_t* data, IN size_t size)
+{
+    BufferRef ref(size);
+    std::memcpy(ref.GetData(), data, size);
+    ref.Truncate(size);
+    return ref;
+}
+
+/**
+ * @brief every accessor of the body returns the same bytes
+ *
+ * @param packet [in]
+ * @param body   [out] body bytes
+ */
+static void Verify(IN const Packet& packet, OUT std::vector<char>& body)
+{
+    body.resize(packet.GetSize());
+    Check(packet.Read(body.data(), body.size()) == body.size(), "short Read()");
+
+    BufferRef contiguous = packet.Contiguous();
+    Check(contiguous.GetSize() == body.size(), "Contiguous() size");
+    Check(body.empty() || std::memcmp(contiguous.GetData(), body.data(), body.size()) == 0, "Contiguous() bytes");
+
+    BufferChain       slice = packet.Slice();
+    std::vector<char> copy(slice.GetSize());
+    Check(copy.size() == body.size(), "Slice() size");
+    Check(slice.Read(copy.data(), copy.size()) == copy.size() && copy == body, "Slice() bytes");
+
+    if(packet.GetData()) {
+        Check(body.empty() || std::memcmp(packet.GetData(), body.data(), body.size()) == 0, "GetData() bytes");
+    }
+}
+
+/**
+ * @brief encode the packet again and parse it with a fresh framer
+ */
+static void RoundTrip(IN PacketFramer::EPrefix prefix, IN size_t maxSize, IN const Packet& packet,
+                      IN const std::vector<char>& body, IN bool isWhole)
+{
+    PacketFramer writer(prefix, maxSize);
+    BufferChain  wire;
+    writer.Write(wire, packet.GetId(), body.data(), body.size());
+
+    // one receive, or a byte per receive for the partial header / body paths
+    PacketFramer reader(prefix, maxSize);
+    Packet       parsed;
+    for(size_t i = 0; i < wire.GetCount(); ++i) {
+        const BufferRef& ref = wire[i];
+        for(size_t offset = 0; offset < ref.GetSize(); offset += isWhole ? ref.GetSize() : 1) {
+            Check(!reader.Next(parsed), "complete before the last byte");
+            reader.Append(ref.Slice(offset, isWhole ? ref.GetSize() : 1));
+        }
+    }
+
+    std::vector<char> copy;
+    Check(reader.Next(parsed), "written packet not parsed");
+    Check(parsed.GetId() == packet.GetId(), "round trip id");
+    Verify(parsed, copy);
+    Check(copy == body, "round trip body");
+
+    reader.Pop();
+    Check(reader.GetSize() == 0 && !reader.IsBroken(), "round trip left bytes");
+}
+
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t* data, size_t size)
+{
+    if(size < 2) {
+        return 0;
+    }
+
+    PacketFramer::EPrefix prefix        = (data[0] & 1) ? PacketFramer::VARINT : PacketFramer::FIXED;
+    size_t                maxSize       = static_cast<size_t>(16) << ((data[0] >> 1) & 7);
+    bool                  isWhole       = (data[0] >> 4) & 1;
+    bool                  isInterleaved = (data[0] >> 5) & 1;
+    size_t                chunk         = static_cast<size_t>(data[1]) + 1;
+
+    data += 2;
+    size -= 2;
+
+    PacketFramer      framer(prefix, maxSize);
+    std::vector<char> body;
+    size_t            appended = 0;
+    size_t            consumed = 0;
+
+    while(appended < size && !framer.IsBroken()) {
+        size_t piece = MIN(chunk, size - appended);
+        framer.Append(Receive(data + appended, piece));
+        appended += piece;
+
+        Packet packet;
+        while(framer.Next(packet)) {
+            Check(packet.GetSize() <= maxSize, "body over max size");
+
+            Packet again;
+            Check(framer.Next(again), "Next() not repeatable");
+            Check(again.GetId() == packet.GetId() && again.GetSize() == packet.GetSize(), "Next() changed");
+
+            Verify(packet, body);
+            RoundTrip(prefix, maxSize, packet, body, isWhole);
+
+            // e.g. completion of the next recv handled before the packet
+            if(isInterleaved && appended < size) {
+                piece = MIN(chunk, size - appended);
+                framer.Append(Receive(data + appended, piece));
+                appended += piece;
+            }
+
+            // header and body, nothing of the next frame
+            size_t before = framer.GetSize();
+            framer.Pop();
+            size_t popped = before - framer.GetSize();
+            Check(popped > packet.GetSize() && popped <= packet.GetSize() + PacketFramer::MAX_HEADER, "Pop() size");
+            consumed += popped;
+        }
+
+        if(framer.IsBroken()) {
+            // discarded: not recoverable
+            Check(framer.GetError() != 0, "broken without error");
+            Check(framer.GetSize() == 0 && !framer.Next(packet), "parsed after broken");
+        }
+        else {
+            Check(consumed + framer.GetSize() == appended, "bytes lost");
+        }
+    }
+    return 0;
+}
+
+#ifdef STANDALONE
+/**
+ * @brief replay files, or random inputs without arguments
+ */
+int main(int argc, char* argv[])
+{
+    std::vector<uint8_t> input;
+
+    for(int i = 1; i < argc; ++i) {
+        FILE* file = std::fopen(argv[i], "rb");
+        if(file == nullptr) {
+            std::fprintf(stderr, "cannot open %s\n", argv[i]);
+            return 1;
+        }
+        input.clear();
+        for(int c; (c = std::fgetc(file)) != EOF;) {
+            input.push_back(static_cast<uint8_t>(c));
+        }
+        std::fclose(file);
+        LLVMFuzzerTestOneInput(input.data(), input.size());
+    }
+
+    // random: mostly small headers so that frames complete
+    for(uint32_t run = 0; argc == 1 && run < 100000; ++run) {
+        input.resize(2 + std::rand() % 512);
+        for(uint8_t& byte : input) {
+            byte = static_cast<uint8_t>(std::rand() % 4 ? std::rand() % 24 : std::rand());
+        }
+        LLVMFuzzerTestOneInput(input.data(), input.size());
+    }
+    return 0;
+}
+#endif
@@ -0,0 +1,141 @@
+#include "CompletionPort.hpp"
+#include "climits"
+
+#if __linux__
+#    include "EpollPort.hpp"
+#    include "UringPort.hpp"
+#endif
+
+const int      CompletionPort::INFINITE_WAIT = -1;
+const uint64_t CompletionPort::STOP_KEY      = UINT64_MAX;
+
+CompletionPort* CompletionPort::Create(EBackend backend)
+{
+#if __linux__
+    if(backend != EPOLL) {
+        try {
+            return new UringPort();
+        }
+        catch(...) {
+            if(backend == URING) {
+                return nullptr;
+            }
+        }
+    }
+
+    // io_uring unavailable (e.g. old kernel, disabled by sysctl or seccomp)
+    try {
+        return new EpollPort();
+    }
+    catch(...) {
+        return nullptr;
+    }
+#else
+    // windows: use native IOCP directly
+    return nullptr;
+#endif
+}
+
+CompletionPort::CompletionPort(): isRunning(false) {}
+
+CompletionPort::~CompletionPort()
+{
+    Stop();
+}
+
+bool CompletionPort::Start(size_t threads, Handler handler, void* context)
+{
+    bool expected = false;
+    if(!isRunning.compare_exchange_strong(expected, true)) {
+        return false;
+    }
+
+    if(threads == 0) {
+        threads = MAX(std::thread::hardware_concurrency(), 1u);
+    }
+
+    workers.reserve(threads);
+    for(size_t i = 0; i < threads; ++i) {
+        workers.emplace_back(&CompletionPort::Work, this, handler, context);
+    }
+    return true;
+}
+
+void CompletionPort::Stop()
+{
+    bool expected = true;
+    if(!isRunning.compare_exchange_strong(expected, false)) {
+        return;
+    }
+
+    // each worker consumes one
+    for(size_t i = 0; i < workers.size(); ++i) {
+        Post(STOP_KEY);
+    }
+
+    for(std::thread& worker : workers) {
+        worker.join();
+    }
+    workers.clear();
+}
+
+bool CompletionPort::IsRunning() const
+{
+    return isRunning.load(std::memory_order_acquire);
+}
+
+void CompletionPort::Work(Handler handler, void* context)
+{
+    Completion completion;
+    while(true) {
+        if(!Dequeue(completion, INFINITE_WAIT)) {
+            continue;
+        }
+
+        if(completion.key == STOP_KEY && completion.overlapped == nullptr && !IsRunning()) {
+            break;
+        }
+        handler(completion, context);
+    }
+}
+
+void CompletionPort::Advance(Overlapped* overlapped, size_t bytes)
+{
+    while(bytes && overlapped->count) {
+        iovec& front = overlapped->vectors[0];
+        if(bytes < front.iov_len) {
+            front.iov_base = static_cast<char*>(front.iov_base) + bytes;
+            front.iov_len -= bytes;
+            return;
+        }
+
+        bytes -= front.iov_len;
+        ++overlapped->vectors;
+        --overlapped->count;
+    }
+}
+
+void CompletionPort::Pending::Push(Overlapped* overlapped)
+{
+    overlapped->next = nullptr;
+    if(tail) {
+        tail->next = overlapped;
+    }
+    else {
+        head = overlapped;
+    }
+    tail = overlapped;
+}
+
+Overlapped* CompletionPort::Pending::Pop()
+{
+    Overlapped* front = head;
+    if(front) {
+        head = front->next;
+        if(head == nullptr) {
+            tail = nullptr;
+        }
+        front->next = nullptr;
+    }
+    return front;
+}
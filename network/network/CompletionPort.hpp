@@ -0,0 +1,253 @@
+/**
+ * @file    CompletionPort.hpp
+ * @author  LaverWinEmpty@google.com
+ * @brief   IOCP style completion port
+ * @version 0.0.1
+ * @date    2026-10-17
+ *
+ * @copyright Copyright (c) 2023
+ *
+ */
+
+#ifndef LWE__COMPLETIONPORT_HPP__
+#define LWE__COMPLETIONPORT_HPP__
+
+#include "atomic"
+#include "thread"
+#include "vector"
+#include "../../memory/memory/Buffer.hpp"
+#include "../../include/include/includes.hpp"
+
+/**
+ * @brief socket descriptor
+ */
+#if _WIN32 || _WIN64
+using Socket = uintptr_t;
+#else
+using Socket = int;
+#endif
+
+/**
+ * @brief asynchronous operation, derive to carry context (e.g. struct RecvContext: Overlapped { Session* session; })
+ * @warning owned by the caller, keep alive until its completion is dequeued
+ */
+struct Overlapped
+{
+    /**
+     * @brief operation kind, set by the port
+     */
+    enum EOperation : uint8_t
+    {
+        NONE,
+        RECV,   // completes with received bytes, 0: closed by peer
+        SEND,   // completes when all bytes are sent
+        ACCEPT, // completes with accepted socket
+        POST,   // Post()
+    };
+
+    char*  buffer = nullptr; // [in] RECV / SEND
+    size_t length = 0;       // [in] RECV / SEND, buffer size (vectors: total bytes)
+
+    iovec*   vectors = nullptr; // [in] SEND, gather list instead of buffer, advanced in place on short send
+    uint32_t count   = 0;       // [in] SEND, vectors size
+
+    EOperation  operation   = NONE; // [out]
+    Socket      socket      = -1;   // [out] ACCEPT: accepted, otherwise target
+    size_t      transferred = 0;    // internal, SEND progress
+    uint64_t    key         = 0;    // internal, key of the target
+    Overlapped* next        = nullptr;
+};
+
+/**
+ * @brief dequeued result (GetQueuedCompletionStatus)
+ */
+struct Completion
+{
+    uint64_t    key        = 0;       // Associate() / Post() key
+    Overlapped* overlapped = nullptr; // nullptr: Post() without overlapped
+    size_t      bytes      = 0;       // transferred
+    int         error      = 0;       // errno, 0: succeeded
+};
+
+/**
+ * @brief completion port: issue operation, dequeue result from any thread
+ * @note  same threading model as IOCP: worker threads call Dequeue() in a loop
+ *        Start(): optional worker pool calling the handler
+ *        Create(): platform implementation (linux: UringPort or EpollPort)
+ */
+class CompletionPort
+{
+public:
+    /**
+     * @brief called by worker threads of Start()
+     */
+    using Handler = void (*)(const Completion& completion, void* context);
+
+    /**
+     * @brief implementation for Create()
+     */
+    enum EBackend
+    {
+        DEFAULT,
+        EPOLL,
+        URING,
+    };
+
+public:
+    /**
+     * @brief READONLY: infinite Dequeue() timeout
+     */
+    static const int INFINITE_WAIT;
+
+public:
+    /**
+     * @brief create platform implementation
+     *
+     * @param backend [in] DEFAULT: io_uring, epoll if io_uring is unavailable
+     * @return CompletionPort* nullptr: not supported / failed, delete by caller
+     */
+    static CompletionPort* Create(IN EBackend backend = DEFAULT);
+
+public:
+    CompletionPort();
+
+    /**
+     * @brief Destroy the CompletionPort object
+     * @warning derived class must call Stop() first
+     */
+    virtual ~CompletionPort();
+
+public:
+    DECLARE_NO_COPY(CompletionPort);
+
+public:
+    /**
+     * @brief register socket, set to non-blocking
+     *
+     * @param socket [in]
+     * @param key    [in] returned by completions of the socket (e.g. session id)
+     * @return true: succeeded / false: failed (errno)
+     */
+    virtual bool Associate(IN Socket socket, IN uint64_t key) = 0;
+
+    /**
+     * @brief unregister socket, pending operations complete with ECANCELED
+     * @note  call before close
+     *
+     * @param socket [in]
+     * @return true: succeeded / false: not associated
+     */
+    virtual bool Dissociate(IN Socket socket) = 0;
+
+    /**
+     * @brief receive into overlapped->buffer
+     *
+     * @param socket     [in] associated
+     * @param overlapped [in]
+     * @return true: completion will be queued / false: failed (errno)
+     */
+    virtual bool Recv(IN Socket socket, IN Overlapped* overlapped) = 0;
+
+    /**
+     * @brief send overlapped->buffer
+     * @note  multiple sends are completed in order
+     *
+     * @param socket     [in] associated
+     * @param overlapped [in]
+     * @return true: completion will be queued / false: failed (errno)
+     */
+    virtual bool Send(IN Socket socket, IN Overlapped* overlapped) = 0;
+
+    /**
+     * @brief accept connection, result is overlapped->socket
+     *
+     * @param listener   [in] associated, listening
+     * @param overlapped [in]
+     * @return true: completion will be queued / false: failed (errno)
+     */
+    virtual bool Accept(IN Socket listener, IN Overlapped* overlapped) = 0;
+
+    /**
+     * @brief queue user completion (PostQueuedCompletionStatus)
+     *
+     * @param key        [in]
+     * @param overlapped [in] nullable
+     * @param bytes      [in]
+     * @return true: succeeded / false: failed
+     */
+    virtual bool Post(IN uint64_t key, IN Overlapped* overlapped = nullptr, IN size_t bytes = 0) = 0;
+
+    /**
+     * @brief wait for one completion (GetQueuedCompletionStatus)
+     *
+     * @param completion [out]
+     * @param timeout    [in] milliseconds, INFINITE_WAIT: infinite
+     * @return true: dequeued / false: timeout
+     */
+    virtual bool Dequeue(OUT Completion& completion, IN int timeout = INFINITE_WAIT) = 0;
+
+public:
+    /**
+     * @brief run worker threads calling Dequeue() and handler
+     *
+     * @param threads [in] 0: hardware concurrency
+     * @param handler [in]
+     * @param context [in] argument of the handler
+     * @return true: started / false: already running
+     */
+    bool Start(IN size_t threads, IN Handler handler, IN void* context = nullptr);
+
+    /**
+     * @brief stop and join worker threads, queued completions are kept
+     * @warning do not call from a worker thread
+     */
+    void Stop();
+
+    /**
+     * @brief check Start() state
+     */
+    bool IsRunning() const;
+
+protected:
+    /**
+     * @brief skip sent bytes of the gather list
+     *
+     * @param overlapped [in, out] vectors / count
+     * @param bytes      [in] sent
+     */
+    static void Advance(IN OUT Overlapped* overlapped, IN size_t bytes);
+
+protected:
+    /**
+     * @brief FIFO of pending operations, not thread safe
+     */
+    struct Pending
+    {
+        void        Push(IN Overlapped*);
+        Overlapped* Pop();
+
+        Overlapped* head = nullptr;
+        Overlapped* tail = nullptr;
+    };
+
+private:
+    /**
+     * @brief worker thread body
+     *
+     * @param handler [in]
+     * @param context [in]
+     */
+    void Work(IN Handler handler, IN void* context);
+
+private:
+    /**
+     * @brief READONLY: key posted by Stop(), one per worker
+     */
+    static const uint64_t STOP_KEY;
+
+private:
+    std::vector<std::thread> workers;
+    std::atomic<bool>        isRunning;
+};
+
+#endif
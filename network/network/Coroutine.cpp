@@ -0,0 +1,249 @@
+#include "Coroutine.hpp"
+#include "stdexcept"
+
+const uint64_t AsyncSocket::KEY = UINT64_MAX - 1;
+
+void* CoroutineFrame::Allocate(size_t size)
+{
+    size_t index = ClassOf(size);
+    if(index == CLASS_COUNT) {
+        return ::operator new(size);
+    }
+    return Pool(index).Allocate();
+}
+
+void CoroutineFrame::Release(void* frame, size_t size)
+{
+    size_t index = ClassOf(size);
+    if(index == CLASS_COUNT) {
+        ::operator delete(frame);
+        return;
+    }
+    Pool(index).Release(frame);
+}
+
+SlabAllocator::Stats CoroutineFrame::GetStats()
+{
+    SlabAllocator::Stats result = {};
+    for(size_t i = 0; i < CLASS_COUNT; ++i) {
+        SlabAllocator::Stats stats = Pool(i).GetStats();
+
+        result.allocations += stats.allocations;
+        result.releases    += stats.releases;
+        result.exchanges   += stats.exchanges;
+        result.slabs       += stats.slabs;
+        result.magazines   += stats.magazines;
+        result.capacity    += stats.capacity;
+    }
+    return result;
+}
+
+size_t CoroutineFrame::ClassOf(size_t size)
+{
+    size_t index = 0;
+    for(size_t limit = MIN_FRAME; limit < size && index < CLASS_COUNT; limit <<= 1) {
+        ++index;
+    }
+    return index;
+}
+
+SlabAllocator& CoroutineFrame::Pool(size_t index)
+{
+    // never destroyed: detached coroutines may finish on threads still running at exit
+    static SlabAllocator** pools = [] {
+        SlabAllocator** pools = new SlabAllocator*[CLASS_COUNT];
+        for(size_t i = 0; i < CLASS_COUNT; ++i) {
+            pools[i] = new SlabAllocator(MIN_FRAME << i);
+        }
+        return pools;
+    }();
+    return *pools[index];
+}
+
+bool AsyncSocket::RecvAwaiter::await_suspend(std::coroutine_handle<> handle)
+{
+    this->handle = handle;
+
+    // may resume on a worker before returning: no access after issue
+    if(!port->Recv(target, this)) {
+        result.error = errno;
+        return false;
+    }
+    return true;
+}
+
+/**
+ * @brief chain send completion: issue the rest, resume when all bytes are sent
+ */
+static bool Continue(AsyncOperation* operation, const Completion& completion)
+{
+    AsyncSocket::SendAwaiter* send = static_cast<AsyncSocket::SendAwaiter*>(operation);
+
+    send->offset       += completion.bytes;
+    send->result.bytes  = send->offset;
+    if(completion.error || send->offset >= send->chain->GetSize()) {
+        return true;
+    }
+
+    send->count  = static_cast<uint32_t>(send->chain->Gather(send->parts, AsyncSocket::MAX_VECTORS, send->offset));
+    send->length = 0;
+    for(uint32_t i = 0; i < send->count; ++i) {
+        send->length += send->parts[i].iov_len;
+    }
+    send->vectors = send->parts;
+
+    if(!send->port->Send(send->target, send)) {
+        send->result.error = errno;
+        return true;
+    }
+    return false;
+}
+
+bool AsyncSocket::SendAwaiter::await_suspend(std::coroutine_handle<> handle)
+{
+    this->handle = handle;
+
+    if(chain) {
+        if(chain->IsEmpty()) {
+            return false;
+        }
+
+        count  = static_cast<uint32_t>(chain->Gather(parts, MAX_VECTORS));
+        length = 0;
+        for(uint32_t i = 0; i < count; ++i) {
+            length += parts[i].iov_len;
+        }
+        vectors  = parts;
+        complete = &Continue;
+    }
+    else if(length == 0) {
+        return false;
+    }
+
+    if(!port->Send(target, this)) {
+        result.error = errno;
+        return false;
+    }
+    return true;
+}
+
+bool AsyncSocket::AcceptAwaiter::await_suspend(std::coroutine_handle<> handle)
+{
+    this->handle = handle;
+
+    if(!port->Accept(listener, this)) {
+        result.error = errno;
+        return false;
+    }
+    return true;
+}
+
+AsyncSocket::AsyncSocket(CompletionPort* port, Socket socket): port(port), socket(socket)
+{
+    if(!port->Associate(socket, KEY)) {
+        throw std::runtime_error("associate failed");
+    }
+}
+
+AsyncSocket::~AsyncSocket()
+{
+    port->Dissociate(socket);
+}
+
+AsyncSocket::RecvAwaiter AsyncSocket::Recv(void* buffer, size_t length)
+{
+    RecvAwaiter awaiter;
+    awaiter.port   = port;
+    awaiter.buffer = static_cast<char*>(buffer);
+    awaiter.length = length;
+    awaiter.target = socket;
+    return awaiter;
+}
+
+AsyncSocket::RecvAwaiter AsyncSocket::Recv(BufferRef& buffer)
+{
+    return Recv(buffer.GetData() + buffer.GetSize(), buffer.GetTailroom());
+}
+
+AsyncSocket::SendAwaiter AsyncSocket::Send(const void* buffer, size_t length)
+{
+    SendAwaiter awaiter;
+    awaiter.port   = port;
+    awaiter.buffer = static_cast<char*>(const_cast<void*>(buffer));
+    awaiter.length = length;
+    awaiter.target = socket;
+    awaiter.chain  = nullptr;
+    awaiter.offset = 0;
+    return awaiter;
+}
+
+AsyncSocket::SendAwaiter AsyncSocket::Send(const BufferChain& chain)
+{
+    SendAwaiter awaiter;
+    awaiter.port   = port;
+    awaiter.target = socket;
+    awaiter.chain  = &chain;
+    awaiter.offset = 0;
+    return awaiter;
+}
+
+AsyncSocket::AcceptAwaiter AsyncSocket::Accept()
+{
+    AcceptAwaiter awaiter;
+    awaiter.port     = port;
+    awaiter.listener = socket;
+    return awaiter;
+}
+
+bool AsyncSocket::OnCompletion(const Completion& completion)
+{
+    if(completion.key != KEY || completion.overlapped == nullptr) {
+        return false;
+    }
+
+    AsyncOperation* operation = static_cast<AsyncOperation*>(completion.overlapped);
+    operation->result.bytes   = completion.bytes;
+    operation->result.error   = completion.error;
+
+    if(operation->complete && !operation->complete(operation, completion)) {
+        return true; // continued, completes again
+    }
+    operation->handle.resume();
+    return true;
+}
+
+void AsyncSocket::Handler(const Completion& completion, void*)
+{
+    OnCompletion(completion);
+}
+
+AsyncTimer::AsyncTimer(TimerWheel& wheel, CompletionPort* port): wheel(&wheel), port(port) {}
+
+bool AsyncTimer::SleepAwaiter::await_suspend(std::coroutine_handle<> handle)
+{
+    this->handle = handle;
+
+    // may expire on the ticking thread before returning: no access after Add()
+    wheel->Add(delay, &AsyncTimer::Expire, this);
+    return true;
+}
+
+AsyncTimer::SleepAwaiter AsyncTimer::Sleep(std::chrono::nanoseconds delay)
+{
+    SleepAwaiter awaiter;
+    awaiter.port  = port;
+    awaiter.wheel = wheel;
+    awaiter.delay = delay;
+    return awaiter;
+}
+
+void AsyncTimer::Expire(void* context)
+{
+    SleepAwaiter* awaiter = static_cast<SleepAwaiter*>(context);
+
+    // resume on a worker, not on the ticking thread
+    if(!awaiter->port->Post(AsyncSocket::KEY, awaiter)) {
+        awaiter->result.error = errno;
+        awaiter->handle.resume();
+    }
+}
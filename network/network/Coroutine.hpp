@@ -0,0 +1,389 @@
+/**
+ * @file    Coroutine.hpp
+ * @author  LaverWinEmpty@google.com
+ * @brief   C++20 coroutine awaitables over the completion port
+ * @version 0.0.1
+ * @date    2026-10-17
+ *
+ * @copyright Copyright (c) 2023
+ *
+ */
+
+#ifndef LWE__COROUTINE_HPP__
+#define LWE__COROUTINE_HPP__
+
+#include "coroutine"
+#include "exception"
+#include "stdexcept"
+#include "chrono"
+#include "CompletionPort.hpp"
+#include "../../memory/memory/Buffer.hpp"
+#include "../../memory/memory/SlabPool.hpp"
+#include "../../utilities/utilities/TimerWheel.hpp"
+
+/**
+ * @brief result of an awaited operation
+ */
+struct AsyncResult
+{
+    size_t bytes = 0; // transferred, RECV 0: closed by peer
+    int    error = 0; // errno, 0: succeeded
+};
+
+/**
+ * @brief STATIC: coroutine frame pool, size classes over slab allocators
+ * @note  frames of CLASS_COUNT classes (MIN_FRAME ~) are recycled without heap allocation, larger: heap
+ */
+class CoroutineFrame
+{
+public:
+    DECLARE_LIMIT_LIFECYCLE(CoroutineFrame);
+
+public:
+    /**
+     * @brief READONLY: smallest class
+     */
+    static const size_t MIN_FRAME = 128;
+
+    /**
+     * @brief READONLY: classes, doubling from MIN_FRAME
+     */
+    static const size_t CLASS_COUNT = 7;
+
+public:
+    /**
+     * @brief get frame
+     * @throw std::bad_alloc
+     *
+     * @param size [in]
+     * @return void*
+     */
+    static void* Allocate(IN size_t size);
+
+    /**
+     * @brief return frame
+     *
+     * @param frame [in] from Allocate()
+     * @param size  [in] same as Allocate()
+     */
+    static void Release(IN void* frame, IN size_t size);
+
+    /**
+     * @brief merge counters of all classes
+     *
+     * @return SlabAllocator::Stats
+     */
+    static SlabAllocator::Stats GetStats();
+
+private:
+    /**
+     * @brief class of size
+     *
+     * @return size_t CLASS_COUNT: heap
+     */
+    static size_t ClassOf(IN size_t size);
+
+    static SlabAllocator& Pool(IN size_t index);
+};
+
+/**
+ * @brief lazy coroutine, started by co_await or Spawn()
+ * @note  co_await resumes the caller on the thread that finished the task (symmetric transfer)
+ *        (e.g. Task<size_t> Read(AsyncSocket& socket); Task<> Run() { size_t n = co_await Read(socket); })
+ *
+ * @tparam T result type
+ */
+template<typename T = void> class Task
+{
+public:
+    struct promise_type;
+    using Handle = std::coroutine_handle<promise_type>;
+
+    /**
+     * @brief frame allocation, continuation and exception, common to all results
+     */
+    struct PromiseBase
+    {
+        /**
+         * @brief at final suspend: resume the awaiting coroutine or free detached frame
+         */
+        struct FinalAwaiter
+        {
+            bool                    await_ready() noexcept { return false; }
+            std::coroutine_handle<> await_suspend(IN Handle handle) noexcept;
+            void                    await_resume() noexcept {}
+        };
+
+        std::suspend_always initial_suspend() noexcept { return {}; }
+        FinalAwaiter        final_suspend() noexcept { return {}; }
+        void                unhandled_exception();
+
+        static void* operator new(IN size_t size);
+        static void  operator delete(IN void* frame, IN size_t size);
+
+        std::coroutine_handle<> continuation;
+        std::exception_ptr      exception;
+        bool                    isDetached = false;
+    };
+
+    struct promise_type: PromiseBase
+    {
+        Task get_return_object() { return Task(Handle::from_promise(*this)); }
+        void return_value(IN T value) { result = std::move(value); }
+
+        T result{};
+    };
+
+    /**
+     * @brief awaiter of co_await task
+     * @note  empty handle: ready, await_resume() throws
+     */
+    struct Awaiter
+    {
+        bool                    await_ready() const noexcept { return !handle || handle.done(); }
+        std::coroutine_handle<> await_suspend(IN std::coroutine_handle<> caller) noexcept;
+        T                       await_resume();
+
+        Handle handle;
+    };
+
+public:
+    Task();
+    Task(IN Task&&) noexcept;
+    Task& operator=(IN Task&&) noexcept;
+    ~Task();
+
+public:
+    DECLARE_NO_COPY(Task);
+
+public:
+    /**
+     * @brief run and wait for the result
+     * @throw std::logic_error on resume: empty task (default constructed, moved or spawned)
+     *
+     * @return Awaiter co_await: T, exception of the task is rethrown
+     */
+    Awaiter operator co_await() && noexcept;
+
+    /**
+     * @brief start detached, the frame is freed at completion
+     * @note  exception of a detached task terminates (same as std::thread)
+     * @throw std::logic_error empty task
+     */
+    void Spawn() &&;
+
+private:
+    explicit Task(IN Handle handle);
+
+    Handle handle;
+};
+
+/**
+ * @brief Task<void>
+ */
+template<> struct Task<void>::promise_type: Task<void>::PromiseBase
+{
+    Task get_return_object() { return Task(Handle::from_promise(*this)); }
+    void return_void() {}
+};
+
+/**
+ * @brief operation resumed by a completion, lives in the awaiting coroutine frame
+ */
+struct AsyncOperation: Overlapped
+{
+    /**
+     * @brief called on completion
+     *
+     * @return true: resume / false: continued (e.g. resubmitted rest of a chain)
+     */
+    using Complete = bool (*)(AsyncOperation* operation, const Completion& completion);
+
+    CompletionPort*         port     = nullptr;
+    std::coroutine_handle<> handle   = nullptr;
+    Complete                complete = nullptr;
+    AsyncResult             result;
+
+    bool        await_ready() const noexcept { return false; }
+    AsyncResult await_resume() const noexcept { return result; }
+};
+
+/**
+ * @brief associated socket with awaitable operations
+ * @note  associated with KEY: the port handler passes completions to OnCompletion() first,
+ *        or Start(threads, &AsyncSocket::Handler) when all sockets of the port are awaited
+ *        the coroutine resumes on the worker thread that dequeued the completion
+ *        operations are members of the coroutine frame: no heap allocation per operation
+ *        (e.g. AsyncResult result = co_await socket.Recv(buffer, sizeof(buffer));)
+ */
+class AsyncSocket
+{
+public:
+    /**
+     * @brief READONLY: key of awaited sockets and timers
+     */
+    static const uint64_t KEY;
+
+    /**
+     * @brief READONLY: gather segments per send, longer chains are sent in parts
+     */
+    static const size_t MAX_VECTORS = 16;
+
+public:
+    struct RecvAwaiter: AsyncOperation
+    {
+        bool await_suspend(IN std::coroutine_handle<> handle);
+
+        Socket target;
+    };
+
+    struct SendAwaiter: AsyncOperation
+    {
+        bool await_suspend(IN std::coroutine_handle<> handle);
+
+        Socket             target;
+        const BufferChain* chain; // nullptr: buffer / length
+        size_t             offset;
+        iovec              parts[MAX_VECTORS];
+    };
+
+    struct AcceptAwaiter: AsyncOperation
+    {
+        bool   await_suspend(IN std::coroutine_handle<> handle);
+        Socket await_resume() const noexcept;
+
+        Socket listener;
+    };
+
+public:
+    /**
+     * @brief Construct a new AsyncSocket object, associate with KEY
+     * @throw std::runtime_error
+     *
+     * @param port   [in]
+     * @param socket [in] owned by the caller
+     */
+    AsyncSocket(IN CompletionPort* port, IN Socket socket);
+
+    /**
+     * @brief Destroy the AsyncSocket object, dissociate
+     * @warning pending operations complete with ECANCELED after this, keep their frames alive
+     */
+    ~AsyncSocket();
+
+public:
+    DECLARE_NO_COPY(AsyncSocket);
+
+public:
+    /**
+     * @brief receive
+     *
+     * @param buffer [out] keep alive until resumed
+     * @param length [in]
+     * @return RecvAwaiter co_await: AsyncResult
+     */
+    RecvAwaiter Recv(OUT void* buffer, IN size_t length);
+
+    /**
+     * @brief receive into the tailroom of a unique reference (e.g. BufferRef ref(capacity); ref.Truncate(0);)
+     *
+     * @param buffer [out] extended by the caller: Truncate(GetSize() + result.bytes)
+     * @return RecvAwaiter co_await: AsyncResult
+     */
+    RecvAwaiter Recv(OUT BufferRef& buffer);
+
+    /**
+     * @brief send all bytes
+     *
+     * @param buffer [in] keep alive until resumed
+     * @param length [in]
+     * @return SendAwaiter co_await: AsyncResult
+     */
+    SendAwaiter Send(IN const void* buffer, IN size_t length);
+
+    /**
+     * @brief send all bytes of the chain, zero-copy
+     *
+     * @param chain [in] keep alive until resumed
+     * @return SendAwaiter co_await: AsyncResult
+     */
+    SendAwaiter Send(IN const BufferChain& chain);
+
+    /**
+     * @brief accept connection on this listening socket
+     *
+     * @return AcceptAwaiter co_await: Socket, -1: failed (not associated)
+     */
+    AcceptAwaiter Accept();
+
+public:
+    /**
+     * @brief resume the operation of a KEY completion
+     *
+     * @param completion [in]
+     * @return true: handled / false: not KEY
+     */
+    static bool OnCompletion(IN const Completion& completion);
+
+    /**
+     * @brief port handler for ports of awaited sockets only (CompletionPort::Start())
+     */
+    static void Handler(IN const Completion& completion, IN void* context);
+
+    Socket GetSocket() const;
+
+private:
+    CompletionPort* port;
+    Socket          socket;
+};
+
+/**
+ * @brief awaitable sleep on a timer wheel, resumed by a worker of the port
+ * @note  expiry posts the operation to the port with AsyncSocket::KEY
+ *        (e.g. co_await timer.Sleep(std::chrono::milliseconds(10));)
+ */
+class AsyncTimer
+{
+public:
+    struct SleepAwaiter: AsyncOperation
+    {
+        bool await_ready() const noexcept;
+        bool await_suspend(IN std::coroutine_handle<> handle);
+
+        TimerWheel*              wheel;
+        std::chrono::nanoseconds delay;
+    };
+
+public:
+    /**
+     * @brief Construct a new AsyncTimer object
+     *
+     * @param wheel [in] advanced by the caller
+     * @param port  [in] resumes on its workers
+     */
+    AsyncTimer(IN TimerWheel& wheel, IN CompletionPort* port);
+
+public:
+    /**
+     * @brief sleep
+     *
+     * @param delay [in] 0: no suspension
+     * @return SleepAwaiter co_await: AsyncResult
+     */
+    SleepAwaiter Sleep(IN std::chrono::nanoseconds delay);
+
+private:
+    /**
+     * @brief wheel callback: hand over to the port
+     *
+     * @param context [in] SleepAwaiter*
+     */
+    static void Expire(IN void* context);
+
+private:
+    TimerWheel*     wheel;
+    CompletionPort* port;
+};
+
+#include "Coroutine.ipp"
+#endif
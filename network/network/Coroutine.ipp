@@ -0,0 +1,118 @@
+template<typename T>
+std::coroutine_handle<> Task<T>::PromiseBase::FinalAwaiter::await_suspend(Handle handle) noexcept
+{
+    PromiseBase& promise = handle.promise();
+    if(promise.continuation) {
+        return promise.continuation;
+    }
+
+    // detached: nobody owns the frame
+    if(promise.isDetached) {
+        handle.destroy();
+    }
+    return std::noop_coroutine();
+}
+
+template<typename T> void Task<T>::PromiseBase::unhandled_exception()
+{
+    if(isDetached) {
+        std::terminate();
+    }
+    exception = std::current_exception();
+}
+
+template<typename T> void* Task<T>::PromiseBase::operator new(size_t size)
+{
+    return CoroutineFrame::Allocate(size);
+}
+
+template<typename T> void Task<T>::PromiseBase::operator delete(void* frame, size_t size)
+{
+    CoroutineFrame::Release(frame, size);
+}
+
+template<typename T>
+std::coroutine_handle<> Task<T>::Awaiter::await_suspend(std::coroutine_handle<> caller) noexcept
+{
+    handle.promise().continuation = caller;
+    return handle;
+}
+
+template<typename T> T Task<T>::Awaiter::await_resume()
+{
+    // ready without a frame: nothing ran, no promise to read
+    if(!handle) {
+        throw std::logic_error("co_await of an empty task");
+    }
+    if(handle.promise().exception) {
+        std::rethrow_exception(handle.promise().exception);
+    }
+    if constexpr(!std::is_void_v<T>) {
+        return std::move(handle.promise().result);
+    }
+}
+
+template<typename T> Task<T>::Task(): handle(nullptr) {}
+
+template<typename T> Task<T>::Task(Handle handle): handle(handle) {}
+
+template<typename T> Task<T>::Task(Task&& other) noexcept: handle(other.handle)
+{
+    other.handle = nullptr;
+}
+
+template<typename T> Task<T>& Task<T>::operator=(Task&& other) noexcept
+{
+    if(this != &other) {
+        if(handle) {
+            handle.destroy();
+        }
+        handle       = other.handle;
+        other.handle = nullptr;
+    }
+    return *this;
+}
+
+template<typename T> Task<T>::~Task()
+{
+    if(handle) {
+        handle.destroy();
+    }
+}
+
+template<typename T> typename Task<T>::Awaiter Task<T>::operator co_await() && noexcept
+{
+    return Awaiter{ handle };
+}
+
+template<typename T> void Task<T>::Spawn() &&
+{
+    if(!handle) {
+        throw std::logic_error("spawn of an empty task");
+    }
+
+    Handle started = handle;
+    handle         = nullptr;
+
+    started.promise().isDetached = true;
+    started.resume();
+}
+
+inline Socket AsyncSocket::AcceptAwaiter::await_resume() const noexcept
+{
+    if(result.error) {
+        errno = result.error;
+        return -1;
+    }
+    return socket;
+}
+
+inline Socket AsyncSocket::GetSocket() const
+{
+    return socket;
+}
+
+inline bool AsyncTimer::SleepAwaiter::await_ready() const noexcept
+{
+    return delay.count() <= 0;
+}
@@ -0,0 +1,422 @@
+#include "EpollPort.hpp"
+
+#if __linux__
+
+#    include "stdexcept"
+#    include "fcntl.h"
+#    include "unistd.h"
+#    include "sys/epoll.h"
+#    include "sys/socket.h"
+#    include "sys/eventfd.h"
+#    include "../../utilities/utilities/Clock.hpp"
+
+const size_t EpollPort::DEF_CAPACITY = 1 << 16;
+
+// epoll_event::data.u64 of the eventfd, channels use (generation << 32 | socket)
+static const uint64_t WAKE = UINT64_MAX;
+
+EpollPort::EpollPort(size_t capacity): epoll(-1), event(-1), channels(nullptr), capacity(capacity), head(0), queued(0)
+{
+    epoll = epoll_create1(EPOLL_CLOEXEC);
+    if(epoll < 0) {
+        throw std::runtime_error("epoll_create1 failed");
+    }
+
+    event = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if(event < 0) {
+        close(epoll);
+        throw std::runtime_error("eventfd failed");
+    }
+
+    epoll_event registration = {};
+    registration.events      = EPOLLIN | EPOLLET;
+    registration.data.u64    = WAKE;
+    if(epoll_ctl(epoll, EPOLL_CTL_ADD, event, &registration) < 0) {
+        close(event);
+        close(epoll);
+        throw std::runtime_error("epoll_ctl failed");
+    }
+
+    channels = new Channel[capacity];
+}
+
+EpollPort::~EpollPort()
+{
+    Stop();
+
+    close(event);
+    close(epoll);
+    SAFE_DELETES(channels);
+}
+
+bool EpollPort::Associate(Socket socket, uint64_t key)
+{
+    if(socket < 0 || static_cast<size_t>(socket) >= capacity) {
+        errno = EMFILE;
+        return false;
+    }
+
+    int flags = fcntl(socket, F_GETFL, 0);
+    if(flags < 0 || fcntl(socket, F_SETFL, flags | O_NONBLOCK) < 0) {
+        return false;
+    }
+
+    Channel&          channel = channels[socket];
+    LockGuard::Scoped guard(channel.lock);
+
+    if(channel.isActive) {
+        errno = EEXIST;
+        return false;
+    }
+
+    // registered once with both directions: edge-triggered, no re-arm per operation
+    epoll_event registration = {};
+    registration.events      = EPOLLIN | EPOLLOUT | EPOLLRDHUP | EPOLLET;
+    registration.data.u64    = (static_cast<uint64_t>(channel.generation + 1) << 32) | static_cast<uint32_t>(socket);
+    if(epoll_ctl(epoll, EPOLL_CTL_ADD, socket, &registration) < 0) {
+        return false;
+    }
+
+    channel.key        = key;
+    channel.generation = channel.generation + 1;
+    channel.isActive   = true;
+    channel.isReadable = true; // unknown: try first
+    channel.isWritable = true;
+    return true;
+}
+
+bool EpollPort::Dissociate(Socket socket)
+{
+    if(socket < 0 || static_cast<size_t>(socket) >= capacity) {
+        return false;
+    }
+
+    std::vector<Completion> canceled;
+    {
+        Channel&          channel = channels[socket];
+        LockGuard::Scoped guard(channel.lock);
+
+        if(!channel.isActive) {
+            return false;
+        }
+
+        epoll_ctl(epoll, EPOLL_CTL_DEL, socket, nullptr);
+        channel.isActive = false;
+
+        for(Pending* pending : { &channel.reads, &channel.writes }) {
+            while(Overlapped* overlapped = pending->Pop()) {
+                canceled.push_back({ channel.key, overlapped, overlapped->transferred, ECANCELED });
+            }
+        }
+    }
+
+    Push(canceled);
+    return true;
+}
+
+bool EpollPort::Recv(Socket socket, Overlapped* overlapped)
+{
+    return Issue(socket, overlapped, Overlapped::RECV);
+}
+
+bool EpollPort::Send(Socket socket, Overlapped* overlapped)
+{
+    return Issue(socket, overlapped, Overlapped::SEND);
+}
+
+bool EpollPort::Accept(Socket listener, Overlapped* overlapped)
+{
+    return Issue(listener, overlapped, Overlapped::ACCEPT);
+}
+
+bool EpollPort::Post(uint64_t key, Overlapped* overlapped, size_t bytes)
+{
+    if(overlapped) {
+        overlapped->operation = Overlapped::POST;
+    }
+
+    {
+        LockGuard::Scoped guard(queueLock);
+        queue.push_back({ key, overlapped, bytes, 0 });
+        queued.fetch_add(1, std::memory_order_release);
+    }
+
+    Wake();
+    return true;
+}
+
+bool EpollPort::Dequeue(Completion& completion, int timeout)
+{
+    thread_local std::vector<Completion> local;
+
+    uint64_t deadline = timeout >= 0 ? Clock::Now() + static_cast<uint64_t>(timeout) * 1000000 : 0;
+    while(true) {
+        if(Pop(completion)) {
+            return true;
+        }
+
+        int wait = INFINITE_WAIT;
+        if(timeout >= 0) {
+            uint64_t now = Clock::Now();
+            wait         = now < deadline ? static_cast<int>((deadline - now + 999999) / 1000000) : 0;
+        }
+
+        epoll_event events[EVENTS];
+        int         count = epoll_wait(epoll, events, EVENTS, wait);
+        if(count < 0) {
+            if(errno != EINTR) {
+                return false;
+            }
+            count = 0;
+        }
+
+        local.clear();
+        for(int i = 0; i < count; ++i) {
+            Handle(events[i].data.u64, events[i].events, local);
+        }
+
+        if(!local.empty()) {
+            // keep the first: completed by this thread, no queue round trip
+            completion = local.front();
+            local.erase(local.begin());
+            Push(local);
+            return true;
+        }
+
+        if(count == 0 && wait == 0) {
+            return Pop(completion);
+        }
+    }
+}
+
+bool EpollPort::Issue(Socket socket, Overlapped* overlapped, Overlapped::EOperation operation)
+{
+    if(socket < 0 || static_cast<size_t>(socket) >= capacity) {
+        errno = EBADF;
+        return false;
+    }
+
+    overlapped->operation   = operation;
+    overlapped->transferred = 0;
+    overlapped->next        = nullptr;
+
+    // reused: no allocation per operation completed at once
+    thread_local std::vector<Completion> done;
+    done.clear();
+    {
+        Channel&          channel = channels[socket];
+        LockGuard::Scoped guard(channel.lock);
+
+        if(!channel.isActive) {
+            errno = EBADF;
+            return false;
+        }
+
+        overlapped->socket = socket;
+        overlapped->key    = channel.key;
+
+        // queued behind others: keeps order, drained by the event
+        if(operation == Overlapped::SEND) {
+            bool isIdle = channel.writes.head == nullptr;
+            channel.writes.Push(overlapped);
+            if(isIdle && channel.isWritable) {
+                DrainWrites(channel, socket, done);
+            }
+        }
+        else {
+            bool isIdle = channel.reads.head == nullptr;
+            channel.reads.Push(overlapped);
+            if(isIdle && channel.isReadable) {
+                DrainReads(channel, socket, done);
+            }
+        }
+    }
+
+    // completed at once: still reported through the queue, like IOCP
+    Push(done);
+    return true;
+}
+
+void EpollPort::DrainReads(Channel& channel, Socket socket, std::vector<Completion>& out)
+{
+    while(Overlapped* overlapped = channel.reads.head) {
+        int     error  = 0;
+        EResult result = Perform(socket, overlapped, error);
+        if(result == AGAIN) {
+            channel.isReadable = false;
+            return;
+        }
+
+        channel.reads.Pop();
+        out.push_back({ channel.key, overlapped, overlapped->transferred, error });
+    }
+}
+
+void EpollPort::DrainWrites(Channel& channel, Socket socket, std::vector<Completion>& out)
+{
+    while(Overlapped* overlapped = channel.writes.head) {
+        int     error  = 0;
+        EResult result = Perform(socket, overlapped, error);
+        if(result == AGAIN) {
+            channel.isWritable = false;
+            return;
+        }
+
+        if(result == DONE) {
+            channel.writes.Pop();
+            out.push_back({ channel.key, overlapped, overlapped->transferred, error });
+        }
+    }
+}
+
+EpollPort::EResult EpollPort::Perform(Socket socket, Overlapped* overlapped, int& error)
+{
+    while(true) {
+        ssize_t result = -1;
+        switch(overlapped->operation) {
+            case Overlapped::RECV:
+                result = recv(socket, overlapped->buffer, overlapped->length, 0);
+                break;
+
+            case Overlapped::SEND:
+                if(overlapped->vectors) {
+                    msghdr message     = {};
+                    message.msg_iov    = overlapped->vectors;
+                    message.msg_iovlen = overlapped->count;
+                    result             = sendmsg(socket, &message, MSG_NOSIGNAL);
+                }
+                else {
+                    result = send(socket,
+                                  overlapped->buffer + overlapped->transferred,
+                                  overlapped->length - overlapped->transferred,
+                                  MSG_NOSIGNAL);
+                }
+                break;
+
+            case Overlapped::ACCEPT:
+                result = accept4(socket, nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC);
+                break;
+
+            default:
+                error = EINVAL;
+                return DONE;
+        }
+
+        if(result >= 0) {
+            if(overlapped->operation == Overlapped::ACCEPT) {
+                overlapped->socket = static_cast<Socket>(result);
+                return DONE;
+            }
+
+            overlapped->transferred += static_cast<size_t>(result);
+            if(overlapped->operation == Overlapped::SEND && overlapped->transferred < overlapped->length) {
+                if(overlapped->vectors) {
+                    Advance(overlapped, static_cast<size_t>(result));
+                }
+                return MORE;
+            }
+            return DONE;
+        }
+
+        if(errno == EINTR) {
+            continue;
+        }
+        if(errno == EAGAIN || errno == EWOULDBLOCK) {
+            return AGAIN;
+        }
+
+        error = errno;
+        return DONE;
+    }
+}
+
+void EpollPort::Handle(uint64_t data, uint32_t events, std::vector<Completion>& out)
+{
+    if(data == WAKE) {
+        uint64_t value;
+        if(read(event, &value, sizeof(value)) < 0) {
+            pass;
+        }
+        return;
+    }
+
+    Socket   socket     = static_cast<Socket>(data & 0xFFFFFFFF);
+    uint32_t generation = static_cast<uint32_t>(data >> 32);
+
+    Channel&          channel = channels[socket];
+    LockGuard::Scoped guard(channel.lock);
+
+    // closed, or reused by another socket since the event
+    if(!channel.isActive || channel.generation != generation) {
+        return;
+    }
+
+    // errors and hang-up are reported by the failing operation
+    if(events & (EPOLLIN | EPOLLRDHUP | EPOLLHUP | EPOLLERR)) {
+        channel.isReadable = true;
+        DrainReads(channel, socket, out);
+    }
+    if(events & (EPOLLOUT | EPOLLHUP | EPOLLERR)) {
+        channel.isWritable = true;
+        DrainWrites(channel, socket, out);
+    }
+}
+
+void EpollPort::Push(const std::vector<Completion>& completions)
+{
+    if(completions.empty()) {
+        return;
+    }
+
+    {
+        LockGuard::Scoped guard(queueLock);
+        queue.insert(queue.end(), completions.begin(), completions.end());
+        queued.fetch_add(completions.size(), std::memory_order_release);
+    }
+
+    // one wakeup: the woken thread wakes the next while the queue is not empty
+    Wake();
+}
+
+bool EpollPort::Pop(Completion& completion)
+{
+    if(queued.load(std::memory_order_acquire) == 0) {
+        return false;
+    }
+
+    bool isMore;
+    {
+        LockGuard::Scoped guard(queueLock);
+        if(head == queue.size()) {
+            return false;
+        }
+
+        completion = queue[head++];
+
+        // keep the capacity: no allocation per completion in steady state
+        if(head == queue.size()) {
+            queue.clear();
+            head = 0;
+        }
+        else if(head >= COMPACT && head * 2 >= queue.size()) {
+            queue.erase(queue.begin(), queue.begin() + head);
+            head = 0;
+        }
+        isMore = queued.fetch_sub(1, std::memory_order_relaxed) > 1;
+    }
+
+    if(isMore) {
+        Wake();
+    }
+    return true;
+}
+
+void EpollPort::Wake()
+{
+    uint64_t value = 1;
+    if(write(event, &value, sizeof(value)) < 0) {
+        pass;
+    }
+}
+
+#endif
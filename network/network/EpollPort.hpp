@@ -0,0 +1,173 @@
+/**
+ * @file    EpollPort.hpp
+ * @author  LaverWinEmpty@google.com
+ * @brief   completion port on epoll
+ * @version 0.0.1
+ * @date    2026-10-17
+ *
+ * @copyright Copyright (c) 2023
+ *
+ */
+
+#ifndef LWE__EPOLLPORT_HPP__
+#define LWE__EPOLLPORT_HPP__
+
+#if __linux__
+
+#    include "vector"
+#    include "CompletionPort.hpp"
+#    include "../../utilities/utilities/LockGuard.hpp"
+
+/**
+ * @brief completion port emulated on edge-triggered epoll
+ * @note  operations are performed by the thread that sees readiness, result is queued as completion
+ *        no poller thread: Dequeue() callers wait on epoll_wait() themselves, like IOCP workers
+ *        Recv() / Send() / Accept(): tried at once when the socket is ready, queued otherwise
+ *        socket state: indexed by descriptor, generation checked against stale events after reuse
+ */
+class EpollPort: public CompletionPort
+{
+public:
+    /**
+     * @brief READONLY: default max descriptor
+     */
+    static const size_t DEF_CAPACITY;
+
+    /**
+     * @brief READONLY: events per epoll_wait()
+     */
+    static const int EVENTS = 64;
+
+    /**
+     * @brief READONLY: consumed completions that trigger compaction of the queue
+     */
+    static const size_t COMPACT = 1024;
+
+public:
+    /**
+     * @brief Construct a new EpollPort object
+     * @throw std::runtime_error epoll / eventfd failed
+     *
+     * @param capacity [in] descriptor limit, socket >= capacity is not associable
+     */
+    EpollPort(IN size_t capacity = DEF_CAPACITY);
+
+    /**
+     * @brief Destroy the EpollPort object, stop workers, pending operations are discarded
+     */
+    ~EpollPort() override;
+
+public:
+    DECLARE_NO_COPY(EpollPort);
+
+public:
+    bool Associate(IN Socket socket, IN uint64_t key) override;
+    bool Dissociate(IN Socket socket) override;
+    bool Recv(IN Socket socket, IN Overlapped* overlapped) override;
+    bool Send(IN Socket socket, IN Overlapped* overlapped) override;
+    bool Accept(IN Socket listener, IN Overlapped* overlapped) override;
+    bool Post(IN uint64_t key, IN Overlapped* overlapped = nullptr, IN size_t bytes = 0) override;
+    bool Dequeue(OUT Completion& completion, IN int timeout = INFINITE_WAIT) override;
+
+private:
+    /**
+     * @brief per-socket state
+     */
+    struct Channel
+    {
+        LockGuard::WrappedAdaptive lock;
+
+        uint64_t key        = 0;
+        uint32_t generation = 0;
+        bool     isActive   = false;
+        bool     isReadable = false; // false: wait for EPOLLIN
+        bool     isWritable = false; // false: wait for EPOLLOUT
+        Pending  reads;              // RECV / ACCEPT
+        Pending  writes;             // SEND
+    };
+
+    /**
+     * @brief operation result
+     */
+    enum EResult
+    {
+        DONE,  // completed, succeeded or failed
+        AGAIN, // not ready
+        MORE,  // partially sent
+    };
+
+private:
+    /**
+     * @brief check associated and queue operation, try at once if nothing is pending
+     *
+     * @param socket     [in]
+     * @param overlapped [in]
+     * @param operation  [in]
+     * @return true: accepted / false: not associated (EBADF)
+     */
+    bool Issue(IN Socket socket, IN Overlapped* overlapped, IN Overlapped::EOperation operation);
+
+    /**
+     * @brief perform pending operations while ready, under channel lock
+     *
+     * @param channel [in, out]
+     * @param socket  [in]
+     * @param out     [out] completions
+     */
+    void DrainReads(IN OUT Channel& channel, IN Socket socket, OUT std::vector<Completion>& out);
+    void DrainWrites(IN OUT Channel& channel, IN Socket socket, OUT std::vector<Completion>& out);
+
+    /**
+     * @brief non-blocking syscall for the operation
+     *
+     * @param socket     [in]
+     * @param overlapped [in, out]
+     * @param error      [out] errno
+     * @return EResult
+     */
+    static EResult Perform(IN Socket socket, IN OUT Overlapped* overlapped, OUT int& error);
+
+    /**
+     * @brief handle epoll event
+     *
+     * @param data   [in] epoll_event::data.u64
+     * @param events [in] epoll_event::events
+     * @param out    [out] completions
+     */
+    void Handle(IN uint64_t data, IN uint32_t events, OUT std::vector<Completion>& out);
+
+    /**
+     * @brief queue completions and wake a waiter
+     *
+     * @param completions [in]
+     */
+    void Push(IN const std::vector<Completion>& completions);
+
+    /**
+     * @brief pop queued completion
+     *
+     * @param completion [out]
+     * @return true: popped / false: empty
+     */
+    bool Pop(OUT Completion& completion);
+
+    /**
+     * @brief wake one epoll_wait() caller
+     */
+    void Wake();
+
+private:
+    int epoll;
+    int event; // eventfd, Post() wakeup
+
+    Channel* channels;
+    size_t   capacity;
+
+    std::vector<Completion>    queue; // consumed from head
+    size_t                     head;
+    std::atomic<size_t>        queued;
+    LockGuard::WrappedAdaptive queueLock;
+};
+
+#endif
+#endif
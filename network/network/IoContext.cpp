@@ -0,0 +1,34 @@
+#include "IoContext.hpp"
+
+IoContext::IoContext(void* session): session(session)
+{
+    buffer = data;
+    length = BUFFER_SIZE;
+}
+
+IoContext* IoContext::Acquire(void* session)
+{
+    return Pool().New(session);
+}
+
+void IoContext::Release(IoContext* context)
+{
+    Pool().Delete(context);
+}
+
+void IoContext::Reserve(size_t count)
+{
+    Pool().Reserve(count);
+}
+
+SlabAllocator::Stats IoContext::GetStats()
+{
+    return Pool().GetStats();
+}
+
+SlabPool<IoContext>& IoContext::Pool()
+{
+    // never destroyed: contexts may be released by threads still running at exit
+    static SlabPool<IoContext>* pool = new SlabPool<IoContext>();
+    return *pool;
+}
@@ -0,0 +1,75 @@
+/**
+ * @file    IoContext.hpp
+ * @author  LaverWinEmpty@google.com
+ * @brief   pooled per-operation context
+ * @version 0.0.1
+ * @date    2026-10-17
+ *
+ * @copyright Copyright (c) 2023
+ *
+ */
+
+#ifndef LWE__IOCONTEXT_HPP__
+#define LWE__IOCONTEXT_HPP__
+
+#include "CompletionPort.hpp"
+#include "../../memory/memory/SlabPool.hpp"
+
+/**
+ * @brief Overlapped with inline buffer and owner, from a process wide slab pool
+ * @note  Acquire() / Release(): no heap allocation in steady state, any thread
+ *        (e.g. IoContext* context = IoContext::Acquire(session); port->Recv(socket, context);
+ *              ... on completion: IoContext::Release(context);)
+ */
+struct IoContext: Overlapped
+{
+    /**
+     * @brief READONLY: inline buffer size
+     */
+    static const size_t BUFFER_SIZE = DEF_BUF_SIZE;
+
+    /**
+     * @brief Construct a new IoContext object, buffer is not initialized
+     *
+     * @param session [in] owner
+     */
+    IoContext(IN void* session = nullptr);
+
+    /**
+     * @brief get context, buffer / length point to the inline buffer
+     * @throw std::bad_alloc
+     *
+     * @param session [in] owner
+     * @return IoContext*
+     */
+    static IoContext* Acquire(IN void* session = nullptr);
+
+    /**
+     * @brief return context
+     *
+     * @param context [in] from Acquire(), nullable
+     */
+    static void Release(IN IoContext* context);
+
+    /**
+     * @brief carve contexts in advance, refer to SlabAllocator::Reserve()
+     *
+     * @param count [in] total capacity to reach
+     */
+    static void Reserve(IN size_t count);
+
+    /**
+     * @brief pool counters
+     *
+     * @return SlabAllocator::Stats
+     */
+    static SlabAllocator::Stats GetStats();
+
+    void* session;
+    char  data[BUFFER_SIZE];
+
+private:
+    static SlabPool<IoContext>& Pool();
+};
+
+#endif
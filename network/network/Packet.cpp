@@ -0,0 +1,238 @@
+#include "Packet.hpp"
+
+const size_t PacketFramer::FIXED_HEADER = sizeof(uint32_t) + sizeof(uint16_t);
+const size_t PacketFramer::MAX_HEADER   = 8; // varint: 5 size + 3 id
+const size_t PacketFramer::DEF_MAX_SIZE = 1 << 20;
+
+/**
+ * @brief max LEB128 bytes of a 32 bit size / 16 bit id
+ */
+static const size_t VARINT_SIZE = 5;
+static const size_t VARINT_ID   = 3;
+
+Packet::Packet(): stream(nullptr), data(nullptr), offset(0), size(0), id(0) {}
+
+size_t Packet::Read(void* data, size_t size, size_t offset) const
+{
+    if(stream == nullptr || offset >= this->size) {
+        return 0;
+    }
+    return stream->Read(data, MIN(size, this->size - offset), this->offset + offset);
+}
+
+BufferRef Packet::Contiguous() const
+{
+    if(stream == nullptr || size == 0) {
+        return BufferRef();
+    }
+
+    // in one chunk: share it
+    if(data) {
+        return (*stream)[0].Slice(offset, size);
+    }
+
+    BufferRef result(size);
+    stream->Read(result.GetData(), size, offset);
+    result.Truncate(size);
+    return result;
+}
+
+BufferChain Packet::Slice() const
+{
+    if(stream == nullptr) {
+        return BufferChain();
+    }
+    return stream->Slice(offset, size);
+}
+
+PacketFramer::PacketFramer(EPrefix prefix, size_t maxSize):
+    maxSize(MIN(maxSize, static_cast<size_t>(UINT32_MAX))), current(0), error(0), prefix(prefix)
+{
+}
+
+void PacketFramer::Append(const BufferRef& ref)
+{
+    stream.Append(ref);
+}
+
+void PacketFramer::Append(BufferRef&& ref)
+{
+    stream.Append(std::move(ref));
+}
+
+bool PacketFramer::Next(Packet& packet)
+{
+    if(error) {
+        return false;
+    }
+
+    size_t available = stream.GetSize();
+    if(available == 0) {
+        return false;
+    }
+
+    // header in place, copied only when it spans chunks
+    uint8_t        copy[MAX_HEADER];
+    const uint8_t* header = nullptr;
+    size_t         count  = MIN(available, MAX_HEADER);
+
+    const BufferRef& front = stream[0];
+    if(front.GetSize() >= count) {
+        header = reinterpret_cast<const uint8_t*>(front.GetData());
+    }
+    else {
+        stream.Read(copy, count);
+        header = copy;
+    }
+
+    uint32_t size = 0;
+    uint32_t id   = 0;
+    size_t   used = 0;
+
+    if(prefix == FIXED) {
+        if(count < FIXED_HEADER) {
+            return false;
+        }
+
+        uint16_t type;
+        memcpy(&size, header, sizeof(size));
+        memcpy(&type, header + sizeof(size), sizeof(type));
+
+        // wire is little endian, folded at compile time
+        if(!CHECK_LITTLE_ENDIAN()) {
+            size = REVERSE_ENDIAN_32(size);
+            type = static_cast<uint16_t>(REVERSE_ENDIAN_16(type));
+        }
+        id   = type;
+        used = FIXED_HEADER;
+    }
+    else {
+        int length = Varint(header, count, VARINT_SIZE, size);
+        if(length <= 0) {
+            if(length < 0) {
+                Break(EBADMSG);
+            }
+            return false;
+        }
+
+        int type = Varint(header + length, count - length, VARINT_ID, id);
+        if(type == 0) {
+            return false;
+        }
+        if(type < 0 || id > UINT16_MAX) {
+            Break(EBADMSG);
+            return false;
+        }
+        used = static_cast<size_t>(length + type);
+    }
+
+    if(size > maxSize) {
+        Break(EMSGSIZE);
+        return false;
+    }
+    if(available < used + size) {
+        return false;
+    }
+
+    packet.stream = &stream;
+    packet.offset = static_cast<uint32_t>(used);
+    packet.size   = size;
+    packet.id     = static_cast<uint16_t>(id);
+    packet.data   = front.GetSize() >= used + size ? front.GetData() + used : nullptr;
+
+    current = used + size;
+    return true;
+}
+
+void PacketFramer::Pop()
+{
+    stream.Consume(current);
+    current = 0;
+}
+
+void PacketFramer::Write(BufferChain& out, uint16_t id, const void* data, size_t size) const
+{
+    uint8_t header[MAX_HEADER];
+    out.Write(header, Header(header, id, size));
+    out.Write(data, size);
+}
+
+void PacketFramer::Write(BufferChain& out, uint16_t id, const BufferChain& body) const
+{
+    uint8_t header[MAX_HEADER];
+    out.Write(header, Header(header, id, body.GetSize()));
+    out.Append(body);
+}
+
+bool PacketFramer::IsBroken() const
+{
+    return error != 0;
+}
+
+int PacketFramer::GetError() const
+{
+    return error;
+}
+
+size_t PacketFramer::GetSize() const
+{
+    return stream.GetSize();
+}
+
+size_t PacketFramer::Header(uint8_t* header, uint16_t id, size_t size) const
+{
+    uint32_t length = static_cast<uint32_t>(size);
+
+    if(prefix == FIXED) {
+        uint16_t type = id;
+        if(!CHECK_LITTLE_ENDIAN()) {
+            length = REVERSE_ENDIAN_32(length);
+            type   = static_cast<uint16_t>(REVERSE_ENDIAN_16(type));
+        }
+        memcpy(header, &length, sizeof(length));
+        memcpy(header + sizeof(length), &type, sizeof(type));
+        return FIXED_HEADER;
+    }
+
+    size_t used = 0;
+    do {
+        header[used++] = static_cast<uint8_t>((length & 0x7F) | (length > 0x7F ? 0x80 : 0));
+        length >>= 7;
+    } while(length);
+
+    uint32_t type = id;
+    do {
+        header[used++] = static_cast<uint8_t>((type & 0x7F) | (type > 0x7F ? 0x80 : 0));
+        type >>= 7;
+    } while(type);
+
+    return used;
+}
+
+int PacketFramer::Varint(const uint8_t* source, size_t count, size_t limit, uint32_t& value)
+{
+    uint64_t result = 0;
+
+    for(size_t i = 0; i < limit; ++i) {
+        if(i == count) {
+            return 0;
+        }
+
+        result |= static_cast<uint64_t>(source[i] & 0x7F) << (7 * i);
+        if((source[i] & 0x80) == 0) {
+            if(result > UINT32_MAX) {
+                return -1;
+            }
+            value = static_cast<uint32_t>(result);
+            return static_cast<int>(i + 1);
+        }
+    }
+    return -1;
+}
+
+void PacketFramer::Break(int error)
+{
+    this->error = error;
+    stream.Clear();
+    current = 0;
+}
@@ -0,0 +1,299 @@
+/**
+ * @file    Packet.hpp
+ * @author  LaverWinEmpty@google.com
+ * @brief   length prefixed packet framing and dispatch
+ * @version 0.0.1
+ * @date    2026-10-17
+ *
+ * @copyright Copyright (c) 2023
+ *
+ */
+
+#ifndef LWE__PACKET_HPP__
+#define LWE__PACKET_HPP__
+
+#include "array"
+#include "algorithm"
+#include "../../memory/memory/Buffer.hpp"
+
+/**
+ * @brief view of a complete packet body in the receive stream, no copy
+ * @note  valid until PacketFramer::Pop(), Slice() to keep it longer
+ */
+class Packet
+{
+public:
+    /**
+     * @brief empty packet
+     */
+    Packet();
+
+public:
+    /**
+     * @brief copy body bytes out (e.g. fixed layout struct)
+     *
+     * @param data   [out]
+     * @param size   [in]
+     * @param offset [in] from body front
+     * @return size_t copied, less than size if short
+     */
+    size_t Read(OUT void* data, IN size_t size, IN size_t offset = 0) const;
+
+    /**
+     * @brief body as one reference, copied only if it spans chunks
+     * @throw std::bad_alloc
+     *
+     * @return BufferRef
+     */
+    BufferRef Contiguous() const;
+
+    /**
+     * @brief body as a chain, zero-copy, outlives the packet (e.g. relay)
+     *
+     * @return BufferChain
+     */
+    BufferChain Slice() const;
+
+public:
+    uint16_t GetId() const;
+    size_t   GetSize() const;
+
+    /**
+     * @brief get body in place
+     *
+     * @return const char* nullptr: body spans chunks, use Read() / Contiguous()
+     */
+    const char* GetData() const;
+
+private:
+    friend class PacketFramer;
+
+    const BufferChain* stream;
+    const char*        data;
+    uint32_t           offset;
+    uint32_t           size;
+    uint16_t           id;
+};
+
+/**
+ * @brief splits a receive stream into packets, in place
+ * @note  FIXED:  [u32 body size][u16 id][body], little endian on the wire
+ *        VARINT: [LEB128 body size][LEB128 id][body]
+ *        partial frames stay in the stream until the rest is appended
+ *        not thread safe, one per connection
+ */
+class PacketFramer
+{
+public:
+    /**
+     * @brief header layout
+     */
+    enum EPrefix : uint8_t
+    {
+        FIXED,
+        VARINT,
+    };
+
+public:
+    /**
+     * @brief READONLY: FIXED header size
+     */
+    static const size_t FIXED_HEADER;
+
+    /**
+     * @brief READONLY: max header size of both layouts
+     */
+    static const size_t MAX_HEADER;
+
+    /**
+     * @brief READONLY: default max body size
+     */
+    static const size_t DEF_MAX_SIZE;
+
+public:
+    /**
+     * @brief Construct a new PacketFramer object
+     *
+     * @param prefix  [in]
+     * @param maxSize [in] larger body breaks the stream (EMSGSIZE)
+     */
+    PacketFramer(IN EPrefix prefix = FIXED, IN size_t maxSize = DEF_MAX_SIZE);
+
+public:
+    /**
+     * @brief append received bytes (e.g. recv target truncated to received size)
+     *
+     * @param BufferRef [in]
+     */
+    void Append(IN const BufferRef&);
+    void Append(IN BufferRef&&);
+
+    /**
+     * @brief parse front packet, does not consume it (called again: same packet)
+     *
+     * @param packet [out] valid until Pop()
+     * @return true: complete / false: partial or broken
+     */
+    bool Next(OUT Packet& packet);
+
+    /**
+     * @brief consume the packet of the last Next()
+     */
+    void Pop();
+
+    /**
+     * @brief dispatch all complete packets
+     * @note  unknown id breaks the stream (ENOMSG)
+     *
+     * @tparam Table   PacketTable
+     * @tparam Context
+     * @param context [in] handler argument (e.g. Session)
+     * @return size_t dispatched count, check IsBroken()
+     */
+    template<typename Table, typename Context> size_t Dispatch(IN Context& context);
+
+public:
+    /**
+     * @brief append header and body
+     * @throw std::bad_alloc
+     *
+     * @param out  [out]
+     * @param id   [in]
+     * @param data [in]
+     * @param size [in] <= max size
+     */
+    void Write(OUT BufferChain& out, IN uint16_t id, IN const void* data, IN size_t size) const;
+
+    /**
+     * @brief append header and body, body is shared (zero-copy)
+     * @throw std::bad_alloc
+     *
+     * @param out  [out]
+     * @param id   [in]
+     * @param body [in] size <= max size
+     */
+    void Write(OUT BufferChain& out, IN uint16_t id, IN const BufferChain& body) const;
+
+public:
+    /**
+     * @brief check framing failed, the stream is not recoverable
+     */
+    bool IsBroken() const;
+
+    /**
+     * @brief get failure reason
+     *
+     * @return int 0 / EMSGSIZE: too large / EBADMSG: malformed header / ENOMSG: unknown id
+     */
+    int GetError() const;
+
+    /**
+     * @brief buffered bytes (e.g. partial frame)
+     */
+    size_t GetSize() const;
+
+private:
+    /**
+     * @brief build header
+     *
+     * @param header [out] MAX_HEADER bytes
+     * @param id     [in]
+     * @param size   [in]
+     * @return size_t header size
+     */
+    size_t Header(OUT uint8_t* header, IN uint16_t id, IN size_t size) const;
+
+    /**
+     * @brief decode LEB128
+     *
+     * @param source [in]
+     * @param count  [in] available bytes
+     * @param limit  [in] max encoded bytes
+     * @param value  [out]
+     * @return int used bytes / 0: partial / -1: malformed
+     */
+    static int Varint(IN const uint8_t* source, IN size_t count, IN size_t limit, OUT uint32_t& value);
+
+    /**
+     * @brief stop parsing
+     *
+     * @param error [in]
+     */
+    void Break(IN int error);
+
+private:
+    BufferChain stream;
+    size_t      maxSize;
+    size_t      current; // bytes of the parsed packet, consumed by Pop()
+    int         error;
+    EPrefix     prefix;
+};
+
+/**
+ * @brief route of PacketTable
+ *
+ * @tparam ID
+ * @tparam HANDLER void (*)(Context&, const Packet&)
+ */
+template<uint16_t ID, auto HANDLER> struct PacketRoute
+{
+    static constexpr uint16_t id      = ID;
+    static constexpr auto     handler = HANDLER;
+};
+
+/**
+ * @brief STATIC: id to handler array built at compile time
+ * @note  Dispatch(): one bounds check and one indirect call, no map lookup
+ *        (e.g. using Table = PacketTable<Session, PacketRoute<1, &OnLogin>, PacketRoute<2, &OnChat>>;
+ *              framer.Dispatch<Table>(session);)
+ *
+ * @tparam Context handler argument
+ * @tparam Routes  PacketRoute, ids must be unique
+ */
+template<typename Context, typename... Routes> class PacketTable
+{
+public:
+    DECLARE_LIMIT_LIFECYCLE(PacketTable);
+
+public:
+    using Handler = void (*)(Context&, const Packet&);
+
+    static_assert(sizeof...(Routes) > 0, "packet table needs a route");
+
+    /**
+     * @brief READONLY: max id + 1
+     */
+    static constexpr size_t SIZE = std::max({ static_cast<size_t>(Routes::id)... }) + 1;
+
+public:
+    /**
+     * @brief call the handler of the packet id
+     *
+     * @param context [in]
+     * @param packet  [in]
+     * @return true: handled / false: unknown id
+     */
+    static bool Dispatch(IN Context& context, IN const Packet& packet);
+
+private:
+    /**
+     * @brief fill table
+     */
+    static constexpr std::array<Handler, SIZE> Build();
+
+    /**
+     * @brief check unique ids
+     */
+    static constexpr bool IsUnique();
+
+private:
+    static_assert(IsUnique(), "duplicate packet id");
+
+    /**
+     * @brief READONLY: handlers, nullptr: unknown
+     */
+    static constexpr std::array<Handler, SIZE> TABLE = Build();
+};
+
+#include "Packet.ipp"
+#endif
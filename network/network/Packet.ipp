@@ -0,0 +1,65 @@
+inline uint16_t Packet::GetId() const
+{
+    return id;
+}
+
+inline size_t Packet::GetSize() const
+{
+    return size;
+}
+
+inline const char* Packet::GetData() const
+{
+    return data;
+}
+
+template<typename Table, typename Context> size_t PacketFramer::Dispatch(Context& context)
+{
+    size_t count = 0;
+    Packet packet;
+
+    while(Next(packet)) {
+        bool isHandled = Table::Dispatch(context, packet);
+        Pop();
+
+        if(!isHandled) {
+            Break(ENOMSG);
+            break;
+        }
+        ++count;
+    }
+    return count;
+}
+
+template<typename Context, typename... Routes>
+bool PacketTable<Context, Routes...>::Dispatch(Context& context, const Packet& packet)
+{
+    size_t id = packet.GetId();
+    if(id >= SIZE || TABLE[id] == nullptr) {
+        return false;
+    }
+    TABLE[id](context, packet);
+    return true;
+}
+
+template<typename Context, typename... Routes>
+constexpr std::array<typename PacketTable<Context, Routes...>::Handler, PacketTable<Context, Routes...>::SIZE>
+PacketTable<Context, Routes...>::Build()
+{
+    std::array<Handler, SIZE> table{};
+    ((table[Routes::id] = static_cast<Handler>(Routes::handler)), ...);
+    return table;
+}
+
+template<typename Context, typename... Routes> constexpr bool PacketTable<Context, Routes...>::IsUnique()
+{
+    constexpr uint16_t ids[] = { Routes::id... };
+    for(size_t i = 0; i < sizeof...(Routes); ++i) {
+        for(size_t j = i + 1; j < sizeof...(Routes); ++j) {
+            if(ids[i] == ids[j]) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
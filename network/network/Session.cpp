@@ -0,0 +1,306 @@
+#include "Session.hpp"
+#include "climits"
+
+#ifdef IOV_MAX
+const uint32_t Session::MAX_SEGMENTS = IOV_MAX;
+#else
+const uint32_t Session::MAX_SEGMENTS = 1024;
+#endif
+
+const size_t Session::DEF_BATCH_BYTES = 64 << 10;
+
+/**
+ * @brief queue nodes of all sessions
+ */
+template<typename Node> static SlabPool<Node>& Nodes()
+{
+    // never destroyed: sessions may be destroyed by threads still running at exit
+    static SlabPool<Node>* pool = new SlabPool<Node>();
+    return *pool;
+}
+
+Session::Session(CompletionPort* port, Socket socket, TimerWheel* wheel):
+    port(port), socket(socket), wheel(wheel), batchBytes(DEF_BATCH_BYTES), segments(MAX_SEGMENTS), delay(0),
+    head(&stub), queued(0), messages(0), isSending(false), isScheduled(false), isBroken(false), tail(&stub),
+    timer(TimerWheel::INVALID), sends(0)
+{
+    stub.next.store(nullptr, std::memory_order_relaxed);
+}
+
+Session::~Session()
+{
+    if(wheel) {
+        TimerWheel::Handle handle;
+        {
+            LockGuard::Scoped guard(timerLock);
+            handle = timer;
+        }
+
+        // OnTimer() running on the ticking thread returns first, collected one is skipped
+        wheel->Cancel(handle, true);
+    }
+    Discard();
+}
+
+void Session::SetBatch(size_t bytes, uint32_t segments)
+{
+    batchBytes     = MAX(bytes, static_cast<size_t>(1));
+    this->segments = MAX(MIN(segments, MAX_SEGMENTS), 1u);
+}
+
+void Session::SetDelay(std::chrono::microseconds delay)
+{
+    this->delay = delay;
+}
+
+bool Session::Send(const BufferRef& message)
+{
+    if(isBroken.load(std::memory_order_relaxed)) {
+        return false;
+    }
+    if(message.IsEmpty()) {
+        return true;
+    }
+
+    Node* node = Nodes<Node>().New();
+    node->ref  = message;
+    Push(node, node);
+    Kick(message.GetSize());
+    return true;
+}
+
+bool Session::Send(const BufferChain& message)
+{
+    if(isBroken.load(std::memory_order_relaxed)) {
+        return false;
+    }
+    if(message.IsEmpty()) {
+        return true;
+    }
+
+    // linked first: one push keeps the message contiguous among other producers
+    Node* first = nullptr;
+    Node* last  = nullptr;
+    for(size_t i = 0; i < message.GetCount(); ++i) {
+        Node* node = Nodes<Node>().New();
+        node->ref  = message[i];
+        node->next.store(nullptr, std::memory_order_relaxed);
+
+        if(last) {
+            last->next.store(node, std::memory_order_relaxed);
+        }
+        else {
+            first = node;
+        }
+        last = node;
+    }
+
+    Push(first, last);
+    Kick(message.GetSize());
+    return true;
+}
+
+void Session::Flush()
+{
+    if(isBroken.load(std::memory_order_relaxed)) {
+        return;
+    }
+    if(queued.load(std::memory_order_seq_cst)) {
+        TryFlush();
+    }
+}
+
+bool Session::OnSend(const Completion& completion)
+{
+    if(completion.overlapped != &context) {
+        return false;
+    }
+
+    if(completion.error) {
+        isBroken.store(true, std::memory_order_relaxed);
+        Discard();
+        isSending.store(false, std::memory_order_seq_cst);
+        return true;
+    }
+
+    batch.Consume(completion.bytes);
+    Transmit();
+    return true;
+}
+
+Socket Session::GetSocket() const
+{
+    return socket;
+}
+
+bool Session::IsBroken() const
+{
+    return isBroken.load(std::memory_order_relaxed);
+}
+
+uint64_t Session::GetSendCount() const
+{
+    return sends.load(std::memory_order_relaxed);
+}
+
+uint64_t Session::GetMessageCount() const
+{
+    return messages.load(std::memory_order_relaxed);
+}
+
+void Session::Push(Node* first, Node* last)
+{
+    last->next.store(nullptr, std::memory_order_relaxed);
+    Node* previous = head.exchange(last, std::memory_order_acq_rel);
+    previous->next.store(first, std::memory_order_release);
+}
+
+Session::Node* Session::Pop()
+{
+    Node* node = tail;
+    Node* next = node->next.load(std::memory_order_acquire);
+
+    if(node == &stub) {
+        if(next == nullptr) {
+            return nullptr;
+        }
+        tail = next;
+        node = next;
+        next = next->next.load(std::memory_order_acquire);
+    }
+
+    if(next) {
+        tail = next;
+        return node;
+    }
+
+    // producer between exchange and link
+    if(node != head.load(std::memory_order_acquire)) {
+        return nullptr;
+    }
+
+    // last node: put the stub behind it to detach
+    Push(&stub, &stub);
+    next = node->next.load(std::memory_order_acquire);
+    if(next) {
+        tail = next;
+        return node;
+    }
+    return nullptr;
+}
+
+void Session::TryFlush()
+{
+    if(!isSending.exchange(true, std::memory_order_acq_rel)) {
+        Transmit();
+    }
+}
+
+void Session::Transmit()
+{
+    while(true) {
+        // a Send() that passed the check before the break: drop it, nothing more goes out
+        if(isBroken.load(std::memory_order_relaxed)) {
+            Discard();
+            isSending.store(false, std::memory_order_seq_cst);
+            return;
+        }
+
+        while(batch.GetSize() < batchBytes) {
+            Node* node = Pop();
+            if(node == nullptr) {
+                break;
+            }
+
+            queued.fetch_sub(node->ref.GetSize(), std::memory_order_relaxed);
+            batch.Append(std::move(node->ref));
+            Nodes<Node>().Delete(node);
+        }
+
+        if(!batch.IsEmpty()) {
+            // sized on the first send: idle sessions hold no gather list
+            if(vectors.size() < segments) {
+                vectors.resize(segments);
+            }
+
+            context.vectors = vectors.data();
+            context.count   = static_cast<uint32_t>(batch.Gather(vectors.data(), segments));
+            context.length  = 0;
+            for(uint32_t i = 0; i < context.count; ++i) {
+                context.length += vectors[i].iov_len;
+            }
+
+            sends.fetch_add(1, std::memory_order_relaxed);
+            if(!port->Send(socket, &context)) {
+                isBroken.store(true, std::memory_order_relaxed);
+                Discard();
+                isSending.store(false, std::memory_order_seq_cst);
+            }
+            return;
+        }
+
+        // release, then recheck: a producer that saw the send in flight relies on this
+        isSending.store(false, std::memory_order_seq_cst);
+        if(queued.load(std::memory_order_seq_cst) == 0 || isSending.exchange(true, std::memory_order_acq_rel)) {
+            return;
+        }
+    }
+}
+
+void Session::Kick(size_t bytes)
+{
+    messages.fetch_add(1, std::memory_order_relaxed);
+    size_t total = queued.fetch_add(bytes, std::memory_order_seq_cst) + bytes;
+
+    // in flight: its completion takes the queue
+    if(isSending.load(std::memory_order_seq_cst)) {
+        return;
+    }
+
+    if(wheel == nullptr || delay.count() == 0 || total >= batchBytes) {
+        TryFlush();
+        return;
+    }
+
+    // scheduled: OnTimer() rechecks queued after releasing
+    if(isScheduled.load(std::memory_order_seq_cst)) {
+        return;
+    }
+
+    // flag and handle together: OnTimer() of the previous timer may still be running on the ticking thread
+    LockGuard::Scoped guard(timerLock);
+    if(!isScheduled.load(std::memory_order_relaxed)) {
+        timer = wheel->Add(delay, &Session::OnTimer, this);
+        isScheduled.store(true, std::memory_order_seq_cst);
+    }
+}
+
+void Session::Discard()
+{
+    batch.Clear();
+    while(Node* node = Pop()) {
+        queued.fetch_sub(node->ref.GetSize(), std::memory_order_relaxed);
+        Nodes<Node>().Delete(node);
+    }
+}
+
+void Session::OnTimer(void* context)
+{
+    Session* session = static_cast<Session*>(context);
+
+    // scheduled until the last access: no other timer of this session while running, ~Session() waits for this one
+    while(true) {
+        session->Flush();
+
+        LockGuard::Scoped guard(session->timerLock);
+        session->isScheduled.store(false, std::memory_order_seq_cst);
+
+        // queued after Flush() by a Kick() that saw this timer: flush again, in flight: its completion takes it
+        // broken: nothing is sent, ~Session() drops the rest
+        if(session->queued.load(std::memory_order_seq_cst) == 0 || session->isSending.load(std::memory_order_seq_cst) ||
+           session->isBroken.load(std::memory_order_relaxed)) {
+            return;
+        }
+        session->isScheduled.store(true, std::memory_order_relaxed);
+    }
+}
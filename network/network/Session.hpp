@@ -0,0 +1,208 @@
+/**
+ * @file    Session.hpp
+ * @author  LaverWinEmpty@google.com
+ * @brief   connection with coalescing send queue
+ * @version 0.0.1
+ * @date    2026-10-17
+ *
+ * @copyright Copyright (c) 2023
+ *
+ */
+
+#ifndef LWE__SESSION_HPP__
+#define LWE__SESSION_HPP__
+
+#include "atomic"
+#include "chrono"
+#include "vector"
+#include "CompletionPort.hpp"
+#include "../../memory/memory/Buffer.hpp"
+#include "../../memory/memory/SlabPool.hpp"
+#include "../../utilities/utilities/TimerWheel.hpp"
+
+/**
+ * @brief associated socket with send coalescing
+ * @note  Send(): lock-free enqueue from any thread, no syscall while a send is in flight
+ *        one send in flight: queued messages are gathered into one vectored send (max MAX_SEGMENTS)
+ *        delay: Nagle-like, small messages wait up to the delay on the wheel unless batch bytes are reached
+ *        the completion handler passes completions of the session key to OnSend() first
+ *        (e.g. Session* session = sessions[completion.key]; if(session->OnSend(completion)) return;)
+ * @warning keep alive until the in flight send completes
+ */
+class Session
+{
+public:
+    /**
+     * @brief READONLY: max gather segments per send (IOV_MAX)
+     */
+    static const uint32_t MAX_SEGMENTS;
+
+    /**
+     * @brief READONLY: default max bytes per send
+     */
+    static const size_t DEF_BATCH_BYTES;
+
+public:
+    /**
+     * @brief Construct a new Session object
+     *
+     * @param port   [in] socket is associated by the caller
+     * @param socket [in]
+     * @param wheel  [in] for the delay, nullptr: no delay, caller advances it
+     */
+    Session(IN CompletionPort* port, IN Socket socket, IN TimerWheel* wheel = nullptr);
+
+    /**
+     * @brief Destroy the Session object, unsent messages are discarded
+     * @note  cancels the delay timer and waits for its callback running on the ticking thread
+     * @warning not from the delay callback of this session
+     */
+    ~Session();
+
+public:
+    DECLARE_NO_COPY(Session);
+
+public:
+    /**
+     * @brief set batch limits
+     *
+     * @param bytes    [in] flush at once when queued bytes reach, max bytes per send (approximately)
+     * @param segments [in] max gather segments per send, clamped to MAX_SEGMENTS, allocated by the next send
+     */
+    void SetBatch(IN size_t bytes, IN uint32_t segments = MAX_SEGMENTS);
+
+    /**
+     * @brief set Nagle-like delay
+     *
+     * @param delay [in] 0: flush at once
+     */
+    void SetDelay(IN std::chrono::microseconds delay);
+
+public:
+    /**
+     * @brief queue message, zero-copy / lock-free
+     *
+     * @param message [in] shared with the caller
+     * @return true: queued / false: broken
+     */
+    bool Send(IN const BufferRef& message);
+    bool Send(IN const BufferChain& message);
+
+    /**
+     * @brief send queued messages now (e.g. end of a tick), nothing when broken
+     */
+    void Flush();
+
+    /**
+     * @brief handle SEND completion of this session, continue with queued messages
+     *
+     * @param completion [in]
+     * @return true: handled / false: not the send of this session
+     */
+    bool OnSend(IN const Completion& completion);
+
+public:
+    Socket GetSocket() const;
+
+    /**
+     * @brief check send failed (e.g. peer closed), further Send() returns false
+     */
+    bool IsBroken() const;
+
+    /**
+     * @brief issued sends, compare with GetMessageCount() for coalescing ratio
+     */
+    uint64_t GetSendCount() const;
+
+    /**
+     * @brief queued messages
+     */
+    uint64_t GetMessageCount() const;
+
+private:
+    /**
+     * @brief queue node
+     */
+    struct Node
+    {
+        std::atomic<Node*> next;
+        BufferRef          ref;
+    };
+
+private:
+    /**
+     * @brief push linked nodes (Vyukov MPSC)
+     *
+     * @param first [in]
+     * @param last  [in]
+     */
+    void Push(IN Node* first, IN Node* last);
+
+    /**
+     * @brief pop node, owner of the send only
+     *
+     * @return Node* nullptr: empty or push in progress
+     */
+    Node* Pop();
+
+    /**
+     * @brief take the send if not in flight and transmit
+     */
+    void TryFlush();
+
+    /**
+     * @brief gather queue into batch and send, release the send if nothing to send
+     */
+    void Transmit();
+
+    /**
+     * @brief after enqueue: flush, schedule, or leave to the in flight send
+     *
+     * @param bytes [in] enqueued
+     */
+    void Kick(IN size_t bytes);
+
+    /**
+     * @brief discard batch and queue, dropped bytes leave queued
+     */
+    void Discard();
+
+    /**
+     * @brief delay timer callback
+     *
+     * @param context [in] Session*
+     */
+    static void OnTimer(IN void* context);
+
+private:
+    CompletionPort* port;
+    Socket          socket;
+    TimerWheel*     wheel;
+
+    size_t                   batchBytes;
+    uint32_t                 segments;
+    std::chrono::nanoseconds delay;
+
+    // producers
+    alignas(CACHE_LINE_SIZE) std::atomic<Node*> head;
+    std::atomic<size_t>   queued; // bytes
+    std::atomic<uint64_t> messages;
+
+    // send owner
+    alignas(CACHE_LINE_SIZE) std::atomic<bool> isSending;
+    std::atomic<bool>  isScheduled;
+    std::atomic<bool>  isBroken;
+    Node*              tail;
+    Node               stub;
+    BufferChain        batch;
+    std::vector<iovec> vectors;
+    Overlapped         context;
+
+    // delay timer
+    LockGuard::WrappedSpin timerLock;
+    TimerWheel::Handle     timer; // timerLock, last scheduled (may be expired), INVALID: never
+
+    std::atomic<uint64_t> sends;
+};
+
+#endif
@@ -0,0 +1,228 @@
+/**
+ * @file    SessionTable.hpp
+ * @author  LaverWinEmpty@google.com
+ * @brief   sharded session registry with generation tagged handles
+ * @version 0.0.1
+ * @date    2026-10-17
+ *
+ * @copyright Copyright (c) 2023
+ *
+ */
+
+#ifndef LWE__SESSIONTABLE_HPP__
+#define LWE__SESSIONTABLE_HPP__
+
+#include "atomic"
+#include "vector"
+#include "utility"
+#include "../../utilities/utilities/LockGuard.hpp"
+
+/**
+ * @brief session registry addressed by 64 bit handle: [generation 32][slot index 32]
+ * @note  Find(): lock-free, a reference keeps the session alive until released
+ *        stale handle (removed / reused slot) is rejected by the generation, no use-after-free
+ *        Insert() / free: lock of one shard, each thread prefers its own shard
+ *        handle fits the completion key (e.g. port->Associate(socket, handle); table.Find(completion.key))
+ *
+ * @tparam T session type
+ * @tparam N shard count, power of 2
+ */
+template<typename T, size_t N = 64> class SessionTable
+{
+    static_assert(N && (N & (N - 1)) == 0, "shard count must be power of 2");
+
+public:
+    using Handle = uint64_t;
+
+    /**
+     * @brief READONLY: invalid handle
+     */
+    static constexpr Handle INVALID = 0;
+
+    /**
+     * @brief READONLY: default max sessions
+     */
+    static constexpr size_t DEF_CAPACITY = 1 << 20;
+
+    /**
+     * @brief READONLY: slots per page, pages are allocated on demand and never moved
+     */
+    static constexpr size_t PAGE_SLOTS = 1024;
+
+public:
+    /**
+     * @brief counted reference, releases on destruction
+     */
+    class Ref
+    {
+    public:
+        Ref();
+        Ref(IN Ref&&) noexcept;
+        Ref& operator=(IN Ref&&) noexcept;
+        ~Ref();
+
+    public:
+        DECLARE_NO_COPY(Ref);
+
+    public:
+        T*   operator->() const;
+        T&   operator*() const;
+        T*   Get() const;
+        explicit operator bool() const;
+
+        /**
+         * @brief release early
+         */
+        void Reset();
+
+    private:
+        friend class SessionTable;
+
+        Ref(IN SessionTable* table, IN Handle handle, IN T* value);
+
+        SessionTable* table;
+        Handle        handle;
+        T*            value;
+    };
+
+public:
+    /**
+     * @brief Construct a new SessionTable object
+     * @throw std::bad_alloc
+     *
+     * @param capacity [in] max sessions, rounded up to shard pages
+     */
+    SessionTable(IN size_t capacity = DEF_CAPACITY);
+
+    /**
+     * @brief Destroy the SessionTable object, remaining sessions are destroyed
+     * @warning no reference may be alive
+     */
+    ~SessionTable();
+
+public:
+    DECLARE_NO_COPY(SessionTable);
+
+public:
+    /**
+     * @brief construct session in a free slot
+     * @throw std::bad_alloc, exception of T constructor
+     *
+     * @param Args [in] constructor arguments
+     * @return Handle INVALID: full
+     */
+    template<typename... Args> Handle Insert(IN Args&&...);
+
+    /**
+     * @brief remove session, destroyed when the last reference is released
+     *
+     * @param handle [in]
+     * @return true: removed / false: stale or already removed
+     */
+    bool Remove(IN Handle handle);
+
+    /**
+     * @brief find session / lock-free
+     *
+     * @param handle [in]
+     * @return Ref empty: stale or removed
+     */
+    Ref Find(IN Handle handle);
+
+    /**
+     * @brief call for each live session (e.g. broadcast, shutdown)
+     * @note  sessions inserted or removed during the call may be skipped
+     *
+     * @tparam Function void(Handle, T&)
+     * @param function [in]
+     */
+    template<typename Function> void ForEach(IN Function&& function);
+
+public:
+    /**
+     * @brief get live session count
+     * @warning approximate value under concurrency
+     */
+    size_t GetSize() const;
+
+    size_t GetCapacity() const;
+
+private:
+    /**
+     * @brief state: [generation 32][live 1][references 31], live holds a reference
+     */
+    struct Slot
+    {
+        std::atomic<uint64_t> state;
+        alignas(T) unsigned char storage[sizeof(T)];
+    };
+
+    /**
+     * @brief slot index = local index * N + shard
+     */
+    struct alignas(CACHE_LINE_SIZE) Shard
+    {
+        LockGuard::WrappedAdaptive lock;
+
+        std::atomic<Slot*>*   pages; // READONLY after construction except published entries
+        std::vector<uint32_t> frees; // local indices
+        uint32_t              used;  // local indices handed out once
+        std::atomic<size_t>   count;
+    };
+
+private:
+    /**
+     * @brief get slot / lock-free
+     *
+     * @param index [in]
+     * @return Slot* nullptr: page not allocated or out of range
+     */
+    Slot* At(IN uint32_t index) const;
+
+    /**
+     * @brief take free slot of the shard
+     *
+     * @param shard [in]
+     * @param index [out]
+     * @return Slot* nullptr: shard full
+     */
+    Slot* Take(IN size_t shard, OUT uint32_t& index);
+
+    /**
+     * @brief drop reference, destroy and free at 0
+     *
+     * @param index [in]
+     */
+    void Release(IN uint32_t index);
+
+    /**
+     * @brief destroy session, advance generation and return slot to the shard
+     *
+     * @param index [in]
+     * @param slot  [in]
+     */
+    void Free(IN uint32_t index, IN Slot* slot);
+
+    /**
+     * @brief advance generation and return slot to the shard, session is not constructed
+     *
+     * @param index [in]
+     * @param slot  [in]
+     */
+    void Recycle(IN uint32_t index, IN Slot* slot);
+
+    /**
+     * @brief preferred shard of the calling thread, moves when full
+     */
+    static size_t& Home();
+
+private:
+    static constexpr uint64_t LIVE       = 1ull << 31;
+    static constexpr uint64_t REFERENCES = LIVE - 1;
+
+    Shard  shards[N];
+    size_t pageCount; // per shard
+};
+
+#include "SessionTable.ipp"
+#endif
@@ -0,0 +1,297 @@
+template<typename T, size_t N> SessionTable<T, N>::Ref::Ref(): table(nullptr), handle(INVALID), value(nullptr) {}
+
+template<typename T, size_t N>
+SessionTable<T, N>::Ref::Ref(SessionTable* table, Handle handle, T* value): table(table), handle(handle), value(value)
+{
+}
+
+template<typename T, size_t N>
+SessionTable<T, N>::Ref::Ref(Ref&& other) noexcept: table(other.table), handle(other.handle), value(other.value)
+{
+    other.table  = nullptr;
+    other.handle = INVALID;
+    other.value  = nullptr;
+}
+
+template<typename T, size_t N> auto SessionTable<T, N>::Ref::operator=(Ref&& other) noexcept -> Ref&
+{
+    if(this != &other) {
+        Reset();
+        table        = other.table;
+        handle       = other.handle;
+        value        = other.value;
+        other.table  = nullptr;
+        other.handle = INVALID;
+        other.value  = nullptr;
+    }
+    return *this;
+}
+
+template<typename T, size_t N> SessionTable<T, N>::Ref::~Ref()
+{
+    Reset();
+}
+
+template<typename T, size_t N> T* SessionTable<T, N>::Ref::operator->() const
+{
+    return value;
+}
+
+template<typename T, size_t N> T& SessionTable<T, N>::Ref::operator*() const
+{
+    return *value;
+}
+
+template<typename T, size_t N> T* SessionTable<T, N>::Ref::Get() const
+{
+    return value;
+}
+
+template<typename T, size_t N> SessionTable<T, N>::Ref::operator bool() const
+{
+    return value != nullptr;
+}
+
+template<typename T, size_t N> void SessionTable<T, N>::Ref::Reset()
+{
+    if(value) {
+        table->Release(static_cast<uint32_t>(handle));
+        table  = nullptr;
+        handle = INVALID;
+        value  = nullptr;
+    }
+}
+
+template<typename T, size_t N> SessionTable<T, N>::SessionTable(size_t capacity)
+{
+    size_t local = (MAX(capacity, static_cast<size_t>(1)) + N - 1) / N;
+    pageCount    = (local + PAGE_SLOTS - 1) / PAGE_SLOTS;
+
+    // local index * N + shard must fit 32 bits
+    size_t limit = (static_cast<size_t>(UINT32_MAX) + 1) / N / PAGE_SLOTS;
+    pageCount    = MIN(pageCount, limit);
+
+    for(size_t i = 0; i < N; ++i) {
+        shards[i].pages = new std::atomic<Slot*>[pageCount];
+        shards[i].used  = 0;
+        shards[i].count.store(0, std::memory_order_relaxed);
+        for(size_t j = 0; j < pageCount; ++j) {
+            shards[i].pages[j].store(nullptr, std::memory_order_relaxed);
+        }
+    }
+}
+
+template<typename T, size_t N> SessionTable<T, N>::~SessionTable()
+{
+    for(size_t i = 0; i < N; ++i) {
+        Shard& shard = shards[i];
+        for(size_t j = 0; j < pageCount; ++j) {
+            Slot* page = shard.pages[j].load(std::memory_order_relaxed);
+            if(page == nullptr) {
+                continue;
+            }
+
+            for(size_t k = 0; k < PAGE_SLOTS; ++k) {
+                if(page[k].state.load(std::memory_order_relaxed) & LIVE) {
+                    reinterpret_cast<T*>(page[k].storage)->~T();
+                }
+            }
+            delete[] page;
+        }
+        SAFE_DELETES(shard.pages);
+    }
+}
+
+template<typename T, size_t N> template<typename... Args> auto SessionTable<T, N>::Insert(Args&&... args) -> Handle
+{
+    size_t&  home  = Home();
+    uint32_t index = 0;
+    Slot*    slot  = nullptr;
+
+    // own shard first, then the others: move home to the shard that had room
+    for(size_t i = 0; i < N && slot == nullptr; ++i) {
+        slot = Take((home + i) & (N - 1), index);
+    }
+    if(slot == nullptr) {
+        return INVALID;
+    }
+    home = index & (N - 1);
+
+    try {
+        new(slot->storage) T(std::forward<Args>(args)...);
+    }
+    catch(...) {
+        Recycle(index, slot);
+        throw;
+    }
+
+    // publish: live with the table reference
+    uint64_t generation = slot->state.load(std::memory_order_relaxed) >> 32;
+    slot->state.store((generation << 32) | LIVE | 1, std::memory_order_release);
+    shards[index & (N - 1)].count.fetch_add(1, std::memory_order_relaxed);
+
+    return (generation << 32) | index;
+}
+
+template<typename T, size_t N> bool SessionTable<T, N>::Remove(Handle handle)
+{
+    Slot* slot = At(static_cast<uint32_t>(handle));
+    if(slot == nullptr) {
+        return false;
+    }
+
+    uint64_t generation = handle >> 32;
+    uint64_t state      = slot->state.load(std::memory_order_acquire);
+    while(true) {
+        if((state >> 32) != generation || (state & LIVE) == 0) {
+            return false;
+        }
+        // drop live and its reference at once
+        if(slot->state.compare_exchange_weak(state, (state & ~LIVE) - 1, std::memory_order_acq_rel)) {
+            break;
+        }
+    }
+
+    shards[static_cast<uint32_t>(handle) & (N - 1)].count.fetch_sub(1, std::memory_order_relaxed);
+    if(((state - 1) & REFERENCES) == 0) {
+        Free(static_cast<uint32_t>(handle), slot);
+    }
+    return true;
+}
+
+template<typename T, size_t N> auto SessionTable<T, N>::Find(Handle handle) -> Ref
+{
+    Slot* slot = At(static_cast<uint32_t>(handle));
+    if(slot == nullptr) {
+        return Ref();
+    }
+
+    uint64_t generation = handle >> 32;
+    uint64_t state      = slot->state.load(std::memory_order_acquire);
+    while(true) {
+        if((state >> 32) != generation || (state & LIVE) == 0) {
+            return Ref();
+        }
+        if(slot->state.compare_exchange_weak(state, state + 1, std::memory_order_acquire)) {
+            return Ref(this, handle, reinterpret_cast<T*>(slot->storage));
+        }
+    }
+}
+
+template<typename T, size_t N> template<typename Function> void SessionTable<T, N>::ForEach(Function&& function)
+{
+    for(size_t i = 0; i < N; ++i) {
+        for(size_t j = 0; j < pageCount; ++j) {
+            Slot* page = shards[i].pages[j].load(std::memory_order_acquire);
+            if(page == nullptr) {
+                break; // allocated in order
+            }
+
+            for(size_t k = 0; k < PAGE_SLOTS; ++k) {
+                uint64_t state = page[k].state.load(std::memory_order_relaxed);
+                if((state & LIVE) == 0) {
+                    continue;
+                }
+
+                uint32_t index  = static_cast<uint32_t>((j * PAGE_SLOTS + k) * N + i);
+                Handle   handle = (state & ~(LIVE | REFERENCES)) | index;
+                if(Ref ref = Find(handle)) {
+                    function(handle, *ref);
+                }
+            }
+        }
+    }
+}
+
+template<typename T, size_t N> size_t SessionTable<T, N>::GetSize() const
+{
+    size_t size = 0;
+    for(size_t i = 0; i < N; ++i) {
+        size += shards[i].count.load(std::memory_order_relaxed);
+    }
+    return size;
+}
+
+template<typename T, size_t N> size_t SessionTable<T, N>::GetCapacity() const
+{
+    return pageCount * PAGE_SLOTS * N;
+}
+
+template<typename T, size_t N> auto SessionTable<T, N>::At(uint32_t index) const -> Slot*
+{
+    size_t local = index / N;
+    size_t page  = local / PAGE_SLOTS;
+    if(page >= pageCount) {
+        return nullptr;
+    }
+
+    Slot* slots = shards[index & (N - 1)].pages[page].load(std::memory_order_acquire);
+    return slots ? &slots[local % PAGE_SLOTS] : nullptr;
+}
+
+template<typename T, size_t N> auto SessionTable<T, N>::Take(size_t index, uint32_t& out) -> Slot*
+{
+    Shard&            shard = shards[index];
+    LockGuard::Scoped guard(shard.lock);
+
+    uint32_t local;
+    if(!shard.frees.empty()) {
+        local = shard.frees.back();
+        shard.frees.pop_back();
+    }
+    else {
+        if(shard.used == pageCount * PAGE_SLOTS) {
+            return nullptr;
+        }
+        local = shard.used++;
+
+        // first slot of a page: allocate and publish
+        if(local % PAGE_SLOTS == 0) {
+            Slot* page = new Slot[PAGE_SLOTS];
+            for(size_t i = 0; i < PAGE_SLOTS; ++i) {
+                page[i].state.store(1ull << 32, std::memory_order_relaxed);
+            }
+            shard.pages[local / PAGE_SLOTS].store(page, std::memory_order_release);
+        }
+    }
+
+    out = static_cast<uint32_t>(local * N + index);
+    return &shard.pages[local / PAGE_SLOTS].load(std::memory_order_relaxed)[local % PAGE_SLOTS];
+}
+
+template<typename T, size_t N> void SessionTable<T, N>::Release(uint32_t index)
+{
+    Slot*    slot  = At(index);
+    uint64_t state = slot->state.fetch_sub(1, std::memory_order_acq_rel) - 1;
+    if((state & (LIVE | REFERENCES)) == 0) {
+        Free(index, slot);
+    }
+}
+
+template<typename T, size_t N> void SessionTable<T, N>::Free(uint32_t index, Slot* slot)
+{
+    // not live and no reference: nobody can find it again
+    reinterpret_cast<T*>(slot->storage)->~T();
+    Recycle(index, slot);
+}
+
+template<typename T, size_t N> void SessionTable<T, N>::Recycle(uint32_t index, Slot* slot)
+{
+    // next generation invalidates old handles, skip 0 to keep INVALID unused
+    uint64_t generation = (slot->state.load(std::memory_order_relaxed) >> 32) + 1;
+    if(static_cast<uint32_t>(generation) == 0) {
+        generation = 1;
+    }
+    slot->state.store(static_cast<uint64_t>(static_cast<uint32_t>(generation)) << 32, std::memory_order_release);
+
+    Shard&            shard = shards[index & (N - 1)];
+    LockGuard::Scoped guard(shard.lock);
+    shard.frees.push_back(index / N);
+}
+
+template<typename T, size_t N> size_t& SessionTable<T, N>::Home()
+{
+    static std::atomic<size_t> next(0);
+    static thread_local size_t home = next.fetch_add(1, std::memory_order_relaxed) & (N - 1);
+    return home;
+}
@@ -0,0 +1,604 @@
+#include "UringPort.hpp"
+
+#if __linux__
+
+#    include "thread"
+#    include "climits"
+#    include "stdexcept"
+#    include "unistd.h"
+#    include "sys/mman.h"
+#    include "sys/socket.h"
+#    include "sys/syscall.h"
+#    include "sys/resource.h"
+#    include "linux/io_uring.h"
+#    include "../../utilities/utilities/Clock.hpp"
+
+const uint32_t UringPort::DEF_ENTRIES  = 4096;
+const size_t   UringPort::DEF_CAPACITY = 1 << 16;
+const uint32_t UringPort::POLL_IDLE    = 1000;
+
+// user_data: Overlapped* (8 byte aligned) or tag in the low 3 bits
+static const uint64_t TAG_WAKE   = 1;
+static const uint64_t TAG_CANCEL = 2;
+static const uint64_t TAG_MASK   = 7;
+
+// port whose operations are submitted by the next Dequeue() of this thread
+static thread_local const UringPort* deferring = nullptr;
+
+UringPort::UringPort(uint32_t entries, bool isPolling, size_t capacity):
+    ring(-1), isPolling(isPolling), isFixedFile(false), sqMap(MAP_FAILED), sqSize(0), sqHead(nullptr), sqTail(nullptr),
+    sqFlags(nullptr), sqMask(0), sqEntries(0), sqes(nullptr), sqesSize(0), cqHead(nullptr),
+    cqTail(nullptr), cqMask(0), cqes(nullptr), channels(nullptr), capacity(capacity), queued(0)
+{
+    io_uring_params params = {};
+    params.flags           = IORING_SETUP_CQSIZE | IORING_SETUP_CLAMP;
+    params.cq_entries      = entries * 4;
+    if(isPolling) {
+        params.flags          |= IORING_SETUP_SQPOLL;
+        params.sq_thread_idle  = POLL_IDLE;
+    }
+
+    ring = static_cast<int>(syscall(__NR_io_uring_setup, entries, &params));
+    if(ring < 0 && isPolling) {
+        // not permitted (e.g. unprivileged on old kernel): without SQPOLL
+        this->isPolling   = false;
+        params            = {};
+        params.flags      = IORING_SETUP_CQSIZE | IORING_SETUP_CLAMP;
+        params.cq_entries = entries * 4;
+        ring              = static_cast<int>(syscall(__NR_io_uring_setup, entries, &params));
+    }
+    if(ring < 0) {
+        throw std::runtime_error("io_uring_setup failed");
+    }
+
+    if(!(params.features & IORING_FEAT_NODROP) || !(params.features & IORING_FEAT_EXT_ARG) ||
+       !(params.features & IORING_FEAT_SINGLE_MMAP)) {
+        close(ring);
+        throw std::runtime_error("io_uring features not supported");
+    }
+
+    // rings share one mapping
+    sqSize = MAX(params.sq_off.array + params.sq_entries * sizeof(uint32_t),
+                 params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe));
+
+    sqMap = mmap(nullptr, sqSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ring, IORING_OFF_SQ_RING);
+    if(sqMap == MAP_FAILED) {
+        close(ring);
+        throw std::runtime_error("io_uring mmap failed");
+    }
+
+    sqesSize = params.sq_entries * sizeof(io_uring_sqe);
+    sqes     = static_cast<io_uring_sqe*>(
+        mmap(nullptr, sqesSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ring, IORING_OFF_SQES));
+    if(sqes == MAP_FAILED) {
+        munmap(sqMap, sqSize);
+        close(ring);
+        throw std::runtime_error("io_uring mmap failed");
+    }
+
+    char* sq  = static_cast<char*>(sqMap);
+    sqHead    = reinterpret_cast<uint32_t*>(sq + params.sq_off.head);
+    sqTail    = reinterpret_cast<uint32_t*>(sq + params.sq_off.tail);
+    sqFlags   = reinterpret_cast<uint32_t*>(sq + params.sq_off.flags);
+    sqMask    = *reinterpret_cast<uint32_t*>(sq + params.sq_off.ring_mask);
+    sqEntries = params.sq_entries;
+
+    // identity: SQE index == tail slot
+    uint32_t* array = reinterpret_cast<uint32_t*>(sq + params.sq_off.array);
+    for(uint32_t i = 0; i < sqEntries; ++i) {
+        array[i] = i;
+    }
+
+    cqHead = reinterpret_cast<uint32_t*>(sq + params.cq_off.head);
+    cqTail = reinterpret_cast<uint32_t*>(sq + params.cq_off.tail);
+    cqMask = *reinterpret_cast<uint32_t*>(sq + params.cq_off.ring_mask);
+    cqes   = reinterpret_cast<io_uring_cqe*>(sq + params.cq_off.cqes);
+
+    // sparse file table: slot == descriptor, limited by RLIMIT_NOFILE
+    rlimit limit;
+    if(getrlimit(RLIMIT_NOFILE, &limit) == 0 && limit.rlim_cur != RLIM_INFINITY) {
+        this->capacity = MIN(capacity, static_cast<size_t>(limit.rlim_cur));
+    }
+
+    std::vector<int> empty(this->capacity, -1);
+    isFixedFile = syscall(__NR_io_uring_register, ring, IORING_REGISTER_FILES, empty.data(), empty.size()) == 0;
+
+    channels = new Channel[this->capacity];
+}
+
+UringPort::~UringPort()
+{
+    Stop();
+
+    if(sqes != MAP_FAILED) {
+        munmap(sqes, sqesSize);
+    }
+    if(sqMap != MAP_FAILED) {
+        munmap(sqMap, sqSize);
+    }
+    close(ring);
+    SAFE_DELETES(channels);
+}
+
+bool UringPort::RegisterBuffers(const iovec* buffers, uint32_t count)
+{
+    if(!this->buffers.empty()) {
+        errno = EBUSY;
+        return false;
+    }
+
+    if(syscall(__NR_io_uring_register, ring, IORING_REGISTER_BUFFERS, buffers, count) < 0) {
+        return false;
+    }
+
+    this->buffers.assign(buffers, buffers + count);
+    return true;
+}
+
+bool UringPort::IsPolling() const
+{
+    return isPolling;
+}
+
+bool UringPort::IsFixedFile() const
+{
+    return isFixedFile;
+}
+
+bool UringPort::Associate(Socket socket, uint64_t key)
+{
+    if(socket < 0 || static_cast<size_t>(socket) >= capacity) {
+        errno = EMFILE;
+        return false;
+    }
+
+    Channel&          channel = channels[socket];
+    LockGuard::Scoped guard(channel.lock);
+
+    if(channel.isActive) {
+        errno = EEXIST;
+        return false;
+    }
+
+    if(isFixedFile) {
+        io_uring_files_update update = {};
+        update.offset                = static_cast<uint32_t>(socket);
+        update.fds                   = reinterpret_cast<uintptr_t>(&socket);
+        if(syscall(__NR_io_uring_register, ring, IORING_REGISTER_FILES_UPDATE, &update, 1) < 0) {
+            return false;
+        }
+    }
+
+    channel.key      = key;
+    channel.isActive = true;
+    channel.sending  = nullptr;
+    return true;
+}
+
+bool UringPort::Dissociate(Socket socket)
+{
+    if(socket < 0 || static_cast<size_t>(socket) >= capacity) {
+        return false;
+    }
+
+    std::vector<Completion> canceled;
+    {
+        Channel&          channel = channels[socket];
+        LockGuard::Scoped guard(channel.lock);
+
+        if(!channel.isActive) {
+            return false;
+        }
+        channel.isActive = false;
+
+        // not submitted yet
+        while(Overlapped* overlapped = channel.writes.Pop()) {
+            canceled.push_back({ channel.key, overlapped, 0, ECANCELED });
+        }
+
+        // in flight: complete with ECANCELED by the kernel
+        {
+            LockGuard::Scoped sq(sqLock);
+
+            io_uring_sqe* sqe = Acquire();
+            sqe->opcode       = IORING_OP_ASYNC_CANCEL;
+            sqe->fd           = socket;
+            sqe->cancel_flags = IORING_ASYNC_CANCEL_ALL | IORING_ASYNC_CANCEL_FD;
+            sqe->user_data    = TAG_CANCEL;
+            Publish();
+        }
+        Submit();
+
+        if(isFixedFile) {
+            int                   none   = -1;
+            io_uring_files_update update = {};
+            update.offset                = static_cast<uint32_t>(socket);
+            update.fds                   = reinterpret_cast<uintptr_t>(&none);
+            syscall(__NR_io_uring_register, ring, IORING_REGISTER_FILES_UPDATE, &update, 1);
+        }
+    }
+
+    Push(canceled);
+    return true;
+}
+
+bool UringPort::Recv(Socket socket, Overlapped* overlapped)
+{
+    return Issue(socket, overlapped, Overlapped::RECV);
+}
+
+bool UringPort::Send(Socket socket, Overlapped* overlapped)
+{
+    return Issue(socket, overlapped, Overlapped::SEND);
+}
+
+bool UringPort::Accept(Socket listener, Overlapped* overlapped)
+{
+    return Issue(listener, overlapped, Overlapped::ACCEPT);
+}
+
+bool UringPort::Post(uint64_t key, Overlapped* overlapped, size_t bytes)
+{
+    if(overlapped) {
+        overlapped->operation = Overlapped::POST;
+    }
+
+    {
+        LockGuard::Scoped guard(queueLock);
+        queue.push_back({ key, overlapped, bytes, 0 });
+        queued.fetch_add(1, std::memory_order_release);
+    }
+
+    Wake();
+    return true;
+}
+
+bool UringPort::Dequeue(Completion& completion, int timeout)
+{
+    deferring = nullptr;
+
+    uint64_t deadline = timeout >= 0 ? Clock::Now() + static_cast<uint64_t>(timeout) * 1000000 : 0;
+    while(true) {
+        bool isWoken = false;
+        if(Pop(completion) || Reap(completion, isWoken)) {
+            // flush what the previous handler issued, later issues wait for the next call
+            Submit();
+            deferring = this;
+            return true;
+        }
+
+        // Post() after Pop() failed: its wake is consumed, the completion is queued
+        if(isWoken) {
+            continue;
+        }
+
+        int64_t wait = -1;
+        if(timeout >= 0) {
+            uint64_t now = Clock::Now();
+            if(now >= deadline) {
+                Submit();
+                return false;
+            }
+            wait = static_cast<int64_t>(deadline - now);
+        }
+        Wait(wait);
+    }
+}
+
+bool UringPort::Issue(Socket socket, Overlapped* overlapped, Overlapped::EOperation operation)
+{
+    if(socket < 0 || static_cast<size_t>(socket) >= capacity) {
+        errno = EBADF;
+        return false;
+    }
+
+    overlapped->operation   = operation;
+    overlapped->transferred = 0;
+    overlapped->next        = nullptr;
+
+    {
+        Channel&          channel = channels[socket];
+        LockGuard::Scoped guard(channel.lock);
+
+        if(!channel.isActive) {
+            errno = EBADF;
+            return false;
+        }
+
+        overlapped->socket = socket;
+        overlapped->key    = channel.key;
+
+        // one send in flight: short send must not interleave with the next one
+        if(operation == Overlapped::SEND) {
+            if(channel.sending) {
+                channel.writes.Push(overlapped);
+                return true;
+            }
+            channel.sending = overlapped;
+        }
+
+        Prepare(overlapped);
+    }
+
+    if(deferring != this) {
+        Submit();
+    }
+    return true;
+}
+
+void UringPort::Prepare(Overlapped* overlapped)
+{
+    LockGuard::Scoped guard(sqLock);
+
+    io_uring_sqe* sqe = Acquire();
+    sqe->fd           = overlapped->socket;
+    sqe->flags        = isFixedFile ? IOSQE_FIXED_FILE : 0;
+    sqe->user_data    = reinterpret_cast<uintptr_t>(overlapped);
+
+    char*  buffer = overlapped->buffer + overlapped->transferred;
+    size_t length = overlapped->length - overlapped->transferred;
+    int    index  = overlapped->operation == Overlapped::RECV ? Find(buffer, length) : -1;
+
+    switch(overlapped->operation) {
+        case Overlapped::RECV:
+            sqe->opcode = index >= 0 ? IORING_OP_READ_FIXED : IORING_OP_RECV;
+            break;
+
+        case Overlapped::SEND:
+            // not WRITE_FIXED: write to a closed peer raises SIGPIPE
+            sqe->opcode    = IORING_OP_SEND;
+            sqe->msg_flags = MSG_NOSIGNAL;
+            if(overlapped->vectors) {
+                msghdr& message    = channels[overlapped->socket].message;
+                message            = {};
+                message.msg_iov    = overlapped->vectors;
+                message.msg_iovlen = overlapped->count;
+
+                sqe->opcode = IORING_OP_SENDMSG;
+                sqe->addr   = reinterpret_cast<uintptr_t>(&message);
+                sqe->len    = 1;
+            }
+            break;
+
+        default:
+            sqe->opcode       = IORING_OP_ACCEPT;
+            sqe->accept_flags = SOCK_NONBLOCK | SOCK_CLOEXEC;
+            break;
+    }
+
+    if(sqe->opcode != IORING_OP_ACCEPT && sqe->opcode != IORING_OP_SENDMSG) {
+        sqe->addr = reinterpret_cast<uintptr_t>(buffer);
+        sqe->len  = static_cast<uint32_t>(MIN(length, static_cast<size_t>(UINT_MAX)));
+        if(index >= 0) {
+            sqe->buf_index = static_cast<uint16_t>(index);
+        }
+    }
+
+    Publish();
+}
+
+io_uring_sqe* UringPort::Acquire()
+{
+    uint32_t tail = *sqTail;
+    while(tail - std::atomic_ref<uint32_t>(*sqHead).load(std::memory_order_acquire) >= sqEntries) {
+        // full: submit now, SQPOLL: wait for the kernel thread
+        if(isPolling) {
+            Enter(0, 0, IORING_ENTER_SQ_WAKEUP);
+            std::this_thread::yield();
+        }
+        else {
+            Enter(sqEntries, 0, 0);
+        }
+    }
+
+    io_uring_sqe* sqe = &sqes[tail & sqMask];
+    memset(sqe, 0, sizeof(io_uring_sqe));
+    return sqe;
+}
+
+void UringPort::Publish()
+{
+    std::atomic_ref<uint32_t>(*sqTail).store(*sqTail + 1, std::memory_order_release);
+}
+
+void UringPort::Submit()
+{
+    if(isPolling) {
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if(std::atomic_ref<uint32_t>(*sqFlags).load(std::memory_order_relaxed) & IORING_SQ_NEED_WAKEUP) {
+            Enter(0, 0, IORING_ENTER_SQ_WAKEUP);
+        }
+        return;
+    }
+
+    uint32_t count = std::atomic_ref<uint32_t>(*sqTail).load(std::memory_order_acquire) -
+                     std::atomic_ref<uint32_t>(*sqHead).load(std::memory_order_acquire);
+    if(count) {
+        Enter(count, 0, 0);
+    }
+}
+
+void UringPort::Wait(int64_t ns)
+{
+    uint32_t count = 0;
+    if(isPolling) {
+        Submit();
+    }
+    else {
+        count = std::atomic_ref<uint32_t>(*sqTail).load(std::memory_order_acquire) -
+                std::atomic_ref<uint32_t>(*sqHead).load(std::memory_order_acquire);
+    }
+
+    if(ns < 0) {
+        Enter(count, 1, IORING_ENTER_GETEVENTS);
+        return;
+    }
+
+    __kernel_timespec       timeout  = { ns / 1000000000, ns % 1000000000 };
+    io_uring_getevents_arg argument = {};
+    argument.ts                     = reinterpret_cast<uintptr_t>(&timeout);
+    Enter(count, 1, IORING_ENTER_GETEVENTS | IORING_ENTER_EXT_ARG, &argument, sizeof(argument));
+}
+
+bool UringPort::Reap(Completion& completion, bool& isWoken)
+{
+    isWoken = false;
+    while(true) {
+        uint64_t data;
+        int      result;
+        {
+            LockGuard::Scoped guard(cqLock);
+
+            uint32_t head = *cqHead;
+            if(head == std::atomic_ref<uint32_t>(*cqTail).load(std::memory_order_acquire)) {
+                return false;
+            }
+
+            io_uring_cqe& cqe = cqes[head & cqMask];
+            data              = cqe.user_data;
+            result            = cqe.res;
+            std::atomic_ref<uint32_t>(*cqHead).store(head + 1, std::memory_order_release);
+        }
+
+        if(data == TAG_WAKE) {
+            isWoken = true;
+            return false;
+        }
+        if(Convert(data, result, completion)) {
+            return true;
+        }
+    }
+}
+
+bool UringPort::Convert(uint64_t data, int result, Completion& completion)
+{
+    if(data & TAG_MASK) {
+        return false; // WAKE, CANCEL
+    }
+
+    Overlapped* overlapped = reinterpret_cast<Overlapped*>(data);
+
+    completion.key        = overlapped->key;
+    completion.overlapped = overlapped;
+    completion.bytes      = 0;
+    completion.error      = result < 0 ? -result : 0;
+
+    switch(overlapped->operation) {
+        case Overlapped::RECV:
+            completion.bytes = result > 0 ? static_cast<size_t>(result) : 0;
+            return true;
+
+        case Overlapped::ACCEPT:
+            if(result >= 0) {
+                overlapped->socket = static_cast<Socket>(result);
+            }
+            return true;
+
+        default:
+            break;
+    }
+
+    // SEND
+    if(result > 0) {
+        overlapped->transferred += static_cast<size_t>(result);
+        if(overlapped->vectors) {
+            Advance(overlapped, static_cast<size_t>(result));
+        }
+    }
+    completion.bytes = overlapped->transferred;
+
+    Channel&          channel = channels[overlapped->socket];
+    LockGuard::Scoped guard(channel.lock);
+
+    if(channel.sending != overlapped) {
+        return true; // dissociated
+    }
+
+    if(result > 0 && overlapped->transferred < overlapped->length) {
+        if(channel.isActive) {
+            Prepare(overlapped); // short send: rest, submitted with the next wait
+            return false;
+        }
+        completion.error = ECANCELED;
+    }
+
+    channel.sending = channel.isActive ? channel.writes.Pop() : nullptr;
+    if(channel.sending) {
+        Prepare(channel.sending);
+    }
+    return true;
+}
+
+void UringPort::Push(const std::vector<Completion>& completions)
+{
+    if(completions.empty()) {
+        return;
+    }
+
+    {
+        LockGuard::Scoped guard(queueLock);
+        queue.insert(queue.end(), completions.begin(), completions.end());
+        queued.fetch_add(completions.size(), std::memory_order_release);
+    }
+
+    Wake();
+}
+
+bool UringPort::Pop(Completion& completion)
+{
+    if(queued.load(std::memory_order_acquire) == 0) {
+        return false;
+    }
+
+    bool isMore;
+    {
+        LockGuard::Scoped guard(queueLock);
+        if(queue.empty()) {
+            return false;
+        }
+
+        completion = queue.front();
+        queue.pop_front();
+        isMore = queued.fetch_sub(1, std::memory_order_relaxed) > 1;
+    }
+
+    if(isMore) {
+        Wake();
+    }
+    return true;
+}
+
+void UringPort::Wake()
+{
+    {
+        LockGuard::Scoped guard(sqLock);
+
+        io_uring_sqe* sqe = Acquire();
+        sqe->opcode       = IORING_OP_NOP;
+        sqe->user_data    = TAG_WAKE;
+        Publish();
+    }
+    Submit();
+}
+
+int UringPort::Find(const char* buffer, size_t length) const
+{
+    for(size_t i = 0; i < buffers.size(); ++i) {
+        const char* base = static_cast<const char*>(buffers[i].iov_base);
+        if(base <= buffer && buffer + length <= base + buffers[i].iov_len) {
+            return static_cast<int>(i);
+        }
+    }
+    return -1;
+}
+
+int UringPort::Enter(uint32_t submit, uint32_t wait, uint32_t flags, void* argument, size_t size)
+{
+    int result;
+    do {
+        result = static_cast<int>(syscall(__NR_io_uring_enter, ring, submit, wait, flags, argument, size));
+    } while(result < 0 && errno == EINTR);
+    return result;
+}
+
+#endif
@@ -0,0 +1,248 @@
+/**
+ * @file    UringPort.hpp
+ * @author  LaverWinEmpty@google.com
+ * @brief   completion port on io_uring
+ * @version 0.0.1
+ * @date    2026-10-17
+ *
+ * @copyright Copyright (c) 2023
+ *
+ */
+
+#ifndef LWE__URINGPORT_HPP__
+#define LWE__URINGPORT_HPP__
+
+#if __linux__
+
+#    include "deque"
+#    include "sys/uio.h"
+#    include "sys/socket.h"
+#    include "CompletionPort.hpp"
+#    include "../../utilities/utilities/LockGuard.hpp"
+
+struct io_uring_sqe;
+struct io_uring_cqe;
+
+/**
+ * @brief completion port on io_uring, raw syscalls (no liburing)
+ * @note  true completion: recv / send / accept are performed by the kernel
+ *        associated sockets are registered files, receive into RegisterBuffers() region uses fixed read
+ *        batched submission: operations issued on a Dequeue() thread are submitted by its next Dequeue(),
+ *        together with the wait, other threads submit at once
+ *        SQPOLL: kernel thread polls the submission queue, no syscall per submission
+ *        send: one in flight per socket, short send is resubmitted, completes when all bytes are sent
+ *              vectors: SENDMSG
+ * @warning Dissociate() cancels in flight operations on linux 5.19+, shutdown() the socket on older kernels
+ */
+class UringPort: public CompletionPort
+{
+public:
+    /**
+     * @brief READONLY: default submission queue size
+     */
+    static const uint32_t DEF_ENTRIES;
+
+    /**
+     * @brief READONLY: default max descriptor
+     */
+    static const size_t DEF_CAPACITY;
+
+    /**
+     * @brief READONLY: SQPOLL kernel thread idle time before sleep (ms)
+     */
+    static const uint32_t POLL_IDLE;
+
+public:
+    /**
+     * @brief Construct a new UringPort object
+     * @throw std::runtime_error io_uring unavailable (e.g. kernel < 5.11, disabled by sysctl)
+     *
+     * @param entries   [in] submission queue size, completion queue is 4 times
+     * @param isPolling [in] SQPOLL, disabled silently if not permitted
+     * @param capacity  [in] descriptor limit, socket >= capacity is not associable
+     */
+    UringPort(IN uint32_t entries = DEF_ENTRIES, IN bool isPolling = false, IN size_t capacity = DEF_CAPACITY);
+
+    /**
+     * @brief Destroy the UringPort object, stop workers, in flight operations are canceled by the kernel
+     */
+    ~UringPort() override;
+
+public:
+    DECLARE_NO_COPY(UringPort);
+
+public:
+    bool Associate(IN Socket socket, IN uint64_t key) override;
+    bool Dissociate(IN Socket socket) override;
+    bool Recv(IN Socket socket, IN Overlapped* overlapped) override;
+    bool Send(IN Socket socket, IN Overlapped* overlapped) override;
+    bool Accept(IN Socket listener, IN Overlapped* overlapped) override;
+    bool Post(IN uint64_t key, IN Overlapped* overlapped = nullptr, IN size_t bytes = 0) override;
+    bool Dequeue(OUT Completion& completion, IN int timeout = INFINITE_WAIT) override;
+
+public:
+    /**
+     * @brief register fixed receive buffers (e.g. one slab of all receive buffers), once, before issuing
+     *
+     * @param buffers [in] pinned until destruction
+     * @param count   [in]
+     * @return true: succeeded / false: failed (errno, e.g. ENOMEM: RLIMIT_MEMLOCK)
+     */
+    bool RegisterBuffers(IN const iovec* buffers, IN uint32_t count);
+
+    /**
+     * @brief check SQPOLL is enabled
+     */
+    bool IsPolling() const;
+
+    /**
+     * @brief check sockets are registered files
+     */
+    bool IsFixedFile() const;
+
+private:
+    /**
+     * @brief per-socket state
+     */
+    struct Channel
+    {
+        LockGuard::WrappedAdaptive lock;
+
+        uint64_t    key      = 0;
+        bool        isActive = false;
+        Overlapped* sending  = nullptr; // in flight
+        Pending     writes;             // waiting for sending
+        msghdr      message  = {};      // SENDMSG of sending
+    };
+
+private:
+    /**
+     * @brief check associated and submit operation
+     *
+     * @param socket     [in]
+     * @param overlapped [in]
+     * @param operation  [in]
+     * @return true: accepted / false: not associated (EBADF)
+     */
+    bool Issue(IN Socket socket, IN Overlapped* overlapped, IN Overlapped::EOperation operation);
+
+    /**
+     * @brief write SQE for the operation, not submitted
+     *
+     * @param overlapped [in]
+     */
+    void Prepare(IN Overlapped* overlapped);
+
+    /**
+     * @brief get free SQE, submit if full, under sqLock
+     *
+     * @return io_uring_sqe* zeroed
+     */
+    io_uring_sqe* Acquire();
+
+    /**
+     * @brief make SQE visible to the kernel, under sqLock
+     */
+    void Publish();
+
+    /**
+     * @brief submit written SQEs (SQPOLL: wake the kernel thread if sleeping)
+     */
+    void Submit();
+
+    /**
+     * @brief submit and wait one CQE
+     *
+     * @param ns [in] timeout, -1: infinite
+     */
+    void Wait(IN int64_t ns);
+
+    /**
+     * @brief consume CQEs until one becomes completion or a wake
+     *
+     * @param completion [out]
+     * @param isWoken    [out] true: wake of Post() consumed, check queued completions before waiting
+     * @return true: reaped / false: empty or woken
+     */
+    bool Reap(OUT Completion& completion, OUT bool& isWoken);
+
+    /**
+     * @brief CQE to completion, resubmits short send
+     *
+     * @param data       [in] io_uring_cqe::user_data
+     * @param result     [in] io_uring_cqe::res
+     * @param completion [out]
+     * @return true: completed / false: internal or resubmitted
+     */
+    bool Convert(IN uint64_t data, IN int result, OUT Completion& completion);
+
+    /**
+     * @brief queue completions created without CQE (Post(), canceled before submission)
+     *
+     * @param completions [in]
+     */
+    void Push(IN const std::vector<Completion>& completions);
+
+    /**
+     * @brief pop queued completion
+     *
+     * @param completion [out]
+     * @return true: popped / false: empty
+     */
+    bool Pop(OUT Completion& completion);
+
+    /**
+     * @brief submit NOP to wake one waiter
+     */
+    void Wake();
+
+    /**
+     * @brief find registered buffer containing [buffer, buffer + length)
+     *
+     * @param buffer [in]
+     * @param length [in]
+     * @return int index, -1: not registered
+     */
+    int Find(IN const char* buffer, IN size_t length) const;
+
+    /**
+     * @brief io_uring_enter
+     */
+    int Enter(IN uint32_t submit, IN uint32_t wait, IN uint32_t flags, IN void* argument = nullptr, IN size_t size = 0);
+
+private:
+    int  ring;
+    bool isPolling;
+    bool isFixedFile;
+
+    // submission queue, shared with the kernel
+    void*         sqMap;
+    size_t        sqSize;
+    uint32_t*     sqHead;
+    uint32_t*     sqTail;
+    uint32_t*     sqFlags;
+    uint32_t      sqMask;
+    uint32_t      sqEntries;
+    io_uring_sqe* sqes;
+    size_t        sqesSize;
+
+    // completion queue, same mapping as the submission queue
+    uint32_t*     cqHead;
+    uint32_t*     cqTail;
+    uint32_t      cqMask;
+    io_uring_cqe* cqes;
+
+    Channel*           channels;
+    size_t             capacity;
+    std::vector<iovec> buffers;
+
+    std::deque<Completion> queue;
+    std::atomic<size_t>    queued;
+
+    LockGuard::WrappedAdaptive sqLock;
+    LockGuard::WrappedAdaptive cqLock;
+    LockGuard::WrappedAdaptive queueLock;
+};
+
+#endif
+#endif
@@ -0,0 +1,179 @@
+/**
+ * @file    PoolScaling.cpp
+ * @author  LaverWinEmpty@google.com
+ * @brief   benchmark, ThreadPool scaling from 1 to all cores
+ * @version 0.0.1
+ * @date    2026-10-18
+ *
+ * @copyright Copyright (c) 2023
+ *
+ * usage: PoolScaling [max threads] [tasks per run] [pin: 0 / 1]
+ *        inject: tasks submitted by a non-worker thread (injection queue)
+ *        fork:   binary task tree submitted by workers (own deques, stealing)
+ *        skewed: completion-like tasks, 1 / 64 runs 100x longer (stealing around long handlers)
+ *        speedup against 1 thread of the same workload, steals / parks per 1000 tasks
+ *
+ * build: g++ -std=c++20 -O2 PoolScaling.cpp ../thread/ThreadPool.cpp -pthread -o PoolScaling
+ */
+
+#include "cstdio"
+#include "cstdlib"
+#include "thread"
+#include "atomic"
+#include "chrono"
+#include "../thread/ThreadPool.hpp"
+
+/**
+ * @brief READONLY: work units of a short task, about 1 us
+ */
+static const uint32_t UNITS = 256;
+
+/**
+ * @brief result of a run
+ */
+struct Result
+{
+    double            seconds;
+    ThreadPool::Stats stats;
+};
+
+/**
+ * @brief completion counter of a run
+ */
+static std::atomic<uint64_t> remaining;
+
+/**
+ * @brief per-thread result sink, keeps the work from being optimized out
+ */
+static thread_local uint64_t sink;
+
+/**
+ * @brief cpu work without memory traffic
+ */
+static void Burn(IN uint32_t units)
+{
+    uint64_t value = sink | 1;
+    for(uint32_t i = 0; i < units; ++i) {
+        value ^= value << 13;
+        value ^= value >> 7;
+        value ^= value << 17;
+    }
+    sink = value;
+}
+
+/**
+ * @brief short task
+ */
+static void Short(IN void*)
+{
+    Burn(UNITS);
+    remaining.fetch_sub(1, std::memory_order_release);
+}
+
+/**
+ * @brief 1 / 64 long task, context: sequence
+ */
+static void Skewed(IN void* context)
+{
+    uintptr_t sequence = reinterpret_cast<uintptr_t>(context);
+    Burn(sequence % 64 == 0 ? UNITS * 100 : UNITS);
+    remaining.fetch_sub(1, std::memory_order_release);
+}
+
+/**
+ * @brief pool of the running fork workload
+ */
+static ThreadPool* forking;
+
+/**
+ * @brief tree node, context: depth left, leaves count as tasks
+ * @note  children are submitted from the worker: its own deque
+ */
+static void Branch(IN void* context)
+{
+    uintptr_t depth = reinterpret_cast<uintptr_t>(context);
+    if(depth == 0) {
+        Short(nullptr);
+        return;
+    }
+    forking->Submit(&Branch, reinterpret_cast<void*>(depth - 1));
+    forking->Submit(&Branch, reinterpret_cast<void*>(depth - 1));
+}
+
+/**
+ * @brief wait for the run
+ */
+static void Join()
+{
+    while(remaining.load(std::memory_order_acquire)) {
+        std::this_thread::yield();
+    }
+}
+
+/**
+ * @brief run a workload on a new pool
+ *
+ * @param kind     [in] 0: inject, 1: fork, 2: skewed
+ * @param threads  [in]
+ * @param tasks    [in] rounded down to a power of 2 for fork
+ * @param isPinned [in]
+ * @return Result
+ */
+static Result Run(IN int kind, IN uint32_t threads, IN uint32_t tasks, IN bool isPinned)
+{
+    ThreadPool pool(threads, isPinned);
+    Result     result;
+
+    uint32_t depth = 0;
+    while((2u << depth) <= tasks) {
+        ++depth;
+    }
+
+    auto begin = std::chrono::steady_clock::now();
+    if(kind == 1) {
+        forking = &pool;
+        remaining.store(1ull << depth, std::memory_order_relaxed);
+        pool.Submit(&Branch, reinterpret_cast<void*>(static_cast<uintptr_t>(depth)));
+    }
+    else {
+        remaining.store(tasks, std::memory_order_relaxed);
+        for(uint32_t i = 0; i < tasks; ++i) {
+            pool.Submit(kind == 0 ? &Short : &Skewed, reinterpret_cast<void*>(static_cast<uintptr_t>(i)));
+        }
+    }
+    Join();
+
+    result.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count();
+    result.stats   = pool.GetStats();
+    return result;
+}
+
+int main(int argc, char* argv[])
+{
+    uint32_t cores    = MAX(std::thread::hardware_concurrency(), 1u);
+    uint32_t maximum  = argc > 1 ? static_cast<uint32_t>(std::strtoul(argv[1], nullptr, 10)) : cores;
+    uint32_t tasks    = argc > 2 ? static_cast<uint32_t>(std::strtoul(argv[2], nullptr, 10)) : 1 << 18;
+    bool     isPinned = argc > 3 && std::strtoul(argv[3], nullptr, 10) != 0;
+
+    const char* names[] = { "inject", "fork", "skewed" };
+    for(int kind = 0; kind < 3; ++kind) {
+        double base = 0;
+        for(uint32_t threads = 1; threads <= maximum; ++threads) {
+            Result result = Run(kind, threads, tasks, isPinned);
+            if(threads == 1) {
+                base = result.seconds;
+            }
+
+            double executes = static_cast<double>(MAX(result.stats.executes, static_cast<uint64_t>(1)));
+            std::printf("%-6s threads %3u\t%8.2f Mtask/s\tspeedup %5.2f\tsteals %7.2f\tparks %7.2f\n",
+                        names[kind],
+                        threads,
+                        executes / result.seconds / 1e6,
+                        base / result.seconds,
+                        static_cast<double>(result.stats.steals) * 1000 / executes,
+                        static_cast<double>(result.stats.parks) * 1000 / executes);
+            std::fflush(stdout);
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,123 @@
+#include "Strand.hpp"
+
+/**
+ * @brief strand of the calling thread, nullptr: none
+ */
+static thread_local const Strand* running = nullptr;
+
+Strand::Strand(ThreadPool& pool): pool(&pool), head(&stub), count(0), tail(&stub)
+{
+    stub.next.store(nullptr, std::memory_order_relaxed);
+}
+
+Strand::~Strand()
+{
+    // the last decrement in Run() is the last access to the strand
+    while(count.load(std::memory_order_acquire)) {
+        std::this_thread::yield();
+    }
+}
+
+void Strand::Post(Function function, void* context)
+{
+    Node* node     = Nodes().New();
+    node->function = function;
+    node->context  = context;
+    Push(node);
+
+    // idle -> scheduled: only the first poster submits
+    if(count.fetch_add(1, std::memory_order_acq_rel) == 0) {
+        pool->Submit(&Strand::Run, this);
+    }
+}
+
+void Strand::Dispatch(Function function, void* context)
+{
+    if(IsCurrent()) {
+        function(context);
+    }
+    else {
+        Post(function, context);
+    }
+}
+
+bool Strand::IsCurrent() const
+{
+    return running == this;
+}
+
+void Strand::Push(Node* node)
+{
+    node->next.store(nullptr, std::memory_order_relaxed);
+    Node* previous = head.exchange(node, std::memory_order_acq_rel);
+    previous->next.store(node, std::memory_order_release);
+}
+
+Strand::Node* Strand::Pop()
+{
+    while(true) {
+        Node* node = tail;
+        Node* next = node->next.load(std::memory_order_acquire);
+
+        if(node == &stub) {
+            if(next == nullptr) {
+                CPU_PAUSE(); // counted, not linked yet
+                continue;
+            }
+            tail = next;
+            node = next;
+            next = next->next.load(std::memory_order_acquire);
+        }
+
+        if(next) {
+            tail = next;
+            return node;
+        }
+
+        // last node: put the stub behind it to detach
+        if(node == head.load(std::memory_order_acquire)) {
+            Push(&stub);
+            next = node->next.load(std::memory_order_acquire);
+            if(next) {
+                tail = next;
+                return node;
+            }
+        }
+        CPU_PAUSE();
+    }
+}
+
+void Strand::Run(void* context)
+{
+    Strand*       strand   = static_cast<Strand*>(context);
+    const Strand* previous = running;
+    running                = strand;
+
+    size_t done = 0;
+    while(done < BUDGET) {
+        Node*    node     = strand->Pop();
+        Function function = node->function;
+        void*    argument = node->context;
+        Nodes().Delete(node);
+
+        function(argument);
+        ++done;
+
+        // drained: posts after this schedule again
+        if(strand->count.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+            running = previous;
+            return;
+        }
+    }
+
+    // budget spent: let other strands run, keep the order
+    running = previous;
+    strand->pool->Submit(&Strand::Run, strand);
+}
+
+SlabPool<Strand::Node>& Strand::Nodes()
+{
+    // never destroyed: strands may post from threads still running at exit
+    static SlabPool<Node>* pool = new SlabPool<Node>();
+    return *pool;
+}
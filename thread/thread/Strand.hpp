@@ -0,0 +1,134 @@
+/**
+ * @file    Strand.hpp
+ * @author  LaverWinEmpty@google.com
+ * @brief   serial executor over the thread pool
+ * @version 0.0.1
+ * @date    2026-10-17
+ *
+ * @copyright Copyright (c) 2023
+ *
+ */
+
+#ifndef LWE__STRAND_HPP__
+#define LWE__STRAND_HPP__
+
+#include "ThreadPool.hpp"
+#include "../../memory/memory/SlabPool.hpp"
+
+/**
+ * @brief runs posted tasks one at a time in post order, without a lock
+ * @note  Post(): lock-free enqueue, the first task of an idle strand submits it to the pool
+ *        one worker drains the strand, up to BUDGET tasks per turn then yields to other work
+ *        different strands run in parallel (e.g. one strand per session)
+ */
+class Strand
+{
+public:
+    using Function = ThreadPool::Function;
+
+    /**
+     * @brief READONLY: tasks per turn, the rest is resubmitted
+     */
+    static const size_t BUDGET = 64;
+
+public:
+    /**
+     * @brief Construct a new Strand object
+     *
+     * @param pool [in] executor
+     */
+    Strand(IN ThreadPool& pool = ThreadPool::Default());
+
+    /**
+     * @brief Destroy the Strand object, waits for queued tasks to finish
+     * @warning not from a task of this strand
+     */
+    ~Strand();
+
+public:
+    DECLARE_NO_COPY(Strand);
+
+public:
+    /**
+     * @brief queue task / lock-free
+     *
+     * @param function [in]
+     * @param context  [in] argument of the function
+     */
+    void Post(IN Function function, IN void* context);
+
+    /**
+     * @brief queue callable, moved to the heap
+     * @throw std::bad_alloc
+     *
+     * @tparam Callable void()
+     * @param callable [in]
+     */
+    template<typename Callable> void Post(IN Callable&& callable);
+
+    /**
+     * @brief run now if called from this strand, queue otherwise
+     *
+     * @param function [in]
+     * @param context  [in]
+     */
+    void Dispatch(IN Function function, IN void* context);
+
+    /**
+     * @brief check the calling thread runs a task of this strand
+     */
+    bool IsCurrent() const;
+
+private:
+    /**
+     * @brief queue node
+     */
+    struct Node
+    {
+        std::atomic<Node*> next;
+        Function           function;
+        void*              context;
+    };
+
+private:
+    /**
+     * @brief push node (Vyukov MPSC)
+     *
+     * @param node [in]
+     */
+    void Push(IN Node* node);
+
+    /**
+     * @brief pop node, the running worker only
+     * @note  spins while a counted push is not linked yet
+     *
+     * @return Node*
+     */
+    Node* Pop();
+
+    /**
+     * @brief pool task: run up to BUDGET tasks
+     *
+     * @param context [in] Strand*
+     */
+    static void Run(IN void* context);
+
+    /**
+     * @brief nodes of all strands
+     */
+    static SlabPool<Node>& Nodes();
+
+private:
+    ThreadPool* pool;
+
+    // producers
+    alignas(CACHE_LINE_SIZE) std::atomic<Node*> head;
+    std::atomic<size_t> count; // queued, 0 -> 1 schedules
+
+    // running worker
+    alignas(CACHE_LINE_SIZE) Node* tail;
+    Node stub;
+};
+
+#include "Strand.ipp"
+#endif
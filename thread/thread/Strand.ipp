@@ -0,0 +1,12 @@
+template<typename Callable> void Strand::Post(Callable&& callable)
+{
+    using Box = std::decay_t<Callable>;
+
+    Post(
+        [](void* context) {
+            Box* box = static_cast<Box*>(context);
+            (*box)();
+            delete box;
+        },
+        new Box(std::forward<Callable>(callable)));
+}
@@ -0,0 +1,237 @@
+#include "ThreadPool.hpp"
+
+#if __linux__
+#    include "sched.h"
+#endif
+
+/**
+ * @brief worker of the calling thread
+ */
+static thread_local void* current = nullptr;
+
+ThreadPool::ThreadPool(size_t threads, bool isPinned):
+    injection(INJECTION_SIZE), signal(0), sleepers(0), isStopping(false)
+{
+    if(threads == 0) {
+        threads = MAX(std::thread::hardware_concurrency(), 1u);
+    }
+
+    workers.reserve(threads);
+    for(size_t i = 0; i < threads; ++i) {
+        Worker* worker = new Worker();
+        worker->pool   = this;
+        worker->index  = static_cast<uint32_t>(i);
+        worker->random = static_cast<uint32_t>(i) * 0x9E3779B9u + 1;
+        worker->executes.store(0, std::memory_order_relaxed);
+        worker->steals.store(0, std::memory_order_relaxed);
+        worker->parks.store(0, std::memory_order_relaxed);
+        workers.push_back(worker);
+    }
+
+    // all deques exist before any worker steals
+    threads = workers.size();
+    this->threads.reserve(threads);
+    for(size_t i = 0; i < threads; ++i) {
+        this->threads.emplace_back([this, i, isPinned]() {
+            if(isPinned) {
+                Pin(i);
+            }
+            Work(workers[i]);
+        });
+    }
+}
+
+ThreadPool::~ThreadPool()
+{
+    isStopping.store(true, std::memory_order_seq_cst);
+    signal.fetch_add(1, std::memory_order_seq_cst);
+    Wake(INT32_MAX);
+
+    for(std::thread& thread : threads) {
+        thread.join();
+    }
+    for(Worker* worker : workers) {
+        delete worker;
+    }
+}
+
+void ThreadPool::Submit(Function function, void* context)
+{
+    Task    task   = { function, context };
+    Worker* worker = static_cast<Worker*>(current);
+
+    // own deque, no shared write unless full
+    if(worker == nullptr || worker->pool != this || !worker->deque.Push(task)) {
+        while(!injection.Push(std::move(task))) {
+            std::this_thread::yield();
+        }
+    }
+    Notify();
+}
+
+ThreadPool::Stats ThreadPool::GetStats() const
+{
+    Stats result = {};
+    for(Worker* worker : workers) {
+        result.executes += worker->executes.load(std::memory_order_relaxed);
+        result.steals   += worker->steals.load(std::memory_order_relaxed);
+        result.parks    += worker->parks.load(std::memory_order_relaxed);
+    }
+    return result;
+}
+
+size_t ThreadPool::GetThreadCount() const
+{
+    return workers.size();
+}
+
+ThreadPool& ThreadPool::Default()
+{
+    // never destroyed: tasks may still be submitted by threads running at exit
+    static ThreadPool* pool = new ThreadPool();
+    return *pool;
+}
+
+int ThreadPool::GetWorkerIndex()
+{
+    Worker* worker = static_cast<Worker*>(current);
+    return worker ? static_cast<int>(worker->index) : -1;
+}
+
+void ThreadPool::Work(Worker* worker)
+{
+    current = worker;
+
+    Task task;
+    while(true) {
+        if(Find(worker, task)) {
+            task.function(task.context);
+            Add(worker->executes, 1);
+            continue;
+        }
+
+        // idle: retry a while before the syscall
+        bool isFound = false;
+        for(int i = 0; i < SPIN_ROUNDS && !isFound; ++i) {
+            CPU_PAUSE();
+            isFound = Find(worker, task);
+        }
+        if(isFound) {
+            task.function(task.context);
+            Add(worker->executes, 1);
+            continue;
+        }
+
+        // announce, then recheck: Submit() after the check sees the sleeper
+        uint32_t expected = signal.load(std::memory_order_seq_cst);
+        sleepers.fetch_add(1, std::memory_order_seq_cst);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if(HasWork()) {
+            sleepers.fetch_sub(1, std::memory_order_relaxed);
+            continue;
+        }
+        if(isStopping.load(std::memory_order_seq_cst)) {
+            sleepers.fetch_sub(1, std::memory_order_relaxed);
+            break;
+        }
+
+        Add(worker->parks, 1);
+        Wait(expected);
+        sleepers.fetch_sub(1, std::memory_order_relaxed);
+    }
+
+    current = nullptr;
+}
+
+bool ThreadPool::Find(Worker* worker, Task& task)
+{
+    if(worker->deque.Pop(task) || injection.Pop(task)) {
+        return true;
+    }
+
+    // random victim first, then the rest in order
+    size_t count = workers.size();
+    worker->random ^= worker->random << 13;
+    worker->random ^= worker->random >> 17;
+    worker->random ^= worker->random << 5;
+
+    size_t start = worker->random % count;
+    for(size_t i = 0; i < count; ++i) {
+        Worker* victim = workers[(start + i) % count];
+        if(victim != worker && victim->deque.Steal(task)) {
+            Add(worker->steals, 1);
+            return true;
+        }
+    }
+    return false;
+}
+
+bool ThreadPool::HasWork() const
+{
+    if(injection.GetSize()) {
+        return true;
+    }
+    for(Worker* worker : workers) {
+        if(!worker->deque.IsEmpty()) {
+            return true;
+        }
+    }
+    return false;
+}
+
+void ThreadPool::Notify()
+{
+    // pairs with the sleeper announce in Work()
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if(sleepers.load(std::memory_order_relaxed) > 0) {
+        signal.fetch_add(1, std::memory_order_seq_cst);
+        Wake(1);
+    }
+}
+
+void ThreadPool::Wait(uint32_t expected)
+{
+#if __linux__
+    syscall(SYS_futex, reinterpret_cast<uint32_t*>(&signal), FUTEX_WAIT_PRIVATE, expected, nullptr, nullptr, 0);
+#elif _WIN32 || _WIN64
+    WaitOnAddress(&signal, &expected, sizeof(expected), INFINITE);
+#else
+    signal.wait(expected, std::memory_order_relaxed);
+#endif
+}
+
+void ThreadPool::Wake(int count)
+{
+#if __linux__
+    syscall(SYS_futex, reinterpret_cast<uint32_t*>(&signal), FUTEX_WAKE_PRIVATE, count, nullptr, nullptr, 0);
+#elif _WIN32 || _WIN64
+    if(count == 1) {
+        WakeByAddressSingle(&signal);
+    }
+    else {
+        WakeByAddressAll(&signal);
+    }
+#else
+    if(count == 1) {
+        signal.notify_one();
+    }
+    else {
+        signal.notify_all();
+    }
+#endif
+}
+
+void ThreadPool::Pin(size_t cpu)
+{
+    size_t count = MAX(std::thread::hardware_concurrency(), 1u);
+    cpu %= count;
+
+#if _WIN32 || _WIN64
+    SetThreadAffinityMask(GetCurrentThread(), static_cast<DWORD_PTR>(1) << (cpu % (sizeof(DWORD_PTR) * 8)));
+#elif __linux__
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(cpu, &set);
+    pthread_setaffinity_np(pthread_self(), sizeof(set), &set);
+#endif
+}
@@ -0,0 +1,244 @@
+/**
+ * @file    ThreadPool.hpp
+ * @author  LaverWinEmpty@google.com
+ * @brief   work stealing thread pool
+ * @version 0.0.1
+ * @date    2026-10-17
+ *
+ * @copyright Copyright (c) 2023
+ *
+ */
+
+#ifndef LWE__THREADPOOL_HPP__
+#define LWE__THREADPOOL_HPP__
+
+#include "atomic"
+#include "thread"
+#include "vector"
+#include "type_traits"
+#include "../../utilities/utilities/LockGuard.hpp"
+#include "../../utilities/utilities/RingQueue.hpp"
+
+/**
+ * @brief worker threads with per-worker deques and work stealing
+ * @note  Submit() from a worker: own deque (Chase-Lev), no shared write
+ *        Submit() from other threads: shared injection queue
+ *        idle worker: steals from random victims, spins, then parks (futex / WaitOnAddress)
+ *        (e.g. completion handler: ThreadPool::Default().Submit(&Process, context);)
+ * @warning tasks must not throw
+ */
+class ThreadPool
+{
+public:
+    /**
+     * @brief task function
+     */
+    using Function = void (*)(void* context);
+
+    /**
+     * @brief READONLY: tasks per worker deque, more overflow into the injection queue
+     */
+    static const size_t DEQUE_SIZE = 1 << 12;
+
+    /**
+     * @brief READONLY: injection queue size
+     */
+    static const size_t INJECTION_SIZE = 1 << 16;
+
+    /**
+     * @brief counters
+     */
+    struct Stats
+    {
+        uint64_t executes; // tasks run
+        uint64_t steals;   // tasks taken from other workers
+        uint64_t parks;    // sleeps
+    };
+
+public:
+    /**
+     * @brief Construct a new ThreadPool object, start workers
+     *
+     * @param threads  [in] 0: hardware concurrency
+     * @param isPinned [in] true: worker i runs on CPU i (modulo CPU count)
+     */
+    ThreadPool(IN size_t threads = 0, IN bool isPinned = false);
+
+    /**
+     * @brief Destroy the ThreadPool object, runs queued tasks then joins workers
+     */
+    ~ThreadPool();
+
+public:
+    DECLARE_NO_COPY(ThreadPool);
+
+public:
+    /**
+     * @brief queue task / lock-free
+     * @note  waits (yields) while the injection queue is full
+     *
+     * @param function [in]
+     * @param context  [in] argument of the function
+     */
+    void Submit(IN Function function, IN void* context);
+
+    /**
+     * @brief queue callable, moved to the heap
+     * @throw std::bad_alloc
+     *
+     * @tparam Callable void()
+     * @param callable [in]
+     */
+    template<typename Callable> void Submit(IN Callable&& callable);
+
+    /**
+     * @brief merge counters of all workers
+     *
+     * @return Stats
+     */
+    Stats GetStats() const;
+
+    size_t GetThreadCount() const;
+
+public:
+    /**
+     * @brief STATIC: process wide pool, created on first call, hardware concurrency workers
+     *
+     * @return ThreadPool&
+     */
+    static ThreadPool& Default();
+
+    /**
+     * @brief STATIC: worker index of the calling thread in its pool
+     *
+     * @return int -1: not a worker
+     */
+    static int GetWorkerIndex();
+
+private:
+    /**
+     * @brief queued task
+     */
+    struct Task
+    {
+        Function function = nullptr;
+        void*    context  = nullptr;
+    };
+
+    /**
+     * @brief bounded Chase-Lev deque (Le et al. C11 version)
+     * @note  owner: Push() / Pop() at bottom, others: Steal() at top
+     */
+    class Deque
+    {
+    public:
+        Deque();
+
+    public:
+        /** @return false: full */
+        bool Push(IN const Task& task);
+        /** @return false: empty */
+        bool Pop(OUT Task& task);
+        /** @return false: empty or lost the race */
+        bool Steal(OUT Task& task);
+        bool IsEmpty() const;
+
+    private:
+        /**
+         * @brief task in 2 words, read by thieves while the owner writes other slots
+         */
+        struct Slot
+        {
+            std::atomic<Function> function;
+            std::atomic<void*>    context;
+        };
+
+    private:
+        alignas(CACHE_LINE_SIZE) std::atomic<int64_t> top;
+        alignas(CACHE_LINE_SIZE) std::atomic<int64_t> bottom;
+        alignas(CACHE_LINE_SIZE) Slot slots[DEQUE_SIZE];
+    };
+
+    /**
+     * @brief per-worker state
+     */
+    struct alignas(CACHE_LINE_SIZE) Worker
+    {
+        Deque                 deque;
+        ThreadPool*           pool;
+        uint32_t              index;
+        uint32_t              random; // xorshift state
+        std::atomic<uint64_t> executes;
+        std::atomic<uint64_t> steals;
+        std::atomic<uint64_t> parks;
+    };
+
+private:
+    /**
+     * @brief worker thread
+     *
+     * @param worker [in, out]
+     */
+    void Work(IN OUT Worker* worker);
+
+    /**
+     * @brief get task: own deque, injection queue, then other workers
+     *
+     * @param worker [in, out]
+     * @param task   [out]
+     * @return true: found
+     */
+    bool Find(IN OUT Worker* worker, OUT Task& task);
+
+    /**
+     * @brief check any queue has a task
+     */
+    bool HasWork() const;
+
+    /**
+     * @brief wake one parked worker if any
+     */
+    void Notify();
+
+    /**
+     * @brief sleep while signal == expected
+     */
+    void Wait(IN uint32_t expected);
+
+    /**
+     * @brief wake parked workers
+     *
+     * @param count [in]
+     */
+    void Wake(IN int count);
+
+    /**
+     * @brief pin the calling thread
+     *
+     * @param cpu [in]
+     */
+    static void Pin(IN size_t cpu);
+
+    /**
+     * @brief single writer increment
+     */
+    static void Add(IN OUT std::atomic<uint64_t>&, IN uint64_t value);
+
+private:
+    /**
+     * @brief READONLY: steal attempts over all victims before parking
+     */
+    static const int SPIN_ROUNDS = 64;
+
+private:
+    std::vector<Worker*>     workers;
+    std::vector<std::thread> threads;
+    RingQueue<Task>          injection;
+
+    alignas(CACHE_LINE_SIZE) std::atomic<uint32_t> signal;   // futex word, bumped by Notify()
+    std::atomic<int32_t>                           sleepers; // parking or parked
+    std::atomic<bool>                              isStopping;
+};
+
+#include "ThreadPool.ipp"
+#endif
@@ -0,0 +1,80 @@
+inline ThreadPool::Deque::Deque(): top(0), bottom(0) {}
+
+inline bool ThreadPool::Deque::Push(const Task& task)
+{
+    int64_t b = bottom.load(std::memory_order_relaxed);
+    int64_t t = top.load(std::memory_order_acquire);
+    if(b - t >= static_cast<int64_t>(DEQUE_SIZE)) {
+        return false;
+    }
+
+    Slot& slot = slots[b & (DEQUE_SIZE - 1)];
+    slot.function.store(task.function, std::memory_order_relaxed);
+    slot.context.store(task.context, std::memory_order_relaxed);
+    bottom.store(b + 1, std::memory_order_release);
+    return true;
+}
+
+inline bool ThreadPool::Deque::Pop(Task& task)
+{
+    int64_t b = bottom.load(std::memory_order_relaxed) - 1;
+    bottom.store(b, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    int64_t t = top.load(std::memory_order_relaxed);
+
+    if(t > b) {
+        bottom.store(b + 1, std::memory_order_relaxed);
+        return false;
+    }
+
+    Slot& slot    = slots[b & (DEQUE_SIZE - 1)];
+    task.function = slot.function.load(std::memory_order_relaxed);
+    task.context  = slot.context.load(std::memory_order_relaxed);
+
+    // last one: race with thieves
+    if(t == b) {
+        bool isWon = top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed);
+        bottom.store(b + 1, std::memory_order_relaxed);
+        return isWon;
+    }
+    return true;
+}
+
+inline bool ThreadPool::Deque::Steal(Task& task)
+{
+    int64_t t = top.load(std::memory_order_acquire);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    int64_t b = bottom.load(std::memory_order_acquire);
+
+    if(t >= b) {
+        return false;
+    }
+
+    Slot& slot    = slots[t & (DEQUE_SIZE - 1)];
+    task.function = slot.function.load(std::memory_order_relaxed);
+    task.context  = slot.context.load(std::memory_order_relaxed);
+    return top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed);
+}
+
+inline bool ThreadPool::Deque::IsEmpty() const
+{
+    return bottom.load(std::memory_order_relaxed) <= top.load(std::memory_order_relaxed);
+}
+
+template<typename Callable> void ThreadPool::Submit(Callable&& callable)
+{
+    using Box = std::decay_t<Callable>;
+
+    Submit(
+        [](void* context) {
+            Box* box = static_cast<Box*>(context);
+            (*box)();
+            delete box;
+        },
+        new Box(std::forward<Callable>(callable)));
+}
+
+inline void ThreadPool::Add(std::atomic<uint64_t>& counter, uint64_t value)
+{
+    counter.store(counter.load(std::memory_order_relaxed) + value, std::memory_order_relaxed);
+}
@@ -0,0 +1,108 @@
+/**
+ * @file    LockContention.cpp
+ * @author  LaverWinEmpty@google.com
+ * @brief   benchmark, Adaptive vs Spin vs Mutex at low and high contention
+ * @version 0.0.1
+ * @date    2026-10-18
+ *
+ * @copyright Copyright (c) 2023
+ *
+ * usage: LockContention [threads] [iterations]
+ *        low:          short hold, long work outside the lock
+ *        high:         short hold, no work outside the lock
+ *        oversubscribe: high with 4x threads, holders get preempted
+ *
+ * build: g++ -std=c++20 -O2 LockContention.cpp ../utilities/Clock.cpp -pthread -o LockContention
+ */
+
+#include "cstdio"
+#include "cstdlib"
+#include "thread"
+#include "vector"
+#include "atomic"
+#include "../utilities/LockGuard.hpp"
+#include "../utilities/Clock.hpp"
+
+/**
+ * @brief busy work, not optimized out
+ *
+ * @param count [in]
+ */
+static void Work(IN uint32_t count)
+{
+    volatile uint32_t sink = 0;
+    for(uint32_t i = 0; i < count; ++i) {
+        sink = i;
+    }
+    (void)sink; // volatile read: used, no -Wunused-but-set-variable
+}
+
+/**
+ * @brief run threads locking L
+ *
+ * @tparam L     lock guard (e.g. LockGuard::Adaptive<0>)
+ * @param threads    [in]
+ * @param iterations [in] per thread
+ * @param hold       [in] work inside the lock
+ * @param outside    [in] work outside the lock
+ * @return double nanoseconds per acquisition
+ */
+template<typename L> static double Run(IN uint32_t threads, IN uint32_t iterations, IN uint32_t hold, IN uint32_t outside)
+{
+    uint64_t                 shared = 0;
+    std::atomic<bool>        isReady(false);
+    std::vector<std::thread> workers;
+
+    for(uint32_t t = 0; t < threads; ++t) {
+        workers.emplace_back([&]() {
+            while(!isReady.load(std::memory_order_acquire)) {
+                std::this_thread::yield();
+            }
+            for(uint32_t i = 0; i < iterations; ++i) {
+                {
+                    L lock;
+                    ++shared;
+                    Work(hold);
+                }
+                Work(outside);
+            }
+        });
+    }
+
+    uint64_t begin = Clock::Now();
+    isReady.store(true, std::memory_order_release);
+    for(std::thread& worker : workers) {
+        worker.join();
+    }
+    uint64_t end = Clock::Now();
+
+    if(shared != static_cast<uint64_t>(threads) * iterations) {
+        std::printf("broken: %llu\n", static_cast<unsigned long long>(shared));
+        std::exit(1);
+    }
+    return static_cast<double>(end - begin) / shared;
+}
+
+/**
+ * @brief print a row
+ */
+static void Row(IN const char* name, IN uint32_t threads, IN uint32_t iterations, IN uint32_t hold, IN uint32_t outside)
+{
+    double adaptive = Run<LockGuard::Adaptive<0>>(threads, iterations, hold, outside);
+    double spin     = Run<LockGuard::Spin<0>>(threads, iterations, hold, outside);
+    double mutex    = Run<LockGuard::Mutex<0>>(threads, iterations, hold, outside);
+
+    std::printf("%-14s threads %3u\tadaptive %8.1f ns\tspin %8.1f ns\tmutex %8.1f ns\n", name, threads, adaptive, spin, mutex);
+}
+
+int main(int argc, char* argv[])
+{
+    uint32_t cores      = MAX(std::thread::hardware_concurrency(), 1u);
+    uint32_t threads    = argc > 1 ? static_cast<uint32_t>(std::strtoul(argv[1], nullptr, 10)) : cores;
+    uint32_t iterations = argc > 2 ? static_cast<uint32_t>(std::strtoul(argv[2], nullptr, 10)) : 100000;
+
+    Row("low", threads, iterations, 20, 2000);
+    Row("high", threads, iterations, 20, 0);
+    Row("oversubscribe", threads * 4, iterations / 4, 20, 0);
+    return 0;
+}
@@ -0,0 +1,123 @@
+/**
+ * @file    LockSweep.cpp
+ * @author  LaverWinEmpty@google.com
+ * @brief   benchmark, contention sweep of Ticket / MCS against Spin / Mutex over 1 ~ N threads
+ * @version 0.0.1
+ * @date    2026-10-18
+ *
+ * @copyright Copyright (c) 2023
+ *
+ * usage: LockSweep [max threads] [milliseconds per run]
+ *        throughput: acquisitions per microsecond of all threads
+ *        fairness:   fewest / most acquisitions of a thread, 1: fair, 0: starved
+ *
+ * build: g++ -std=c++20 -O2 LockSweep.cpp -pthread -o LockSweep
+ */
+
+#include "cstdio"
+#include "cstdlib"
+#include "thread"
+#include "vector"
+#include "atomic"
+#include "chrono"
+#include "../utilities/LockGuard.hpp"
+
+/**
+ * @brief per-thread counter, own cache line
+ */
+struct alignas(CACHE_LINE_SIZE) Counter
+{
+    uint64_t value = 0;
+};
+
+/**
+ * @brief result of a run
+ */
+struct Result
+{
+    double throughput;
+    double fairness;
+};
+
+/**
+ * @brief run threads locking L for the duration
+ *
+ * @tparam L lock guard (e.g. LockGuard::Ticket<0>)
+ * @param threads  [in]
+ * @param duration [in]
+ * @return Result
+ */
+template<typename L> static Result Run(IN uint32_t threads, IN std::chrono::milliseconds duration)
+{
+    uint64_t                 shared = 0;
+    std::atomic<bool>        isReady(false);
+    std::atomic<bool>        isRunning(true);
+    std::vector<Counter>     counters(threads);
+    std::vector<std::thread> workers;
+
+    for(uint32_t t = 0; t < threads; ++t) {
+        workers.emplace_back([&, t]() {
+            while(!isReady.load(std::memory_order_acquire)) {
+                std::this_thread::yield();
+            }
+            uint64_t count = 0;
+            while(isRunning.load(std::memory_order_relaxed)) {
+                L lock;
+                ++shared;
+                ++count;
+            }
+            counters[t].value = count;
+        });
+    }
+
+    isReady.store(true, std::memory_order_release);
+    std::this_thread::sleep_for(duration);
+    isRunning.store(false, std::memory_order_relaxed);
+    for(std::thread& worker : workers) {
+        worker.join();
+    }
+
+    uint64_t total = 0;
+    uint64_t least = UINT64_MAX;
+    uint64_t most  = 0;
+    for(const Counter& counter : counters) {
+        total += counter.value;
+        least  = MIN(least, counter.value);
+        most   = MAX(most, counter.value);
+    }
+    if(total != shared) {
+        std::printf("broken: %llu != %llu\n", static_cast<unsigned long long>(total), static_cast<unsigned long long>(shared));
+        std::exit(1);
+    }
+
+    Result result;
+    result.throughput = static_cast<double>(total) / std::chrono::duration<double, std::micro>(duration).count();
+    result.fairness   = most ? static_cast<double>(least) / static_cast<double>(most) : 0;
+    return result;
+}
+
+/**
+ * @brief print a column
+ */
+static void Column(IN const char* name, IN const Result& result)
+{
+    std::printf("\t%s %7.2f /us %4.2f", name, result.throughput, result.fairness);
+}
+
+int main(int argc, char* argv[])
+{
+    uint32_t cores    = MAX(std::thread::hardware_concurrency(), 1u);
+    uint32_t maximum  = argc > 1 ? static_cast<uint32_t>(std::strtoul(argv[1], nullptr, 10)) : cores;
+    auto     duration = std::chrono::milliseconds(argc > 2 ? std::strtoul(argv[2], nullptr, 10) : 200);
+
+    for(uint32_t threads = 1; threads <= maximum; ++threads) {
+        std::printf("threads %3u", threads);
+        Column("spin", Run<LockGuard::Spin<0>>(threads, duration));
+        Column("mutex", Run<LockGuard::Mutex<0>>(threads, duration));
+        Column("ticket", Run<LockGuard::Ticket<0>>(threads, duration));
+        Column("mcs", Run<LockGuard::MCS<0>>(threads, duration));
+        std::printf("\n");
+        std::fflush(stdout);
+    }
+    return 0;
+}
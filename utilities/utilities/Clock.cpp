@@ -0,0 +1,117 @@
+#include "Clock.hpp"
+#include "thread"
+
+#if _WIN32 || _WIN64
+#    include "windows.h"
+#else
+#    include "time.h"
+#    if __x86_64__ || __i386__
+#        include "cpuid.h"
+#    endif
+#endif
+
+const bool Clock::isCalibrated = Clock::State().isTSC;
+
+bool Clock::Calibrate(std::chrono::milliseconds duration)
+{
+    Calibration result = Measure(duration);
+    State()            = result;
+    return result.isTSC;
+}
+
+Clock::Calibration Clock::Measure(std::chrono::milliseconds duration)
+{
+    Calibration result = { 0, 0, 0, false };
+    if(!CheckInvariantTSC()) {
+        return result;
+    }
+
+#if _WIN32 || _WIN64 || __x86_64__ || __i386__
+    uint64_t limit      = static_cast<uint64_t>(std::chrono::nanoseconds(duration).count());
+    uint64_t beginNS    = Fallback();
+    uint64_t beginTicks = __rdtsc();
+    uint64_t endNS      = beginNS;
+    uint64_t endTicks   = beginTicks;
+
+    while(endNS - beginNS < limit) {
+        std::this_thread::yield();
+        endNS    = Fallback();
+        endTicks = __rdtsc();
+    }
+
+    if(endTicks <= beginTicks) {
+        return result;
+    }
+
+    // ns << 32 overflows from 2^32 ns (about 4.29 s): halve both, the ratio is kept
+    uint64_t ns    = endNS - beginNS;
+    uint64_t ticks = endTicks - beginTicks;
+    while(ns >> 32) {
+        ns    >>= 1;
+        ticks >>= 1;
+    }
+    if(ticks == 0) {
+        return result;
+    }
+
+    result.scale     = (ns << 32) / ticks;
+    result.baseTicks = endTicks;
+    result.baseNS    = endNS;
+    result.isTSC     = true;
+#endif
+    return result;
+}
+
+bool Clock::IsTSC()
+{
+    return State().isTSC;
+}
+
+double Clock::GetFrequency()
+{
+    const Calibration& calibration = State();
+    if(!calibration.isTSC) {
+        return 0;
+    }
+    return 1e9 * static_cast<double>(1ull << 32) / static_cast<double>(calibration.scale);
+}
+
+uint64_t Clock::Fallback()
+{
+#if _WIN32 || _WIN64
+    static const double frequency = []() {
+        LARGE_INTEGER temp;
+        QueryPerformanceFrequency(&temp);
+        return static_cast<double>(temp.QuadPart);
+    }();
+
+    LARGE_INTEGER counter;
+    QueryPerformanceCounter(&counter);
+    return static_cast<uint64_t>(static_cast<double>(counter.QuadPart) * (1e9 / frequency));
+#else
+    timespec temp;
+    clock_gettime(CLOCK_MONOTONIC_RAW, &temp);
+    return static_cast<uint64_t>(temp.tv_sec) * 1000000000ull + static_cast<uint64_t>(temp.tv_nsec);
+#endif
+}
+
+bool Clock::CheckInvariantTSC()
+{
+#if _WIN32 || _WIN64
+    int info[4];
+    __cpuid(info, 0x80000000);
+    if(static_cast<unsigned>(info[0]) < 0x80000007) {
+        return false;
+    }
+    __cpuid(info, 0x80000007);
+    return (info[3] >> 8) & 1;
+#elif __x86_64__ || __i386__
+    unsigned eax, ebx, ecx, edx;
+    if(!__get_cpuid(0x80000007, &eax, &ebx, &ecx, &edx)) {
+        return false;
+    }
+    return (edx >> 8) & 1;
+#else
+    return false;
+#endif
+}
@@ -0,0 +1,140 @@
+/**
+ * @file    Clock.hpp
+ * @author  LaverWinEmpty@google.com
+ * @brief   high resolution monotonic clock (invariant TSC)
+ * @version 0.0.1
+ * @date    2026-10-17
+ *
+ * @copyright Copyright (c) 2023
+ *
+ */
+
+#ifndef LWE__CLOCK_HPP__
+#define LWE__CLOCK_HPP__
+
+#include "chrono"
+#include "../../include/include/includes.hpp"
+
+#if _WIN32 || _WIN64
+#    include "intrin.h"
+#elif __x86_64__ || __i386__
+#    include "x86intrin.h"
+#endif
+
+/**
+ * @brief STATIC: monotonic nanosecond clock
+ * @note  invariant TSC scaled by calibration when available,
+ *        else CLOCK_MONOTONIC_RAW (linux) / QueryPerformanceCounter (windows)
+ * @warning not wall clock: use for duration, ordering, packet timestamp
+ */
+class Clock
+{
+public:
+    DECLARE_LIMIT_LIFECYCLE(Clock);
+
+public:
+    /**
+     * @brief read clock
+     *
+     * @return uint64_t nanoseconds (epoch: fallback clock, e.g. boot)
+     */
+    static uint64_t Now();
+
+    /**
+     * @brief read raw counter
+     * @note  cheapest, convert with ToNS() (e.g. Clock::ToNS(end - begin))
+     *
+     * @return uint64_t ticks (fallback: nanoseconds)
+     */
+    static uint64_t Ticks();
+
+    /**
+     * @brief convert tick count to nanoseconds
+     *
+     * @param ticks [in] tick count (e.g. difference of Ticks())
+     * @return uint64_t
+     */
+    static uint64_t ToNS(IN uint64_t ticks);
+
+public:
+    /**
+     * @brief   measure TSC frequency against the fallback clock
+     * @note    measured once on first use (before main()), repeat to refine
+     * @warning not thread safe with Now() / ToNS()
+     *
+     * @param duration [in] measuring time
+     * @return true: TSC is used / false: fallback
+     */
+    static bool Calibrate(IN std::chrono::milliseconds duration = std::chrono::milliseconds(10));
+
+    /**
+     * @brief check clock source
+     *
+     * @return true: TSC / false: fallback
+     */
+    static bool IsTSC();
+
+    /**
+     * @brief get calibrated TSC frequency
+     *
+     * @return double Hz (0: fallback)
+     */
+    static double GetFrequency();
+
+private:
+    /**
+     * @brief read fallback clock
+     *
+     * @return uint64_t nanoseconds
+     */
+    static uint64_t Fallback();
+
+    /**
+     * @brief check CPUID invariant TSC bit (0x80000007 EDX[8])
+     *
+     * @return true / false
+     */
+    static bool CheckInvariantTSC();
+
+    /**
+     * @brief (a * b) >> 32 without overflow
+     */
+    static uint64_t MultiplyShift(IN uint64_t a, IN uint64_t b);
+
+private:
+    /**
+     * @brief conversion state, zero: fallback
+     */
+    struct Calibration
+    {
+        uint64_t baseTicks;
+        uint64_t baseNS;
+        uint64_t scale; // ns per tick, 32.32 fixed point
+        bool     isTSC;
+    };
+
+    /**
+     * @brief measure TSC frequency against the fallback clock
+     *
+     * @param duration [in] measuring time
+     * @return Calibration isTSC false: fallback
+     */
+    static Calibration Measure(IN std::chrono::milliseconds duration);
+
+    /**
+     * @brief conversion state, calibrated on first use
+     * @note  Ticks() never changes unit: no fallback nanoseconds before calibration
+     *
+     * @return Calibration&
+     */
+    static Calibration& State();
+
+private:
+    /**
+     * @brief for calibrate before main()
+     */
+    static const bool isCalibrated;
+};
+
+#include "Clock.ipp"
+#endif
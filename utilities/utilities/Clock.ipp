@@ -0,0 +1,50 @@
+inline uint64_t Clock::Now()
+{
+    const Calibration& calibration = State();
+    if(calibration.isTSC) {
+        return calibration.baseNS + MultiplyShift(Ticks() - calibration.baseTicks, calibration.scale);
+    }
+    return Fallback();
+}
+
+inline uint64_t Clock::Ticks()
+{
+#if _WIN32 || _WIN64 || __x86_64__ || __i386__
+    if(State().isTSC) {
+        return __rdtsc();
+    }
+#endif
+    return Fallback();
+}
+
+inline uint64_t Clock::ToNS(uint64_t ticks)
+{
+    const Calibration& calibration = State();
+    if(calibration.isTSC) {
+        return MultiplyShift(ticks, calibration.scale);
+    }
+    return ticks;
+}
+
+inline uint64_t Clock::MultiplyShift(uint64_t a, uint64_t b)
+{
+#if defined(_MSC_VER) && defined(X64)
+    uint64_t high;
+    uint64_t low = _umul128(a, b, &high);
+    return __shiftright128(low, high, 32);
+#elif defined(__SIZEOF_INT128__)
+    return static_cast<uint64_t>((static_cast<unsigned __int128>(a) * b) >> 32);
+#else
+    // 32 bit: split
+    uint64_t high = (a >> 32) * b;
+    uint64_t low  = ((a & 0xFFFFFFFF) * b) >> 32;
+    return high + low;
+#endif
+}
+
+inline Clock::Calibration& Clock::State()
+{
+    // calibrated on first use: callers during static initialization get the same unit as later callers
+    static Calibration calibration = Measure(std::chrono::milliseconds(10));
+    return calibration;
+}
@@ -0,0 +1,203 @@
+#include "Histogram.hpp"
+#include "cmath"
+#include "algorithm"
+#include "cstdio"
+
+Histogram::Snapshot::Snapshot(): counts(BUCKETS, 0), count(0), sum(0), min(UINT64_MAX), max(0) {}
+
+void Histogram::Snapshot::Merge(const Snapshot& other)
+{
+    for(uint32_t i = 0; i < BUCKETS; ++i) {
+        counts[i] += other.counts[i];
+    }
+    count += other.count;
+    sum += other.sum;
+    min = MIN(min, other.min);
+    max = MAX(max, other.max);
+}
+
+uint64_t Histogram::Snapshot::Percentile(double percent) const
+{
+    // buckets are the source: count may differ slightly while recording
+    uint64_t total = 0;
+    for(uint32_t i = 0; i < BUCKETS; ++i) {
+        total += counts[i];
+    }
+    if(total == 0) {
+        return 0;
+    }
+
+    double   rank   = std::ceil(percent / 100.0 * static_cast<double>(total));
+    uint64_t target = rank < 1 ? 1 : (rank > static_cast<double>(total) ? total : static_cast<uint64_t>(rank));
+    uint64_t seen   = 0;
+
+    for(uint32_t i = 0; i < BUCKETS; ++i) {
+        seen += counts[i];
+        if(seen >= target) {
+            return MIN(Upper(i), max);
+        }
+    }
+    return max;
+}
+
+uint64_t Histogram::Snapshot::GetCount() const
+{
+    return count;
+}
+
+uint64_t Histogram::Snapshot::GetMin() const
+{
+    return count ? min : 0;
+}
+
+uint64_t Histogram::Snapshot::GetMax() const
+{
+    return max;
+}
+
+uint64_t Histogram::Snapshot::GetMean() const
+{
+    return count ? sum / count : 0;
+}
+
+std::string Histogram::Snapshot::ToString() const
+{
+    char buffer[DEF_BUF_SIZE];
+
+    snprintf(buffer,
+             sizeof(buffer),
+             "count=%llu min=%llu p50=%llu p90=%llu p99=%llu p99.9=%llu max=%llu mean=%llu (ns)",
+             static_cast<unsigned long long>(count),
+             static_cast<unsigned long long>(GetMin()),
+             static_cast<unsigned long long>(Percentile(50)),
+             static_cast<unsigned long long>(Percentile(90)),
+             static_cast<unsigned long long>(Percentile(99)),
+             static_cast<unsigned long long>(Percentile(99.9)),
+             static_cast<unsigned long long>(max),
+             static_cast<unsigned long long>(GetMean()));
+
+    return buffer;
+}
+
+Histogram::Shard::Shard(): counts{}, count(0), sum(0), min(UINT64_MAX), max(0) {}
+
+Histogram::Histogram(const char* name): name(name)
+{
+    static std::atomic<uint64_t> generator = 0;
+    id = generator.fetch_add(1, std::memory_order_relaxed) + 1;
+
+    Actives& actives = GetActives();
+    LockGuard::Scoped guard(actives.lock);
+    actives.ids.push_back(id);
+}
+
+Histogram::~Histogram()
+{
+    {
+        // cached pointers to the freed shards are dropped by the next Local() of each thread
+        Actives& actives = GetActives();
+        LockGuard::Scoped guard(actives.lock);
+        actives.ids.erase(std::find(actives.ids.begin(), actives.ids.end(), id));
+    }
+
+    LockGuard::Scoped guard(lock);
+    for(Shard* shard : shards) {
+        delete shard;
+    }
+    shards.clear();
+}
+
+Histogram::Shard* Histogram::Local()
+{
+    // { histogram id, shard } pairs
+    thread_local std::vector<std::pair<uint64_t, Shard*>> cache;
+
+    for(auto& pair : cache) {
+        if(pair.first == id) {
+            return pair.second;
+        }
+    }
+
+    Shard* shard = new Shard();
+    {
+        LockGuard::Scoped guard(lock);
+        shards.push_back(shard);
+    }
+    {
+        // destroyed: freed, ids are never reused
+        Actives& actives = GetActives();
+        LockGuard::Scoped guard(actives.lock);
+        std::erase_if(cache, [&actives](const std::pair<uint64_t, Shard*>& pair) {
+            return std::find(actives.ids.begin(), actives.ids.end(), pair.first) == actives.ids.end();
+        });
+    }
+    cache.push_back({ id, shard });
+    return shard;
+}
+
+Histogram::Actives& Histogram::GetActives()
+{
+    // constructed on first use: histograms may be constructed during static initialization
+    static Actives actives;
+    return actives;
+}
+
+Histogram::Snapshot Histogram::Collect() const
+{
+    Snapshot result;
+
+    LockGuard::Scoped guard(lock);
+    Sum(result);
+    return result;
+}
+
+void Histogram::Sum(Snapshot& result) const
+{
+    for(Shard* shard : shards) {
+        for(uint32_t i = 0; i < BUCKETS; ++i) {
+            result.counts[i] += shard->counts[i].load(std::memory_order_relaxed);
+        }
+        result.count += shard->count.load(std::memory_order_relaxed);
+        result.sum += shard->sum.load(std::memory_order_relaxed);
+        result.min = MIN(result.min, shard->min.load(std::memory_order_relaxed));
+        result.max = MAX(result.max, shard->max.load(std::memory_order_relaxed));
+    }
+}
+
+Histogram::Snapshot Histogram::Interval()
+{
+    Snapshot current;
+    Snapshot result;
+
+    {
+        // same lock as previous: concurrent calls do not subtract a newer snapshot
+        LockGuard::Scoped guard(lock);
+        Sum(current);
+        for(uint32_t i = 0; i < BUCKETS; ++i) {
+            result.counts[i] = current.counts[i] - previous.counts[i];
+        }
+        result.count = current.count - previous.count;
+        result.sum   = current.sum - previous.sum;
+        previous     = current;
+    }
+
+    // min / max of the interval: bounds of non-empty buckets
+    for(uint32_t i = 0; i < BUCKETS; ++i) {
+        if(result.counts[i]) {
+            result.min = MAX(Lower(i), current.min);
+            break;
+        }
+    }
+    for(uint32_t i = BUCKETS; i > 0; --i) {
+        if(result.counts[i - 1]) {
+            result.max = MIN(Upper(i - 1), current.max);
+            break;
+        }
+    }
+    return result;
+}
+
+const std::string& Histogram::GetName() const
+{
+    return name;
+}
@@ -0,0 +1,256 @@
+/**
+ * @file    Histogram.hpp
+ * @author  LaverWinEmpty@google.com
+ * @brief   latency histogram
+ * @version 0.0.1
+ * @date    2026-10-17
+ *
+ * @copyright Copyright (c) 2023
+ *
+ */
+
+#ifndef LWE__HISTOGRAM_HPP__
+#define LWE__HISTOGRAM_HPP__
+
+#include "bit"
+#include "atomic"
+#include "string"
+#include "vector"
+#include "Clock.hpp"
+#include "LockGuard.hpp"
+#include "../../include/include/includes.hpp"
+
+/**
+ * @brief log-linear (HDR style) histogram of nanosecond values
+ * @note  2^6 linear sub-buckets per power of 2: relative error < 1.6%, range: full uint64_t
+ *        Record(): lock-free, each thread writes own shard (no atomic RMW)
+ *        Collect() / Interval(): merge shards of all threads
+ */
+class Histogram
+{
+public:
+    /**
+     * @brief READONLY: linear sub-bucket bits
+     */
+    static const uint32_t SUB_BITS = 6;
+
+    /**
+     * @brief READONLY: bucket count
+     */
+    static const uint32_t BUCKETS = (64 - SUB_BITS + 1) << SUB_BITS;
+
+public:
+    /**
+     * @brief merged result, not thread safe
+     */
+    class Snapshot
+    {
+    public:
+        /**
+         * @brief Construct a new empty Snapshot object
+         */
+        Snapshot();
+
+    public:
+        /**
+         * @brief add other snapshot (e.g. same metric from other histogram)
+         *
+         * @param Snapshot [in]
+         */
+        void Merge(IN const Snapshot&);
+
+        /**
+         * @brief get value at percentile
+         *
+         * @param percent [in] 0 ~ 100 (e.g. 99.9)
+         * @return uint64_t upper bound of the bucket (0: empty)
+         */
+        uint64_t Percentile(IN double percent) const;
+
+        uint64_t GetCount() const;
+        uint64_t GetMin() const;
+        uint64_t GetMax() const;
+        uint64_t GetMean() const;
+
+        /**
+         * @brief summary
+         *
+         * @return std::string (e.g. "count=10 min=.. p50=.. p99=.. p99.9=.. max=.. mean=.. (ns)")
+         */
+        std::string ToString() const;
+
+    private:
+        friend class Histogram;
+
+        std::vector<uint64_t> counts;
+        uint64_t              count;
+        uint64_t              sum;
+        uint64_t              min;
+        uint64_t              max;
+    };
+
+    /**
+     * @brief record elapsed time until destruction (e.g. { Histogram::Scope scope(histogram); ... })
+     */
+    class Scope
+    {
+    public:
+        Scope(IN Histogram&);
+        ~Scope();
+
+    public:
+        DECLARE_NO_COPY(Scope);
+
+    private:
+        Histogram& owner;
+        uint64_t   begin; // Clock::Ticks()
+    };
+
+public:
+    /**
+     * @brief Construct a new Histogram object
+     *
+     * @param name [in] used by Dump()
+     */
+    Histogram(IN const char* name = "");
+
+    /**
+     * @brief Destroy the Histogram object
+     * @warning no Record() after destruction
+     */
+    ~Histogram();
+
+public:
+    DECLARE_NO_COPY(Histogram);
+
+public:
+    /**
+     * @brief record value / lock-free
+     *
+     * @param ns [in] nanoseconds (e.g. Clock::ToNS(ticks), timer.GetLastStopNS())
+     */
+    void Record(IN uint64_t ns);
+
+public:
+    /**
+     * @brief merge all threads, cumulative
+     *
+     * @return Snapshot
+     */
+    Snapshot Collect() const;
+
+    /**
+     * @brief merge all threads, since the previous Interval() call
+     * @note  min / max are bucket bounds
+     *
+     * @return Snapshot
+     */
+    Snapshot Interval();
+
+    /**
+     * @brief log Interval() summary (e.g. called by TimerWheel periodic timer)
+     *
+     * @tparam Writer LogWriter
+     * @param Writer [in]
+     */
+    template<typename Writer> void Dump(IN Writer&);
+
+    /**
+     * @brief get name
+     *
+     * @return const std::string&
+     */
+    const std::string& GetName() const;
+
+private:
+    /**
+     * @brief per-thread counters, written by the owner thread only
+     */
+    struct alignas(64) Shard
+    {
+        Shard();
+
+        std::atomic<uint64_t> counts[BUCKETS];
+        std::atomic<uint64_t> count;
+        std::atomic<uint64_t> sum;
+        std::atomic<uint64_t> min;
+        std::atomic<uint64_t> max;
+    };
+
+private:
+    /**
+     * @brief ids of histograms not destroyed yet
+     */
+    struct Actives
+    {
+        LockGuard::WrappedSpin lock;
+        std::vector<uint64_t>  ids;
+    };
+
+private:
+    /**
+     * @brief get the shard of the calling thread, create if not exist
+     * @note  creating drops the entries of destroyed histograms from the thread local cache
+     *
+     * @return Shard*
+     */
+    Shard* Local();
+
+    /**
+     * @brief add shards of all threads to the result, caller holds lock
+     *
+     * @param result [in, out]
+     */
+    void Sum(IN OUT Snapshot& result) const;
+
+    /**
+     * @brief STATIC: get ids of live histograms, constructed on first use
+     *
+     * @return Actives&
+     */
+    static Actives& GetActives();
+
+    /**
+     * @brief single writer increment
+     *
+     * @param std::atomic<uint64_t> [in, out]
+     * @param value                 [in]
+     */
+    static void Add(IN OUT std::atomic<uint64_t>&, IN uint64_t value);
+
+public:
+    /**
+     * @brief value to bucket index
+     *
+     * @param value [in]
+     * @return uint32_t
+     */
+    static uint32_t Index(IN uint64_t value);
+
+    /**
+     * @brief bucket index to lowest value
+     *
+     * @param index [in]
+     * @return uint64_t
+     */
+    static uint64_t Lower(IN uint32_t index);
+
+    /**
+     * @brief bucket index to highest value
+     *
+     * @param index [in]
+     * @return uint64_t
+     */
+    static uint64_t Upper(IN uint32_t index);
+
+private:
+    std::string         name;
+    uint64_t            id; // thread cache key
+    std::vector<Shard*> shards;
+    Snapshot            previous;
+
+    mutable LockGuard::WrappedAdaptive lock;
+};
+
+#include "Histogram.ipp"
+#endif
@@ -0,0 +1,68 @@
+inline uint32_t Histogram::Index(uint64_t value)
+{
+    const uint64_t LINEAR = uint64_t(1) << (SUB_BITS + 1);
+
+    if(value < LINEAR) {
+        return static_cast<uint32_t>(value);
+    }
+
+    // msb decides the range, next SUB_BITS bits decide the sub-bucket
+    uint32_t shift = static_cast<uint32_t>(std::bit_width(value)) - SUB_BITS - 1;
+    return (shift << SUB_BITS) + static_cast<uint32_t>(value >> shift);
+}
+
+inline uint64_t Histogram::Lower(uint32_t index)
+{
+    if(index < (uint32_t(1) << (SUB_BITS + 1))) {
+        return index;
+    }
+
+    uint32_t shift = (index >> SUB_BITS) - 1;
+    uint64_t sub   = index - (shift << SUB_BITS);
+    return sub << shift;
+}
+
+inline uint64_t Histogram::Upper(uint32_t index)
+{
+    if(index < (uint32_t(1) << (SUB_BITS + 1))) {
+        return index;
+    }
+
+    uint32_t shift = (index >> SUB_BITS) - 1;
+    return Lower(index) + ((uint64_t(1) << shift) - 1);
+}
+
+inline void Histogram::Add(std::atomic<uint64_t>& counter, uint64_t value)
+{
+    counter.store(counter.load(std::memory_order_relaxed) + value, std::memory_order_relaxed);
+}
+
+inline void Histogram::Record(uint64_t ns)
+{
+    Shard* shard = Local();
+
+    Add(shard->counts[Index(ns)], 1);
+    Add(shard->count, 1);
+    Add(shard->sum, ns);
+
+    if(ns < shard->min.load(std::memory_order_relaxed)) {
+        shard->min.store(ns, std::memory_order_relaxed);
+    }
+    if(ns > shard->max.load(std::memory_order_relaxed)) {
+        shard->max.store(ns, std::memory_order_relaxed);
+    }
+}
+
+inline Histogram::Scope::Scope(Histogram& histogram): owner(histogram), begin(Clock::Ticks()) {}
+
+inline Histogram::Scope::~Scope()
+{
+    owner.Record(Clock::ToNS(Clock::Ticks() - begin));
+}
+
+template<typename Writer> void Histogram::Dump(Writer& writer)
+{
+    std::string  text = name + ' ' + Interval().ToString();
+    std::wstring temp = std::wstring(text.begin(), text.end());
+    writer.Log(temp);
+}
@@ -17,11 +17,35 @@
 #else
 #    include "pthread.h"
 #endif
+#if __linux__
+#    include "unistd.h"
+#    include "linux/futex.h"
+#    include "sys/syscall.h"
+#endif
+#include "atomic"
+#include "thread"
+#include "cstring"
+#include "type_traits"
 #include "../../include/include/includes.hpp"
 
+#ifdef LWE_LOCK_PROFILE
+#    include "atomic"
+#    include "ostream"
+#    include "vector"
+#    include "string"
+#    include "typeinfo"
+#    include "algorithm"
+#    include "Clock.hpp"
+#    ifdef __GNUC__
+#        include "cstdlib"
+#        include "cxxabi.h"
+#    endif
+#endif
+
 /**
- * @brief lock guard, using inner class (Mutex<id> / Spin<id>)
+ * @brief lock guard, using inner class (Mutex<id> / Spin<id> / Adaptive<id> / Ticket<id> / MCS<id>)
  * @note  id: const int
+ *        LWE_LOCK_PROFILE: record contention per id, see Report()
  */
 class LockGuard abstract
 {
@@ -56,11 +80,96 @@ public:
         void Unlock();
     };
 
+    /**
+     * @brief shared lock mode
+     */
+    enum EShared
+    {
+        READ,  // shared with other readers
+        WRITE, // exclusive
+    };
+
+    /**
+     * @brief INTERFACE: reader-writer
+     *
+     * @tparam T lock object type
+     */
+    template<typename T> interface ISharedLock abstract
+    {
+    public:
+        ISharedLock(IN EShared, IN bool);
+
+    protected:
+        virtual ~ISharedLock();
+
+    public:
+        void Lock();
+        void Unlock();
+
+    private:
+        EShared mode;
+    };
+
+#ifdef LWE_LOCK_PROFILE
+public:
+    /**
+     * @brief contention statistics of one lock id
+     * @note  updated while the lock is held, so no atomic RMW
+     */
+    struct Stat
+    {
+        Stat(IN const char* name);
+
+        const char*           name;
+        Stat*                 next; // registered list
+        std::atomic<uint64_t> acquired;
+        std::atomic<uint64_t> contended;
+        std::atomic<uint64_t> waitTicks;
+        std::atomic<uint64_t> maxWaitTicks;
+        std::atomic<uint64_t> holdTicks;
+        std::atomic<uint64_t> maxHoldTicks;
+        uint64_t              holdBegin;
+    };
+
+    /**
+     * @brief get statistics of the lock id
+     *
+     * @tparam T wrapper singleton (e.g. SpinSingleT<LogBase>)
+     * @return Stat&
+     */
+    template<typename T> static Stat& Profile();
+
+    /**
+     * @brief write statistics of all used locks, most waited first
+     *
+     * @param std::ostream [out]
+     */
+    static void Report(OUT std::ostream&);
+
+private:
+    /**
+     * @brief single writer add
+     */
+    static void Add(IN OUT std::atomic<uint64_t>&, IN uint64_t value);
+
+    /**
+     * @brief single writer max
+     */
+    static void Max(IN OUT std::atomic<uint64_t>&, IN uint64_t value);
+
 private:
+    /**
+     * @brief registered list head
+     */
+    static std::atomic<Stat*>& Head();
+#endif
+
+public:
     /**
      * @brief wrapper
+     * @note  wrappers are cache line aligned, usable as instance member with Scoped
      */
-    class WrappedMutex
+    class alignas(CACHE_LINE_SIZE) WrappedMutex
     {
     public:
         WrappedMutex();
@@ -68,6 +177,8 @@ private:
     public:
         /** @note first call unconditionally */
         void Lock();
+        /** @return true: locked / false: already locked */
+        bool TryLock();
         /** @warning called first: processing abnomally */
         void Unlock();
     private:
@@ -78,7 +189,7 @@ private:
     /**
      * @brief wrapper
      */
-    class WrappedSpin
+    class alignas(CACHE_LINE_SIZE) WrappedSpin
     {
     public:
         WrappedSpin();
@@ -86,6 +197,8 @@ private:
     public:
         /** @note first call unconditionally */
         void Lock();
+        /** @return true: locked / false: already locked */
+        bool TryLock();
         /** @warning called first: processing abnomally */
         void Unlock();
     private:
@@ -93,6 +206,159 @@ private:
         uint32_t count;
     };
 
+    /**
+     * @brief wrapper, spin with backoff then park (futex / WaitOnAddress)
+     * @note  spin limit follows the recent spin count needed to acquire
+     */
+    class alignas(CACHE_LINE_SIZE) WrappedAdaptive
+    {
+    public:
+        WrappedAdaptive();
+        ~WrappedAdaptive();
+    public:
+        /** @note first call unconditionally */
+        void Lock();
+        /** @return true: locked / false: already locked */
+        bool TryLock();
+        /** @warning called first: processing abnomally */
+        void Unlock();
+    private:
+        /** @brief sleep while state == expected */
+        void Wait(IN uint32_t expected);
+        /** @brief wake one waiter */
+        void Wake();
+    private:
+        static const uint32_t UNLOCKED = 0;
+        static const uint32_t LOCKED   = 1;
+        static const uint32_t WAITING  = 2; // locked, may have sleeper
+
+        static const int32_t MAX_SPIN    = 1 << 12; // pause count
+        static const int32_t MAX_BACKOFF = 1 << 6;  // pause count per check
+    private:
+        std::atomic<uint32_t> state;
+        std::atomic<int32_t>  spin; // average pause count to acquire
+    };
+
+    /**
+     * @brief wrapper, FIFO: waiters are served in arrival order
+     * @warning spins (yields periodically), prefer Adaptive when threads outnumber cores
+     */
+    class alignas(CACHE_LINE_SIZE) WrappedTicket
+    {
+    public:
+        WrappedTicket();
+        ~WrappedTicket();
+    public:
+        /** @note first call unconditionally */
+        void Lock();
+        /** @return true: locked / false: already locked */
+        bool TryLock();
+        /** @warning called first: processing abnomally */
+        void Unlock();
+    private:
+        static const uint32_t MAX_SPIN = (1 << 10) - 1; // check count before yield, mask
+    private:
+        alignas(CACHE_LINE_SIZE) std::atomic<uint32_t> next;    // taken by arrivals
+        alignas(CACHE_LINE_SIZE) std::atomic<uint32_t> serving; // written by owner only
+    };
+
+    /**
+     * @brief wrapper, MCS queue lock: FIFO, each waiter spins on own node
+     * @note  node is thread local per lock id, so owner is one per id and thread
+     * @warning spins (yields periodically), prefer Adaptive when threads outnumber cores
+     *          as instance member: a thread must not hold two instances of the same Id at once
+     *
+     * @tparam Id singleton type
+     */
+    template<typename Id> class alignas(CACHE_LINE_SIZE) WrappedMCS
+    {
+    public:
+        WrappedMCS();
+        ~WrappedMCS();
+    public:
+        /** @note first call unconditionally */
+        void Lock();
+        /** @return true: locked / false: already locked */
+        bool TryLock();
+        /** @warning called first: processing abnomally */
+        void Unlock();
+    private:
+        struct alignas(CACHE_LINE_SIZE) Node
+        {
+            std::atomic<Node*> next;
+            std::atomic<bool>  isWaiting;
+        };
+        /** @brief node of the calling thread */
+        static Node& Local();
+    private:
+        static const uint32_t MAX_SPIN = (1 << 10) - 1; // pause count before yield, mask
+    private:
+        std::atomic<Node*> tail;
+    };
+
+    /**
+     * @brief wrapper, reader-writer: one word, waiting writer blocks new readers
+     * @note  every reader writes the word: use WrappedScalableShared for many reader threads
+     */
+    class alignas(CACHE_LINE_SIZE) WrappedShared
+    {
+    public:
+        WrappedShared();
+        ~WrappedShared();
+    public:
+        /** @note exclusive */
+        void Lock();
+        void Unlock();
+        /** @note shared */
+        void LockShared();
+        void UnlockShared();
+    private:
+        static const uint32_t WRITER  = 1u << 31;
+        static const uint32_t PENDING = 1u << 30; // writer waiting
+        static const uint32_t READERS = PENDING - 1;
+    private:
+        std::atomic<uint32_t> state;
+    };
+
+    /**
+     * @brief wrapper, reader-writer: readers count on own cache line (per thread slot)
+     * @note  reader: no shared write unless a writer is active, writer: scans all slots
+     */
+    class alignas(CACHE_LINE_SIZE) WrappedScalableShared
+    {
+    public:
+        WrappedScalableShared();
+        ~WrappedScalableShared();
+    public:
+        /** @note exclusive */
+        void Lock();
+        void Unlock();
+        /** @note shared */
+        void LockShared();
+        void UnlockShared();
+    private:
+        /** @brief slot index of the calling thread */
+        static uint32_t Index();
+    private:
+        static const uint32_t SLOTS = 64;
+
+        struct alignas(CACHE_LINE_SIZE) Slot
+        {
+            std::atomic<uint32_t> readers;
+        };
+    private:
+        Slot                          slots[SLOTS];
+        alignas(CACHE_LINE_SIZE) std::atomic<bool> isWriting;
+    };
+
+public:
+    /**
+     * @brief spin-wait step: pause, yield sometimes
+     *
+     * @param spun [in, out] step count
+     */
+    static void Backoff(IN OUT uint32_t& spun);
+
 public:
     /**
      * @brief wrapper singleton
@@ -134,6 +400,106 @@ public:
         static WrappedSpin wrapper;
     };
 
+    /**
+     * @brief wrapper singleton
+     *
+     * @tparam id
+     */
+    template<int> struct AdaptiveSingleN
+    {
+        static WrappedAdaptive wrapper;
+    };
+
+    /**
+     * @brief wrapper singleton
+     *
+     * @tparam id
+     */
+    template<typename T> struct AdaptiveSingleT
+    {
+        static WrappedAdaptive wrapper;
+    };
+
+    /**
+     * @brief wrapper singleton
+     *
+     * @tparam id
+     */
+    template<int> struct TicketSingleN
+    {
+        static WrappedTicket wrapper;
+    };
+
+    /**
+     * @brief wrapper singleton
+     *
+     * @tparam id
+     */
+    template<typename T> struct TicketSingleT
+    {
+        static WrappedTicket wrapper;
+    };
+
+    /**
+     * @brief wrapper singleton
+     *
+     * @tparam id
+     */
+    template<int N> struct MCSSingleN
+    {
+        static WrappedMCS<MCSSingleN<N>> wrapper;
+    };
+
+    /**
+     * @brief wrapper singleton
+     *
+     * @tparam id
+     */
+    template<typename T> struct MCSSingleT
+    {
+        static WrappedMCS<MCSSingleT<T>> wrapper;
+    };
+
+    /**
+     * @brief wrapper singleton
+     *
+     * @tparam id
+     */
+    template<int> struct SharedSingleN
+    {
+        static WrappedShared wrapper;
+    };
+
+    /**
+     * @brief wrapper singleton
+     *
+     * @tparam id
+     */
+    template<typename T> struct SharedSingleT
+    {
+        static WrappedShared wrapper;
+    };
+
+    /**
+     * @brief wrapper singleton
+     *
+     * @tparam id
+     */
+    template<int> struct ScalableSharedSingleN
+    {
+        static WrappedScalableShared wrapper;
+    };
+
+    /**
+     * @brief wrapper singleton
+     *
+     * @tparam id
+     */
+    template<typename T> struct ScalableSharedSingleT
+    {
+        static WrappedScalableShared wrapper;
+    };
+
 public:
     /**
      * @brief object
@@ -158,6 +524,114 @@ public:
     public:
         Spin(IN bool = true);
     };
+
+    /**
+     * @brief object, short spin then sleep: for locks held briefly but preemptable
+     * @warning redundant lock => deadlock
+     *
+     * @tparam N object id: const int
+     */
+    template<int N> class Adaptive: public ILock<AdaptiveSingleN<N>>
+    {
+    public:
+        Adaptive(IN bool = true);
+    };
+
+    /**
+     * @brief object, fair spin
+     * @warning redundant lock => infinite loop
+     *
+     * @tparam N object id: const int
+     */
+    template<int N> class Ticket: public ILock<TicketSingleN<N>>
+    {
+    public:
+        Ticket(IN bool = true);
+    };
+
+    /**
+     * @brief object, fair spin on own cache line
+     * @warning redundant lock => infinite loop
+     *
+     * @tparam N object id: const int
+     */
+    template<int N> class MCS: public ILock<MCSSingleN<N>>
+    {
+    public:
+        MCS(IN bool = true);
+    };
+
+    /**
+     * @brief object, reader-writer (e.g. Shared<0> lock(LockGuard::READ))
+     * @warning redundant lock => infinite loop
+     *
+     * @tparam N object id: const int
+     */
+    template<int N> class Shared: public ISharedLock<SharedSingleN<N>>
+    {
+    public:
+        Shared(IN EShared, IN bool = true);
+    };
+
+    /**
+     * @brief object, reader-writer for read-mostly data, reader does not share cache line
+     * @warning redundant lock => infinite loop
+     *
+     * @tparam N object id: const int
+     */
+    template<int N> class ScalableShared: public ISharedLock<ScalableSharedSingleN<N>>
+    {
+    public:
+        ScalableShared(IN EShared, IN bool = true);
+    };
+
+public:
+    /**
+     * @brief guard for instance lock (e.g. LockGuard::Scoped guard(session->lock))
+     *
+     * @tparam W wrapper (e.g. WrappedAdaptive)
+     */
+    template<typename W> class Scoped
+    {
+    public:
+        Scoped(IN W&, IN bool = true);
+        ~Scoped();
+
+    public:
+        DECLARE_NO_COPY(Scoped);
+
+    public:
+        void Lock();
+        void Unlock();
+
+    private:
+        W&   instance;
+        bool isLocked;
+    };
+
+    /**
+     * @brief reader-writer guard for instance lock (e.g. LockGuard::ScopedShared guard(table->lock, LockGuard::READ))
+     *
+     * @tparam W wrapper (WrappedShared / WrappedScalableShared)
+     */
+    template<typename W> class ScopedShared
+    {
+    public:
+        ScopedShared(IN W&, IN EShared, IN bool = true);
+        ~ScopedShared();
+
+    public:
+        DECLARE_NO_COPY(ScopedShared);
+
+    public:
+        void Lock();
+        void Unlock();
+
+    private:
+        W&      instance;
+        EShared mode;
+        bool    isLocked;
+    };
 };
 
 /**
@@ -187,6 +661,138 @@ public:
     public:
         Spin(IN bool = true);
     };
+
+    /**
+     * @brief object, short spin then sleep
+     * @warning redundant lock => deadlock
+     */
+    class Adaptive: public LockGuard::ILock<LockGuard::AdaptiveSingleT<T>>
+    {
+    public:
+        Adaptive(IN bool = true);
+    };
+
+    /**
+     * @brief object, fair spin
+     * @warning redundant lock => infinite loop
+     */
+    class Ticket: public LockGuard::ILock<LockGuard::TicketSingleT<T>>
+    {
+    public:
+        Ticket(IN bool = true);
+    };
+
+    /**
+     * @brief object, fair spin on own cache line
+     * @warning redundant lock => infinite loop
+     */
+    class MCS: public LockGuard::ILock<LockGuard::MCSSingleT<T>>
+    {
+    public:
+        MCS(IN bool = true);
+    };
+
+    /**
+     * @brief object, reader-writer (e.g. TypeLock<T>::Shared lock(LockGuard::READ))
+     * @warning redundant lock => infinite loop
+     */
+    class Shared: public LockGuard::ISharedLock<LockGuard::SharedSingleT<T>>
+    {
+    public:
+        Shared(IN LockGuard::EShared, IN bool = true);
+    };
+
+    /**
+     * @brief object, reader-writer for read-mostly data, reader does not share cache line
+     * @warning redundant lock => infinite loop
+     */
+    class ScalableShared: public LockGuard::ISharedLock<LockGuard::ScalableSharedSingleT<T>>
+    {
+    public:
+        ScalableShared(IN LockGuard::EShared, IN bool = true);
+    };
+};
+
+/**
+ * @brief lock table keyed by address: independent objects lock in parallel without own lock member
+ * @note  e.g. LockGuard::Scoped guard(table.Get(session)), unrelated objects may share a stripe
+ * @warning two objects locked at once may map to the same stripe: lock one at a time
+ *
+ * @tparam W wrapper (e.g. LockGuard::WrappedAdaptive)
+ * @tparam N stripe count, power of 2
+ */
+template<typename W, size_t N = 64> class StripedLock
+{
+    static_assert(N && (N & (N - 1)) == 0, "stripe count must be power of 2");
+
+public:
+    StripedLock() = default;
+
+public:
+    DECLARE_NO_COPY(StripedLock);
+
+public:
+    /**
+     * @brief get stripe
+     *
+     * @param address [in] object address
+     * @return W&
+     */
+    W& Get(IN const void* address);
+
+private:
+    W stripes[N]; // cache line aligned by wrapper
+};
+
+/**
+ * @brief sequence lock for small trivially copyable snapshot (e.g. config, stats)
+ * @note  reader: no write, retries while a writer runs / writer: exclusive with other writers
+ *
+ * @tparam T trivially copyable
+ */
+template<typename T> class SeqLock
+{
+    static_assert(std::is_trivially_copyable_v<T>, "SeqLock requires trivially copyable type");
+
+public:
+    /**
+     * @brief Construct a new SeqLock object
+     *
+     * @param T [in] initial value
+     */
+    SeqLock(IN const T& = T());
+
+public:
+    DECLARE_NO_COPY(SeqLock);
+
+public:
+    /**
+     * @brief read consistent copy
+     *
+     * @return T
+     */
+    T Load() const;
+
+    /**
+     * @brief write
+     *
+     * @param T [in]
+     */
+    void Store(IN const T&);
+
+private:
+    /**
+     * @brief copy word by word through atomics: no torn read is undefined
+     */
+    static void Copy(OUT std::atomic<uint64_t>* to, IN const void* from);
+    static void Copy(OUT void* to, IN const std::atomic<uint64_t>* from);
+
+private:
+    static const size_t WORDS = (sizeof(T) + sizeof(uint64_t) - 1) / sizeof(uint64_t);
+
+private:
+    std::atomic<uint32_t> sequence; // odd: writing
+    std::atomic<uint64_t> data[WORDS];
 };
 
 #include "LockGuard.ipp"
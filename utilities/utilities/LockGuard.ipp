@@ -1,9 +1,23 @@
-template<int N> LockGuard::WrappedMutex      LockGuard::MutexSingleN<N>::wrapper;
-template<typename T> LockGuard::WrappedMutex LockGuard::MutexSingleT<T>::wrapper;
-template<int N> LockGuard::WrappedSpin       LockGuard::SpinSingleN<N>::wrapper;
-template<typename T> LockGuard::WrappedSpin  LockGuard::SpinSingleT<T>::wrapper;
+template<int N> LockGuard::WrappedMutex        LockGuard::MutexSingleN<N>::wrapper;
+template<typename T> LockGuard::WrappedMutex   LockGuard::MutexSingleT<T>::wrapper;
+template<int N> LockGuard::WrappedSpin         LockGuard::SpinSingleN<N>::wrapper;
+template<typename T> LockGuard::WrappedSpin    LockGuard::SpinSingleT<T>::wrapper;
+template<int N> LockGuard::WrappedAdaptive     LockGuard::AdaptiveSingleN<N>::wrapper;
+template<typename T> LockGuard::WrappedAdaptive LockGuard::AdaptiveSingleT<T>::wrapper;
+template<int N> LockGuard::WrappedTicket       LockGuard::TicketSingleN<N>::wrapper;
+template<typename T> LockGuard::WrappedTicket  LockGuard::TicketSingleT<T>::wrapper;
+template<int N> LockGuard::WrappedMCS<LockGuard::MCSSingleN<N>>      LockGuard::MCSSingleN<N>::wrapper;
+template<typename T> LockGuard::WrappedMCS<LockGuard::MCSSingleT<T>> LockGuard::MCSSingleT<T>::wrapper;
+template<int N> LockGuard::WrappedShared                             LockGuard::SharedSingleN<N>::wrapper;
+template<typename T> LockGuard::WrappedShared                        LockGuard::SharedSingleT<T>::wrapper;
+template<int N> LockGuard::WrappedScalableShared                     LockGuard::ScalableSharedSingleN<N>::wrapper;
+template<typename T> LockGuard::WrappedScalableShared                LockGuard::ScalableSharedSingleT<T>::wrapper;
 
-LockGuard::WrappedMutex::WrappedMutex()
+#if _WIN32 || _WIN64
+#    pragma comment(lib, "Synchronization.lib")
+#endif
+
+inline LockGuard::WrappedMutex::WrappedMutex(): count(0)
 {
 #ifdef _WINDOWS_
     InitializeCriticalSection(&instance);
@@ -12,7 +26,7 @@ LockGuard::WrappedMutex::WrappedMutex()
 #endif
 }
 
-LockGuard::WrappedMutex::~WrappedMutex()
+inline LockGuard::WrappedMutex::~WrappedMutex()
 {
 #ifdef _WINDOWS_
     DeleteCriticalSection(&instance);
@@ -21,16 +35,25 @@ LockGuard::WrappedMutex::~WrappedMutex()
 #endif
 }
 
-void LockGuard::WrappedMutex::Lock()
+inline void LockGuard::WrappedMutex::Lock()
 {
 #ifdef _WINDOWS_
     EnterCriticalSection(&instance);
 #else
-    pthread_mutex_lock(instance)
+    pthread_mutex_lock(&instance);
+#endif
+}
+
+inline bool LockGuard::WrappedMutex::TryLock()
+{
+#ifdef _WINDOWS_
+    return TryEnterCriticalSection(&instance);
+#else
+    return pthread_mutex_trylock(&instance) == 0;
 #endif
 }
 
-void LockGuard::WrappedMutex::Unlock()
+inline void LockGuard::WrappedMutex::Unlock()
 {
 #ifdef _WINDOWS_
     LeaveCriticalSection(&instance);
@@ -39,7 +62,7 @@ void LockGuard::WrappedMutex::Unlock()
 #endif
 }
 
-LockGuard::WrappedSpin::WrappedSpin()
+inline LockGuard::WrappedSpin::WrappedSpin(): count(0)
 {
 #ifdef _WINDOWS_
     InitializeCriticalSectionAndSpinCount(&instance, 4000);
@@ -48,7 +71,7 @@ LockGuard::WrappedSpin::WrappedSpin()
 #endif
 }
 
-LockGuard::WrappedSpin::~WrappedSpin()
+inline LockGuard::WrappedSpin::~WrappedSpin()
 {
 #ifdef _WINDOWS_
     DeleteCriticalSection(&instance);
@@ -57,7 +80,7 @@ LockGuard::WrappedSpin::~WrappedSpin()
 #endif
 }
 
-void LockGuard::WrappedSpin::Lock()
+inline void LockGuard::WrappedSpin::Lock()
 {
 #ifdef _WINDOWS_
     EnterCriticalSection(&instance);
@@ -67,7 +90,18 @@ void LockGuard::WrappedSpin::Lock()
     ++count;
 }
 
-void LockGuard::WrappedSpin::Unlock()
+inline bool LockGuard::WrappedSpin::TryLock()
+{
+#ifdef _WINDOWS_
+    if(!TryEnterCriticalSection(&instance)) return false;
+#else
+    if(pthread_spin_trylock(&instance) != 0) return false;
+#endif
+    ++count;
+    return true;
+}
+
+inline void LockGuard::WrappedSpin::Unlock()
 {
     if(count && --count) return;
 #ifdef _WINDOWS_
@@ -77,6 +111,309 @@ void LockGuard::WrappedSpin::Unlock()
 #endif
 }
 
+inline LockGuard::WrappedAdaptive::WrappedAdaptive(): state(UNLOCKED), spin(MAX_BACKOFF) {}
+
+inline LockGuard::WrappedAdaptive::~WrappedAdaptive() {}
+
+inline void LockGuard::WrappedAdaptive::Lock()
+{
+    uint32_t curr = UNLOCKED;
+    if(state.compare_exchange_strong(curr, LOCKED, std::memory_order_acquire, std::memory_order_relaxed)) {
+        return;
+    }
+
+    // single core: holder can not run while spinning
+    static const bool isSingleCore = std::thread::hardware_concurrency() == 1;
+
+    // spin: pause with exponential backoff, bounded by twice the recent average
+    int32_t average = spin.load(std::memory_order_relaxed);
+    int32_t limit   = isSingleCore ? 0 : MIN(average * 2 + MAX_BACKOFF, MAX_SPIN);
+    int32_t backoff = 1;
+    int32_t spun    = 0;
+
+    while(spun < limit) {
+        for(int32_t i = 0; i < backoff; ++i) {
+            CPU_PAUSE();
+        }
+        spun += backoff;
+        backoff = MIN(backoff * 2, MAX_BACKOFF);
+
+        curr = state.load(std::memory_order_relaxed);
+        if(curr == UNLOCKED &&
+           state.compare_exchange_weak(curr, LOCKED, std::memory_order_acquire, std::memory_order_relaxed)) {
+            spin.store(average + (spun - average) / 8, std::memory_order_relaxed);
+            return;
+        }
+    }
+
+    // park: spinning did not pay, spin less next time
+    spin.store(average - average / 8, std::memory_order_relaxed);
+
+    curr = state.exchange(WAITING, std::memory_order_acquire);
+    while(curr != UNLOCKED) {
+        Wait(WAITING);
+        curr = state.exchange(WAITING, std::memory_order_acquire);
+    }
+}
+
+inline bool LockGuard::WrappedAdaptive::TryLock()
+{
+    uint32_t curr = UNLOCKED;
+    return state.compare_exchange_strong(curr, LOCKED, std::memory_order_acquire, std::memory_order_relaxed);
+}
+
+inline void LockGuard::WrappedAdaptive::Unlock()
+{
+    if(state.exchange(UNLOCKED, std::memory_order_release) == WAITING) {
+        Wake();
+    }
+}
+
+inline void LockGuard::WrappedAdaptive::Wait(uint32_t expected)
+{
+#if __linux__
+    syscall(SYS_futex, reinterpret_cast<uint32_t*>(&state), FUTEX_WAIT_PRIVATE, expected, nullptr, nullptr, 0);
+#elif _WIN32 || _WIN64
+    WaitOnAddress(&state, &expected, sizeof(expected), INFINITE);
+#else
+    state.wait(expected, std::memory_order_relaxed);
+#endif
+}
+
+inline void LockGuard::WrappedAdaptive::Wake()
+{
+#if __linux__
+    syscall(SYS_futex, reinterpret_cast<uint32_t*>(&state), FUTEX_WAKE_PRIVATE, 1, nullptr, nullptr, 0);
+#elif _WIN32 || _WIN64
+    WakeByAddressSingle(&state);
+#else
+    state.notify_one();
+#endif
+}
+
+inline LockGuard::WrappedTicket::WrappedTicket(): next(0), serving(0) {}
+
+inline LockGuard::WrappedTicket::~WrappedTicket() {}
+
+inline void LockGuard::WrappedTicket::Lock()
+{
+    uint32_t ticket = next.fetch_add(1, std::memory_order_relaxed);
+    uint32_t spun   = 0;
+
+    while(true) {
+        uint32_t curr = serving.load(std::memory_order_acquire);
+        if(curr == ticket) {
+            return;
+        }
+
+        // proportional backoff: fewer reads of the shared line
+        for(uint32_t i = ticket - curr; i > 0; --i) {
+            CPU_PAUSE();
+        }
+
+        // preempted owner or predecessor: give the core
+        if((++spun & MAX_SPIN) == 0) {
+            std::this_thread::yield();
+        }
+    }
+}
+
+inline bool LockGuard::WrappedTicket::TryLock()
+{
+    uint32_t curr     = serving.load(std::memory_order_relaxed);
+    uint32_t expected = curr;
+    return next.compare_exchange_strong(expected, curr + 1, std::memory_order_acquire, std::memory_order_relaxed);
+}
+
+inline void LockGuard::WrappedTicket::Unlock()
+{
+    serving.store(serving.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+}
+
+template<typename Id> LockGuard::WrappedMCS<Id>::WrappedMCS(): tail(nullptr) {}
+
+template<typename Id> LockGuard::WrappedMCS<Id>::~WrappedMCS() {}
+
+template<typename Id> void LockGuard::WrappedMCS<Id>::Lock()
+{
+    Node& node = Local();
+    node.next.store(nullptr, std::memory_order_relaxed);
+    node.isWaiting.store(true, std::memory_order_relaxed);
+
+    Node* prev = tail.exchange(&node, std::memory_order_acq_rel);
+    if(prev == nullptr) {
+        return;
+    }
+
+    // link, then spin on own node until the predecessor hands over
+    prev->next.store(&node, std::memory_order_release);
+    for(uint32_t spun = 1; node.isWaiting.load(std::memory_order_acquire); ++spun) {
+        CPU_PAUSE();
+
+        // preempted owner or predecessor: give the core
+        if((spun & MAX_SPIN) == 0) {
+            std::this_thread::yield();
+        }
+    }
+}
+
+template<typename Id> bool LockGuard::WrappedMCS<Id>::TryLock()
+{
+    Node& node = Local();
+    node.next.store(nullptr, std::memory_order_relaxed);
+    node.isWaiting.store(false, std::memory_order_relaxed);
+
+    Node* expected = nullptr;
+    return tail.compare_exchange_strong(expected, &node, std::memory_order_acquire, std::memory_order_relaxed);
+}
+
+template<typename Id> void LockGuard::WrappedMCS<Id>::Unlock()
+{
+    Node& node = Local();
+    Node* next = node.next.load(std::memory_order_acquire);
+
+    if(next == nullptr) {
+        // no successor: release
+        Node* expected = &node;
+        if(tail.compare_exchange_strong(expected, nullptr, std::memory_order_release, std::memory_order_relaxed)) {
+            return;
+        }
+
+        // successor is linking
+        while((next = node.next.load(std::memory_order_acquire)) == nullptr) {
+            std::this_thread::yield();
+        }
+    }
+    next->isWaiting.store(false, std::memory_order_release);
+}
+
+template<typename Id> typename LockGuard::WrappedMCS<Id>::Node& LockGuard::WrappedMCS<Id>::Local()
+{
+    thread_local Node node;
+    return node;
+}
+
+inline LockGuard::WrappedShared::WrappedShared(): state(0) {}
+
+inline LockGuard::WrappedShared::~WrappedShared() {}
+
+inline void LockGuard::WrappedShared::Lock()
+{
+    uint32_t spun = 0;
+    while(true) {
+        uint32_t curr = state.load(std::memory_order_relaxed);
+
+        // no writer, no reader: take, clear own pending mark
+        if((curr & (WRITER | READERS)) == 0) {
+            if(state.compare_exchange_weak(curr, WRITER, std::memory_order_acquire, std::memory_order_relaxed)) {
+                return;
+            }
+            continue;
+        }
+
+        // block new readers
+        if((curr & PENDING) == 0) {
+            state.fetch_or(PENDING, std::memory_order_relaxed);
+        }
+        Backoff(spun);
+    }
+}
+
+inline void LockGuard::WrappedShared::Unlock()
+{
+    state.fetch_and(~WRITER, std::memory_order_release);
+}
+
+inline void LockGuard::WrappedShared::LockShared()
+{
+    uint32_t spun = 0;
+    while(true) {
+        uint32_t curr = state.load(std::memory_order_relaxed);
+        if((curr & (WRITER | PENDING)) == 0) {
+            if(state.compare_exchange_weak(curr, curr + 1, std::memory_order_acquire, std::memory_order_relaxed)) {
+                return;
+            }
+            continue;
+        }
+        Backoff(spun);
+    }
+}
+
+inline void LockGuard::WrappedShared::UnlockShared()
+{
+    state.fetch_sub(1, std::memory_order_release);
+}
+
+inline LockGuard::WrappedScalableShared::WrappedScalableShared(): slots{}, isWriting(false) {}
+
+inline LockGuard::WrappedScalableShared::~WrappedScalableShared() {}
+
+inline void LockGuard::WrappedScalableShared::Lock()
+{
+    uint32_t spun = 0;
+
+    // exclusive with other writers
+    bool expected = false;
+    while(!isWriting.compare_exchange_weak(expected, true, std::memory_order_seq_cst, std::memory_order_relaxed)) {
+        expected = false;
+        Backoff(spun);
+    }
+
+    // wait readers to leave
+    for(uint32_t i = 0; i < SLOTS; ++i) {
+        while(slots[i].readers.load(std::memory_order_seq_cst) != 0) {
+            Backoff(spun);
+        }
+    }
+}
+
+inline void LockGuard::WrappedScalableShared::Unlock()
+{
+    isWriting.store(false, std::memory_order_release);
+}
+
+inline void LockGuard::WrappedScalableShared::LockShared()
+{
+    Slot&    slot = slots[Index()];
+    uint32_t spun = 0;
+
+    while(true) {
+        // announce, then check writer: pairs with writer's flag, then scan
+        slot.readers.fetch_add(1, std::memory_order_seq_cst);
+        if(!isWriting.load(std::memory_order_seq_cst)) {
+            return;
+        }
+
+        // back off for writer
+        slot.readers.fetch_sub(1, std::memory_order_relaxed);
+        while(isWriting.load(std::memory_order_relaxed)) {
+            Backoff(spun);
+        }
+    }
+}
+
+inline void LockGuard::WrappedScalableShared::UnlockShared()
+{
+    slots[Index()].readers.fetch_sub(1, std::memory_order_release);
+}
+
+inline uint32_t LockGuard::WrappedScalableShared::Index()
+{
+    static std::atomic<uint32_t> generator(0);
+    thread_local uint32_t        index = generator.fetch_add(1, std::memory_order_relaxed) % SLOTS;
+    return index;
+}
+
+inline void LockGuard::Backoff(uint32_t& spun)
+{
+    if((++spun & ((1 << 10) - 1)) == 0) {
+        std::this_thread::yield();
+    }
+    else {
+        CPU_PAUSE();
+    }
+}
+
 template<typename T> LockGuard::ILock<T>::ILock(bool isLock)
 {
     if(isLock) {
@@ -91,18 +428,316 @@ template<typename T> LockGuard::ILock<T>::~ILock()
 
 template<typename T> void LockGuard::ILock<T>::Lock()
 {
+#ifdef LWE_LOCK_PROFILE
+    uint64_t wait        = 0;
+    bool     isContended = !T::wrapper.TryLock();
+
+    // measure only when contended
+    if(isContended) {
+        uint64_t begin = Clock::Ticks();
+        T::wrapper.Lock();
+        wait = Clock::Ticks() - begin;
+    }
+
+    // locked: owner only
+    Stat& stat = Profile<T>();
+    Add(stat.acquired, 1);
+    if(isContended) {
+        Add(stat.contended, 1);
+        Add(stat.waitTicks, wait);
+        Max(stat.maxWaitTicks, wait);
+    }
+    stat.holdBegin = Clock::Ticks();
+#else
     T::wrapper.Lock();
+#endif
 }
 
 template<typename T> void LockGuard::ILock<T>::Unlock()
 {
+#ifdef LWE_LOCK_PROFILE
+    Stat&    stat = Profile<T>();
+    uint64_t hold = Clock::Ticks() - stat.holdBegin;
+    Add(stat.holdTicks, hold);
+    Max(stat.maxHoldTicks, hold);
+#endif
     T::wrapper.Unlock();
 }
 
+#ifdef LWE_LOCK_PROFILE
+inline LockGuard::Stat::Stat(const char* name):
+    name(name), next(nullptr), acquired(0), contended(0), waitTicks(0), maxWaitTicks(0), holdTicks(0), maxHoldTicks(0),
+    holdBegin(0)
+{
+    // push front, lock-free: registered during locking
+    std::atomic<Stat*>& head = Head();
+    next                     = head.load(std::memory_order_relaxed);
+    while(!head.compare_exchange_weak(next, this, std::memory_order_release, std::memory_order_relaxed)) {
+        continue;
+    }
+}
+
+template<typename T> LockGuard::Stat& LockGuard::Profile()
+{
+    static Stat stat(typeid(T).name());
+    return stat;
+}
+
+inline std::atomic<LockGuard::Stat*>& LockGuard::Head()
+{
+    static std::atomic<Stat*> head(nullptr);
+    return head;
+}
+
+inline void LockGuard::Add(std::atomic<uint64_t>& counter, uint64_t value)
+{
+    counter.store(counter.load(std::memory_order_relaxed) + value, std::memory_order_relaxed);
+}
+
+inline void LockGuard::Max(std::atomic<uint64_t>& counter, uint64_t value)
+{
+    if(value > counter.load(std::memory_order_relaxed)) {
+        counter.store(value, std::memory_order_relaxed);
+    }
+}
+
+inline void LockGuard::Report(std::ostream& os)
+{
+    std::vector<Stat*> stats;
+    for(Stat* iter = Head().load(std::memory_order_acquire); iter; iter = iter->next) {
+        stats.push_back(iter);
+    }
+
+    std::sort(stats.begin(), stats.end(), [](Stat* lhs, Stat* rhs) {
+        return lhs->waitTicks.load(std::memory_order_relaxed) > rhs->waitTicks.load(std::memory_order_relaxed);
+    });
+
+    for(Stat* stat : stats) {
+        uint64_t acquired  = stat->acquired.load(std::memory_order_relaxed);
+        uint64_t contended = stat->contended.load(std::memory_order_relaxed);
+
+        std::string name = stat->name;
+#    ifdef __GNUC__
+        int   status    = 0;
+        char* demangled = abi::__cxa_demangle(stat->name, nullptr, nullptr, &status);
+        if(status == 0 && demangled) {
+            name = demangled;
+        }
+        free(demangled);
+#    endif
+
+        os << name << " acquired=" << acquired << " contended=" << contended << " ("
+           << (acquired ? static_cast<double>(contended) * 100 / acquired : 0) << "%)"
+           << " wait total=" << Clock::ToNS(stat->waitTicks.load(std::memory_order_relaxed))
+           << "ns max=" << Clock::ToNS(stat->maxWaitTicks.load(std::memory_order_relaxed))
+           << "ns hold total=" << Clock::ToNS(stat->holdTicks.load(std::memory_order_relaxed))
+           << "ns max=" << Clock::ToNS(stat->maxHoldTicks.load(std::memory_order_relaxed)) << "ns\n";
+    }
+}
+#endif
+
 template<int N> LockGuard::Mutex<N>::Mutex(bool isLock): LockGuard::ILock<LockGuard::MutexSingleN<N>>(isLock) {}
 
 template<int N> LockGuard::Spin<N>::Spin(bool isLock): LockGuard::ILock<LockGuard::SpinSingleN<N>>(isLock) {}
 
+template<int N>
+LockGuard::Adaptive<N>::Adaptive(bool isLock): LockGuard::ILock<LockGuard::AdaptiveSingleN<N>>(isLock)
+{}
+
+template<int N> LockGuard::Ticket<N>::Ticket(bool isLock): LockGuard::ILock<LockGuard::TicketSingleN<N>>(isLock) {}
+
+template<int N> LockGuard::MCS<N>::MCS(bool isLock): LockGuard::ILock<LockGuard::MCSSingleN<N>>(isLock) {}
+
 template<typename T> TypeLock<T>::Mutex::Mutex(bool isLock): LockGuard::ILock<LockGuard::MutexSingleT<T>>(isLock) {}
 
-template<typename T> TypeLock<T>::Spin::Spin(bool isLock): LockGuard::ILock<LockGuard::SpinSingleT<T>>(isLock) {}
\ No newline at end of file
+template<typename T> TypeLock<T>::Spin::Spin(bool isLock): LockGuard::ILock<LockGuard::SpinSingleT<T>>(isLock) {}
+
+template<typename T>
+TypeLock<T>::Adaptive::Adaptive(bool isLock): LockGuard::ILock<LockGuard::AdaptiveSingleT<T>>(isLock)
+{}
+
+template<typename T>
+TypeLock<T>::Ticket::Ticket(bool isLock): LockGuard::ILock<LockGuard::TicketSingleT<T>>(isLock)
+{}
+
+template<typename T> TypeLock<T>::MCS::MCS(bool isLock): LockGuard::ILock<LockGuard::MCSSingleT<T>>(isLock) {}
+template<typename T> LockGuard::ISharedLock<T>::ISharedLock(EShared mode, bool isLock): mode(mode)
+{
+    if(isLock) {
+        Lock();
+    }
+}
+
+template<typename T> LockGuard::ISharedLock<T>::~ISharedLock()
+{
+    Unlock();
+}
+
+template<typename T> void LockGuard::ISharedLock<T>::Lock()
+{
+    if(mode == READ) {
+        T::wrapper.LockShared();
+    }
+    else {
+        T::wrapper.Lock();
+    }
+}
+
+template<typename T> void LockGuard::ISharedLock<T>::Unlock()
+{
+    if(mode == READ) {
+        T::wrapper.UnlockShared();
+    }
+    else {
+        T::wrapper.Unlock();
+    }
+}
+
+template<int N>
+LockGuard::Shared<N>::Shared(EShared mode, bool isLock): LockGuard::ISharedLock<LockGuard::SharedSingleN<N>>(mode, isLock)
+{}
+
+template<int N>
+LockGuard::ScalableShared<N>::ScalableShared(EShared mode, bool isLock):
+    LockGuard::ISharedLock<LockGuard::ScalableSharedSingleN<N>>(mode, isLock)
+{}
+
+template<typename T>
+TypeLock<T>::Shared::Shared(LockGuard::EShared mode, bool isLock):
+    LockGuard::ISharedLock<LockGuard::SharedSingleT<T>>(mode, isLock)
+{}
+
+template<typename T>
+TypeLock<T>::ScalableShared::ScalableShared(LockGuard::EShared mode, bool isLock):
+    LockGuard::ISharedLock<LockGuard::ScalableSharedSingleT<T>>(mode, isLock)
+{}
+
+template<typename T> SeqLock<T>::SeqLock(const T& param): sequence(0), data{}
+{
+    Copy(data, &param);
+}
+
+template<typename T> T SeqLock<T>::Load() const
+{
+    T        result;
+    uint32_t spun = 0;
+
+    while(true) {
+        uint32_t before = sequence.load(std::memory_order_acquire);
+        if((before & 1) == 0) {
+            Copy(&result, data);
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if(sequence.load(std::memory_order_relaxed) == before) {
+                return result;
+            }
+        }
+        LockGuard::Backoff(spun);
+    }
+}
+
+template<typename T> void SeqLock<T>::Store(const T& param)
+{
+    uint32_t spun = 0;
+    uint32_t curr = sequence.load(std::memory_order_relaxed);
+
+    // odd: other writer
+    while((curr & 1) ||
+          !sequence.compare_exchange_weak(curr, curr + 1, std::memory_order_acquire, std::memory_order_relaxed)) {
+        LockGuard::Backoff(spun);
+        curr = sequence.load(std::memory_order_relaxed);
+    }
+    std::atomic_thread_fence(std::memory_order_release);
+
+    Copy(data, &param);
+    sequence.store(curr + 2, std::memory_order_release);
+}
+
+template<typename T> void SeqLock<T>::Copy(std::atomic<uint64_t>* to, const void* from)
+{
+    uint64_t words[WORDS] = { 0 };
+    std::memcpy(words, from, sizeof(T));
+    for(size_t i = 0; i < WORDS; ++i) {
+        to[i].store(words[i], std::memory_order_relaxed);
+    }
+}
+
+template<typename T> void SeqLock<T>::Copy(void* to, const std::atomic<uint64_t>* from)
+{
+    uint64_t words[WORDS];
+    for(size_t i = 0; i < WORDS; ++i) {
+        words[i] = from[i].load(std::memory_order_relaxed);
+    }
+    std::memcpy(to, words, sizeof(T));
+}
+
+template<typename W> LockGuard::Scoped<W>::Scoped(W& instance, bool isLock): instance(instance), isLocked(false)
+{
+    if(isLock) {
+        Lock();
+    }
+}
+
+template<typename W> LockGuard::Scoped<W>::~Scoped()
+{
+    if(isLocked) {
+        Unlock();
+    }
+}
+
+template<typename W> void LockGuard::Scoped<W>::Lock()
+{
+    instance.Lock();
+    isLocked = true;
+}
+
+template<typename W> void LockGuard::Scoped<W>::Unlock()
+{
+    isLocked = false;
+    instance.Unlock();
+}
+
+template<typename W>
+LockGuard::ScopedShared<W>::ScopedShared(W& instance, EShared mode, bool isLock):
+    instance(instance), mode(mode), isLocked(false)
+{
+    if(isLock) {
+        Lock();
+    }
+}
+
+template<typename W> LockGuard::ScopedShared<W>::~ScopedShared()
+{
+    if(isLocked) {
+        Unlock();
+    }
+}
+
+template<typename W> void LockGuard::ScopedShared<W>::Lock()
+{
+    if(mode == READ) {
+        instance.LockShared();
+    }
+    else {
+        instance.Lock();
+    }
+    isLocked = true;
+}
+
+template<typename W> void LockGuard::ScopedShared<W>::Unlock()
+{
+    isLocked = false;
+    if(mode == READ) {
+        instance.UnlockShared();
+    }
+    else {
+        instance.Unlock();
+    }
+}
+
+template<typename W, size_t N> W& StripedLock<W, N>::Get(const void* address)
+{
+    // drop in-line bits, mix upper bits down (fibonacci hashing)
+    uint64_t key = static_cast<uint64_t>(reinterpret_cast<uintptr_t>(address)) >> 6;
+    key *= 0x9E3779B97F4A7C15ull;
+    return stripes[(key >> 32) & (N - 1)];
+}
@@ -0,0 +1,119 @@
+#include "Profiler.hpp"
+#include "fstream"
+#include "filesystem"
+#include "cstdio"
+
+std::vector<Profiler::Buffer*> Profiler::buffers;
+
+Profiler::Buffer::Buffer(uint32_t tid): events{}, head(0), threadName(nullptr), tid(tid) {}
+
+void Profiler::SetThreadName(const char* name)
+{
+    Local()->threadName.store(name, std::memory_order_release);
+}
+
+Profiler::Buffer* Profiler::Register()
+{
+    TypeLock<Profiler>::Spin lock;
+
+    Buffer* buffer = new Buffer(static_cast<uint32_t>(buffers.size()) + 1);
+    buffers.push_back(buffer);
+    return buffer;
+}
+
+void Profiler::Export(std::ostream& os)
+{
+    std::vector<Event> events;
+    bool               isFirst = true;
+
+    os << "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[";
+
+    TypeLock<Profiler>::Spin lock;
+    for(Buffer* buffer : buffers) {
+        const char* threadName = buffer->threadName.load(std::memory_order_acquire);
+        if(threadName) {
+            os << (isFirst ? "" : ",") << "\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << buffer->tid
+               << ",\"args\":{\"name\":";
+            Escape(os, threadName);
+            os << "}}";
+            isFirst = false;
+        }
+
+        // copy, then drop the part overwritten while copying
+        uint64_t head  = buffer->head.load(std::memory_order_acquire);
+        uint64_t begin = head > CAPACITY ? head - CAPACITY : 0;
+
+        events.clear();
+        for(uint64_t i = begin; i < head; ++i) {
+            events.push_back(buffer->events[i & (CAPACITY - 1)]);
+        }
+
+        // slot of the event after "after" may be being written: same slot as after - CAPACITY
+        uint64_t after = buffer->head.load(std::memory_order_acquire);
+        uint64_t valid = after >= CAPACITY ? after - CAPACITY + 1 : 0;
+        size_t   skip  = valid > begin ? static_cast<size_t>(MIN(valid - begin, head - begin)) : 0;
+
+        // 2 x (20 digits + 4) + 22: 70 byte
+        char text[128];
+        for(size_t i = skip; i < events.size(); ++i) {
+            const Event& event = events[i];
+
+            // microseconds, nanosecond fraction
+            uint64_t ts  = Clock::ToNS(event.begin);
+            uint64_t dur = event.end > event.begin ? Clock::ToNS(event.end - event.begin) : 0;
+
+            os << (isFirst ? "" : ",") << "\n{\"name\":";
+            Escape(os, event.name);
+            snprintf(text,
+                     sizeof(text),
+                     ",\"ph\":\"X\",\"ts\":%llu.%03u,\"dur\":%llu.%03u",
+                     static_cast<unsigned long long>(ts / 1000),
+                     static_cast<unsigned>(ts % 1000),
+                     static_cast<unsigned long long>(dur / 1000),
+                     static_cast<unsigned>(dur % 1000));
+            os << text << ",\"pid\":1,\"tid\":" << buffer->tid << '}';
+            isFirst = false;
+        }
+    }
+
+    os << "\n]}\n";
+}
+
+bool Profiler::Export(const std::wstring& path)
+{
+    std::ofstream file(std::filesystem::path(path), std::ios_base::out | std::ios_base::trunc);
+    if(!file.is_open()) {
+        return false;
+    }
+
+    Export(file);
+    return file.good();
+}
+
+void Profiler::Clear()
+{
+    TypeLock<Profiler>::Spin lock;
+    for(Buffer* buffer : buffers) {
+        buffer->head.store(0, std::memory_order_relaxed);
+    }
+}
+
+void Profiler::Escape(std::ostream& os, const char* text)
+{
+    os << '"';
+    for(const char* iter = text ? text : ""; *iter; ++iter) {
+        char ch = *iter;
+        if(ch == '"' || ch == '\\') {
+            os << '\\' << ch;
+        }
+        else if(static_cast<unsigned char>(ch) < 0x20) {
+            char temp[8];
+            snprintf(temp, sizeof(temp), "\\u%04x", static_cast<unsigned>(ch));
+            os << temp;
+        }
+        else {
+            os << ch;
+        }
+    }
+    os << '"';
+}
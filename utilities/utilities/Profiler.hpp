@@ -0,0 +1,175 @@
+/**
+ * @file    Profiler.hpp
+ * @author  LaverWinEmpty@google.com
+ * @brief   scoped profiling zone and trace export
+ * @version 0.0.1
+ * @date    2026-10-17
+ *
+ * @copyright Copyright (c) 2023
+ *
+ */
+
+#ifndef LWE__PROFILER_HPP__
+#define LWE__PROFILER_HPP__
+
+#include "atomic"
+#include "string"
+#include "vector"
+#include "ostream"
+#include "Clock.hpp"
+#include "LockGuard.hpp"
+#include "../../include/include/includes.hpp"
+
+#define PROFILE_CONCAT_(x, y) x##y
+#define PROFILE_CONCAT(x, y)  PROFILE_CONCAT_(x, y)
+
+/**
+ * @brief record scope as a zone (e.g. { PROFILE_ZONE("Session::Recv"); ... })
+ * @note  enabled by defining LWE_PROFILE, otherwise expands to nothing
+ *
+ * @param name [in] string literal, static storage
+ */
+#ifdef LWE_PROFILE
+#    define PROFILE_ZONE(name) Profiler::Zone PROFILE_CONCAT(profileZone, __LINE__)(name)
+#else
+#    define PROFILE_ZONE(name) pass
+#endif
+
+/**
+ * @brief name the calling thread in the trace (e.g. PROFILE_THREAD("LogWriter"))
+ *
+ * @param name [in] string literal, static storage
+ */
+#ifdef LWE_PROFILE
+#    define PROFILE_THREAD(name) Profiler::SetThreadName(name)
+#else
+#    define PROFILE_THREAD(name) pass
+#endif
+
+/**
+ * @brief STATIC: per-thread zone recorder
+ * @note  each thread writes begin / end ticks into own ring buffer (oldest is overwritten)
+ *        Export(): Chrome trace event JSON, open with chrome://tracing or ui.perfetto.dev
+ */
+class Profiler
+{
+public:
+    DECLARE_LIMIT_LIFECYCLE(Profiler);
+
+public:
+    /**
+     * @brief READONLY: events per thread, power of 2
+     */
+    static const size_t CAPACITY = 1 << 14;
+
+public:
+    /**
+     * @brief RAII zone, use PROFILE_ZONE()
+     */
+    class Zone
+    {
+    public:
+        Zone(IN const char* name);
+        ~Zone();
+
+    public:
+        DECLARE_NO_COPY(Zone);
+
+    private:
+        const char* name;
+        uint64_t    begin; // Clock::Ticks()
+    };
+
+public:
+    /**
+     * @brief record zone / lock-free
+     *
+     * @param name  [in] static storage string
+     * @param begin [in] Clock::Ticks()
+     * @param end   [in] Clock::Ticks()
+     */
+    static void Emit(IN const char* name, IN uint64_t begin, IN uint64_t end);
+
+    /**
+     * @brief set trace thread name of the calling thread
+     *
+     * @param name [in] static storage string
+     */
+    static void SetThreadName(IN const char* name);
+
+    /**
+     * @brief write recorded zones of all threads
+     * @note  zones overwritten while exporting are skipped, a full buffer exports CAPACITY - 1
+     *
+     * @param std::ostream [out]
+     */
+    static void Export(OUT std::ostream&);
+
+    /**
+     * @brief write recorded zones of all threads to file
+     *
+     * @param path [in] (e.g. L"trace.json")
+     * @return true: succeeded / false: failed to open
+     */
+    static bool Export(IN const std::wstring& path);
+
+    /**
+     * @brief discard recorded zones
+     * @warning not thread safe with recording threads
+     */
+    static void Clear();
+
+private:
+    /**
+     * @brief complete event
+     */
+    struct Event
+    {
+        const char* name;
+        uint64_t    begin;
+        uint64_t    end;
+    };
+
+    /**
+     * @brief per-thread ring buffer, single writer
+     * @note  kept after the thread exits, for export
+     */
+    struct Buffer
+    {
+        Buffer(IN uint32_t tid);
+
+        Event                    events[CAPACITY];
+        std::atomic<uint64_t>    head; // written count
+        std::atomic<const char*> threadName;
+        uint32_t                 tid;
+    };
+
+private:
+    /**
+     * @brief get the buffer of the calling thread, create if not exist
+     *
+     * @return Buffer*
+     */
+    static Buffer* Local();
+
+    /**
+     * @brief create and register buffer
+     *
+     * @return Buffer*
+     */
+    static Buffer* Register();
+
+    /**
+     * @brief write JSON string
+     *
+     * @param std::ostream [out]
+     * @param text         [in]
+     */
+    static void Escape(OUT std::ostream&, IN const char* text);
+
+private:
+    static std::vector<Buffer*> buffers;
+};
+
+#include "Profiler.ipp"
+#endif
@@ -0,0 +1,28 @@
+inline Profiler::Zone::Zone(const char* name): name(name), begin(Clock::Ticks()) {}
+
+inline Profiler::Zone::~Zone()
+{
+    Emit(name, begin, Clock::Ticks());
+}
+
+inline void Profiler::Emit(const char* name, uint64_t begin, uint64_t end)
+{
+    Buffer*  buffer = Local();
+    uint64_t head   = buffer->head.load(std::memory_order_relaxed);
+    Event&   event  = buffer->events[head & (CAPACITY - 1)];
+
+    event.name  = name;
+    event.begin = begin;
+    event.end   = end;
+
+    buffer->head.store(head + 1, std::memory_order_release);
+}
+
+inline Profiler::Buffer* Profiler::Local()
+{
+    thread_local Buffer* local = nullptr;
+    if(local == nullptr) {
+        local = Register();
+    }
+    return local;
+}
@@ -0,0 +1,109 @@
+/**
+ * @file    RingQueue.hpp
+ * @author  LaverWinEmpty@google.com
+ * @brief   bounded lock-free queue
+ * @version 0.0.1
+ * @date    2026-10-17
+ *
+ * @copyright Copyright (c) 2023
+ *
+ */
+
+#ifndef LWE__RINGQUEUE_HPP__
+#define LWE__RINGQUEUE_HPP__
+
+#include "atomic"
+#include "utility"
+#include "../../include/include/includes.hpp"
+
+/**
+ * @brief bounded lock-free queue, each slot has own sequence number
+ * @note  multi producer / multi consumer safe (LogWriter uses it as MPSC)
+ *
+ * @tparam T element type, default constructible and movable
+ */
+template<typename T> class RingQueue
+{
+public:
+    /**
+     * @brief Construct a new RingQueue object
+     *
+     * @param capacity [in] rounded up to a power of 2 (min 2)
+     */
+    RingQueue(IN size_t capacity);
+
+    /**
+     * @brief Destroy the RingQueue object
+     */
+    ~RingQueue();
+
+public:
+    DECLARE_NO_COPY(RingQueue);
+
+public:
+    /**
+     * @brief enqueue / lock-free
+     *
+     * @param T [in] moved when succeeded
+     * @return true: succeeded / false: full
+     */
+    bool Push(IN T&&);
+
+    /**
+     * @brief dequeue / lock-free
+     *
+     * @param T [out] moved from the slot
+     * @return true: succeeded / false: empty
+     */
+    bool Pop(OUT T&);
+
+public:
+    /**
+     * @brief get slot count
+     *
+     * @return size_t (power of 2)
+     */
+    size_t GetCapacity() const;
+
+    /**
+     * @brief get element count
+     * @warning approximate value under concurrency
+     *
+     * @return size_t
+     */
+    size_t GetSize() const;
+
+private:
+    /**
+     * @brief element with sequence number
+     */
+    struct Slot
+    {
+        std::atomic<size_t> sequence;
+        T                   data;
+    };
+
+private:
+    /**
+     * @brief slot array
+     */
+    Slot* slots;
+
+    /**
+     * @brief capacity - 1
+     */
+    size_t mask;
+
+    /**
+     * @brief enqueue position, separated cache line
+     */
+    alignas(64) std::atomic<size_t> head;
+
+    /**
+     * @brief dequeue position, separated cache line
+     */
+    alignas(64) std::atomic<size_t> tail;
+};
+
+#include "RingQueue.ipp"
+#endif
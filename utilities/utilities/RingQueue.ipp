@@ -0,0 +1,96 @@
+template<typename T> RingQueue<T>::RingQueue(size_t capacity): head(0), tail(0)
+{
+    size_t size = 2;
+    while(size < capacity) {
+        size <<= 1;
+    }
+
+    mask  = size - 1;
+    slots = new Slot[size];
+    for(size_t i = 0; i < size; ++i) {
+        slots[i].sequence.store(i, std::memory_order_relaxed);
+    }
+}
+
+template<typename T> RingQueue<T>::~RingQueue()
+{
+    SAFE_DELETES(slots);
+}
+
+template<typename T> bool RingQueue<T>::Push(T&& param)
+{
+    Slot*  slot;
+    size_t pos = head.load(std::memory_order_relaxed);
+
+    while(true) {
+        slot          = &slots[pos & mask];
+        size_t seq    = slot->sequence.load(std::memory_order_acquire);
+        intptr_t diff = static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos);
+
+        // empty slot: claim
+        if(diff == 0) {
+            if(head.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                break;
+            }
+        }
+
+        // not consumed yet: full
+        else if(diff < 0) {
+            return false;
+        }
+
+        // other producer claimed: retry
+        else {
+            pos = head.load(std::memory_order_relaxed);
+        }
+    }
+
+    slot->data = std::move(param);
+    slot->sequence.store(pos + 1, std::memory_order_release);
+    return true;
+}
+
+template<typename T> bool RingQueue<T>::Pop(T& out)
+{
+    Slot*  slot;
+    size_t pos = tail.load(std::memory_order_relaxed);
+
+    while(true) {
+        slot          = &slots[pos & mask];
+        size_t seq    = slot->sequence.load(std::memory_order_acquire);
+        intptr_t diff = static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos + 1);
+
+        // filled slot: claim
+        if(diff == 0) {
+            if(tail.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                break;
+            }
+        }
+
+        // not produced yet: empty
+        else if(diff < 0) {
+            return false;
+        }
+
+        // other consumer claimed: retry
+        else {
+            pos = tail.load(std::memory_order_relaxed);
+        }
+    }
+
+    out = std::move(slot->data);
+    slot->sequence.store(pos + mask + 1, std::memory_order_release);
+    return true;
+}
+
+template<typename T> size_t RingQueue<T>::GetCapacity() const
+{
+    return mask + 1;
+}
+
+template<typename T> size_t RingQueue<T>::GetSize() const
+{
+    size_t enqueued = head.load(std::memory_order_relaxed);
+    size_t dequeued = tail.load(std::memory_order_relaxed);
+    return enqueued > dequeued ? enqueued - dequeued : 0;
+}
@@ -1,4 +1,20 @@
 #include "Timer.hpp"
+#include "cmath"
+
+#if !(_WIN32 || _WIN64)
+/**
+ * @brief CRT secure conversions by POSIX reentrant ones, same argument order
+ */
+static int localtime_s(OUT tm* out, IN const time_t* time)
+{
+    return localtime_r(time, out) ? 0 : errno;
+}
+
+static int gmtime_s(OUT tm* out, IN const time_t* time)
+{
+    return gmtime_r(time, out) ? 0 : errno;
+}
+#endif
 
 DEFINE_ENUM_TO_FLAG(Timer::ETimeStampDisplayFlag);
 
@@ -13,26 +29,23 @@ Timer::ETimeStampDisplayFlag Timer::typesDefault;
 const std::chrono::steady_clock::time_point Timer::beginPoint = std::chrono::steady_clock::now();
 
 Timer::Timer():
-    chronometerPoint(std::chrono::steady_clock::now()), lastUpdatePoint(std::chrono::steady_clock::now()),
-    lastDeltaTime(0), lastStopSec(0), order(orderDefault), types(typesDefault)
+    chronometerPoint(Clock::Now()), lastUpdatePoint(chronometerPoint), lastDeltaTime(0), lastStopSec(0), lastStopNS(0),
+    order(orderDefault), types(typesDefault)
 {}
 
 Timer::Timer(ETimeStampDateOrder order, ETimeStampDisplayFlag types):
-    chronometerPoint(std::chrono::steady_clock::now()), lastUpdatePoint(std::chrono::steady_clock::now()),
-    lastDeltaTime(0), lastStopSec(0), order(order), types(types)
+    chronometerPoint(Clock::Now()), lastUpdatePoint(chronometerPoint), lastDeltaTime(0), lastStopSec(0), lastStopNS(0),
+    order(order), types(types)
 {}
 
 void Timer::Reset()
 {
-    chronometerPoint = std::chrono::steady_clock::now();
+    chronometerPoint = Clock::Now();
 }
 
 float Timer::Stop()
 {
-    std::chrono::duration<float> temp =
-        std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - chronometerPoint);
-    lastStopSec = static_cast<float>(temp.count());
-    return lastStopSec;
+    return static_cast<float>(StopNS()) * 1e-9f;
 }
 
 float Timer::GetLastStop()
@@ -40,12 +53,23 @@ float Timer::GetLastStop()
     return lastStopSec;
 }
 
+uint64_t Timer::StopNS()
+{
+    lastStopNS  = Clock::Now() - chronometerPoint;
+    lastStopSec = static_cast<float>(lastStopNS) * 1e-9f;
+    return lastStopNS;
+}
+
+uint64_t Timer::GetLastStopNS() const
+{
+    return lastStopNS;
+}
+
 void Timer::UpdateDelta()
 {
-    std::chrono::high_resolution_clock::time_point curr;
+    uint64_t curr = Clock::Now();
 
-    curr            = std::chrono::high_resolution_clock::now();
-    lastDeltaTime   = curr - lastUpdatePoint;
+    lastDeltaTime   = std::chrono::nanoseconds(curr - lastUpdatePoint);
     lastUpdatePoint = curr;
 }
 
@@ -66,15 +90,39 @@ std::string Timer::StampingFromSec(double time)
     char buffer[DEF_BUF_SIZE];
 
     if(hour != 0) {
-        sprintf_s(buffer, "%02lld:%02d:%02d.%02d", hour, min, sec, ms);
+        snprintf(buffer, sizeof(buffer), "%02llu:%02u:%02u.%03u", static_cast<unsigned long long>(hour), min, sec, ms);
+    }
+
+    else if(min != 0) {
+        snprintf(buffer, sizeof(buffer), "%02d:%02d.%03d", min, sec, ms);
+    }
+
+    else {
+        snprintf(buffer, sizeof(buffer), "%02d.%03d", sec, ms);
+    }
+
+    return buffer;
+}
+
+std::string Timer::StampingFromNS(uint64_t ns)
+{
+    unsigned long long sec  = ns / 1000000000;
+    unsigned long long hour = sec / 3600;
+    unsigned           min  = static_cast<unsigned>((sec / 60) % 60);
+    unsigned           rest = static_cast<unsigned>(ns % 1000000000);
+
+    char buffer[DEF_BUF_SIZE];
+
+    if(hour != 0) {
+        snprintf(buffer, sizeof(buffer), "%02llu:%02u:%02u.%09u", hour, min, static_cast<unsigned>(sec % 60), rest);
     }
 
     else if(min != 0) {
-        sprintf_s(buffer, "%02d:%02d.%02d", min, sec, ms);
+        snprintf(buffer, sizeof(buffer), "%02u:%02u.%09u", min, static_cast<unsigned>(sec % 60), rest);
     }
 
     else {
-        sprintf_s(buffer, "%02d.%02d", sec, ms);
+        snprintf(buffer, sizeof(buffer), "%02u.%09u", static_cast<unsigned>(sec), rest);
     }
 
     return buffer;
@@ -92,9 +140,9 @@ std::string Timer::StampingFromSec24(double time, int* day)
     int    ms  = FractionalToMS(time);
     gmtime_s(&temp, &sec);
 
-    // "00:00:00'00", 12 byte
-    char buffer[12];
-    sprintf_s(buffer, "%02d:%02d:%02d.%02d", temp.tm_hour, temp.tm_min, temp.tm_sec, ms);
+    // "00:00:00.000", 13 byte
+    char buffer[16];
+    snprintf(buffer, sizeof(buffer), "%02d:%02d:%02d.%03d", temp.tm_hour, temp.tm_min, temp.tm_sec, ms);
     if(day) {
         *day = temp.tm_yday;
     }
@@ -114,9 +162,10 @@ std::string Timer::StampingWithStop()
 
 std::string Timer::StampingFromSystem(char delimiter) const
 {
-    tm   temp  = ReadSystemTime();
-    char empty = EmptyCharacter(types);
-    return ToStringDate(&temp, order, types, delimiter) + empty + ToStringTime(&temp, types);
+    uint32_t ns;
+    tm       temp  = ReadSystemTime(&ns);
+    char     empty = EmptyCharacter(types);
+    return ToStringDate(&temp, order, types, delimiter) + empty + ToStringTime(&temp, types, ns);
 }
 
 std::string Timer::StampingFromSystemDate(char delimiter) const
@@ -127,15 +176,24 @@ std::string Timer::StampingFromSystemDate(char delimiter) const
 
 std::string Timer::StampingFromSystemTime() const
 {
-    tm temp = ReadSystemTime();
-    return ToStringTime(&temp, types);
+    uint32_t ns;
+    tm       temp = ReadSystemTime(&ns);
+    return ToStringTime(&temp, types, ns);
+}
+
+std::string Timer::StampingFromTime(time_t sec, uint32_t ns) const
+{
+    tm temp;
+    localtime_s(&temp, &sec);
+    return ToStringTime(&temp, types, ns);
 }
 
 std::string Timer::StampingFromSystemDefault(char delimiter)
 {
-    tm   temp  = ReadSystemTime();
-    char empty = EmptyCharacter(typesDefault);
-    return ToStringDate(&temp, orderDefault, typesDefault, delimiter) + empty + ToStringTime(&temp, typesDefault);
+    uint32_t ns;
+    tm       temp  = ReadSystemTime(&ns);
+    char     empty = EmptyCharacter(typesDefault);
+    return ToStringDate(&temp, orderDefault, typesDefault, delimiter) + empty + ToStringTime(&temp, typesDefault, ns);
 }
 
 std::string Timer::StampingFromSystemDateDefault(char delimiter)
@@ -146,8 +204,9 @@ std::string Timer::StampingFromSystemDateDefault(char delimiter)
 
 std::string Timer::StampingFromSystemTimeDefault()
 {
-    tm temp = ReadSystemTime();
-    return ToStringTime(&temp, typesDefault);
+    uint32_t ns;
+    tm       temp = ReadSystemTime(&ns);
+    return ToStringTime(&temp, typesDefault, ns);
 }
 
 float Timer::GetDeltaTimeMS() const
@@ -165,6 +224,11 @@ float Timer::GetDeltaTimeNS() const
     return static_cast<float>(lastDeltaTime.count());
 }
 
+uint64_t Timer::GetDeltaNS() const
+{
+    return static_cast<uint64_t>(lastDeltaTime.count());
+}
+
 void Timer::SetTimeStampDateOrder(ETimeStampDateOrder param)
 {
     order = param;
@@ -267,9 +331,198 @@ tm Timer::ReadSystemTime()
     return temp;
 }
 
+tm Timer::ReadSystemTime(uint32_t* ns)
+{
+    tm     temp;
+    time_t curr = ReadSystemClock(ns);
+
+    localtime_s(&temp, &curr);
+
+    return temp;
+}
+
+Timer::StampCache::StampCache(const Timer& timer):
+    owner(&timer), last(-1), current{}, subsecond(0), order(timer.order), types(timer.types), time{ 0 }, timeW{ 0 },
+    timeLength(0), date{ 0 }, dateW{ 0 }, dateLength(0)
+{
+    Update();
+}
+
+void Timer::StampCache::Update()
+{
+    time_t curr = ReadSystemClock(&subsecond);
+
+    // options changed: rebuild all
+    if(order != owner->order || types != owner->types) {
+        order = owner->order;
+        types = owner->types;
+        last  = -1;
+    }
+
+    if(curr == last) {
+        Fraction();
+        return;
+    }
+
+    time_t delta = curr - last;
+    bool   isInit = last != -1;
+    last          = curr;
+
+    // same hour, step forward: patch digits
+    if(isInit && delta > 0 && delta < 3600) {
+        int sec = current.tm_sec + static_cast<int>(delta);
+        int min = current.tm_min + sec / 60;
+
+        if(min < 60) {
+            bool isMinChanged = min != current.tm_min;
+
+            current.tm_sec = sec % 60;
+            current.tm_min = min;
+
+            // variable width
+            if(types & ETimeStampDisplayFlag::HIDE_ZERO) {
+                RebuildTime();
+                return;
+            }
+
+            // "hh:mm:ss"
+            if(isMinChanged) {
+                Digits(3, current.tm_min);
+            }
+            if(!(types & ETimeStampDisplayFlag::HIDE_SECONDS)) {
+                Digits(6, current.tm_sec);
+            }
+            Fraction();
+            return;
+        }
+    }
+
+    // hour changed, clock adjusted or first call: read calendar (also DST)
+    int day = current.tm_mday;
+    localtime_s(&current, &curr);
+
+    if(day != current.tm_mday || dateLength == 0) {
+        RebuildDate();
+    }
+    RebuildTime();
+}
+
+const char* Timer::StampCache::GetTime() const
+{
+    return time;
+}
+
+const wchar_t* Timer::StampCache::GetTimeW() const
+{
+    return timeW;
+}
+
+size_t Timer::StampCache::GetTimeLength() const
+{
+    return timeLength;
+}
+
+const char* Timer::StampCache::GetDate() const
+{
+    return date;
+}
+
+const wchar_t* Timer::StampCache::GetDateW() const
+{
+    return dateW;
+}
+
+size_t Timer::StampCache::GetDateLength() const
+{
+    return dateLength;
+}
+
+void Timer::StampCache::RebuildDate()
+{
+    std::string temp = ToStringDate(&current, order, types, DATE_DELIMITER);
+
+    dateLength = MIN(temp.size(), SIZE - 1);
+    for(size_t i = 0; i < dateLength; ++i) {
+        date[i]  = temp[i];
+        dateW[i] = static_cast<wchar_t>(temp[i]);
+    }
+    date[dateLength]  = 0;
+    dateW[dateLength] = 0;
+}
+
+void Timer::StampCache::RebuildTime()
+{
+    std::string temp = ToStringTime(&current, types, subsecond);
+
+    timeLength = MIN(temp.size(), SIZE - 1);
+    for(size_t i = 0; i < timeLength; ++i) {
+        time[i]  = temp[i];
+        timeW[i] = static_cast<wchar_t>(temp[i]);
+    }
+    time[timeLength]  = 0;
+    timeW[timeLength] = 0;
+}
+
+void Timer::StampCache::Digits(size_t pos, int value)
+{
+    time[pos]      = static_cast<char>('0' + value / 10);
+    time[pos + 1]  = static_cast<char>('0' + value % 10);
+    timeW[pos]     = static_cast<wchar_t>(time[pos]);
+    timeW[pos + 1] = static_cast<wchar_t>(time[pos + 1]);
+}
+
+void Timer::StampCache::Fraction()
+{
+    int digits = FractionDigits(types);
+    if(digits == 0 || (types & ETimeStampDisplayFlag::HIDE_SECONDS)) {
+        return;
+    }
+
+    // variable width
+    if(types & ETimeStampDisplayFlag::HIDE_ZERO) {
+        RebuildTime();
+        return;
+    }
+
+    // "hh:mm:ss.fff"
+    uint32_t value = subsecond;
+    for(int i = digits; i < 9; ++i) {
+        value /= 10;
+    }
+    for(int i = 9 + digits - 1; i >= 9; --i) {
+        time[i]  = static_cast<char>('0' + value % 10);
+        timeW[i] = static_cast<wchar_t>(time[i]);
+        value /= 10;
+    }
+}
+
 int Timer::FractionalToMS(IN double time)
 {
-    return static_cast<int>((time - floor(time)) * 100);
+    return static_cast<int>((time - floor(time)) * 1000);
+}
+
+time_t Timer::ReadSystemClock(uint32_t* ns)
+{
+    std::chrono::system_clock::time_point curr = std::chrono::system_clock::now();
+    std::chrono::nanoseconds              temp = curr.time_since_epoch();
+    std::chrono::seconds                  sec  = std::chrono::duration_cast<std::chrono::seconds>(temp);
+
+    *ns = static_cast<uint32_t>((temp - sec).count());
+    return std::chrono::system_clock::to_time_t(curr);
+}
+
+int Timer::FractionDigits(ETimeStampDisplayFlag types)
+{
+    if(types & ETimeStampDisplayFlag::SHOW_NANOSECONDS) {
+        return 9;
+    }
+    if(types & ETimeStampDisplayFlag::SHOW_MICROSECONDS) {
+        return 6;
+    }
+    if(types & ETimeStampDisplayFlag::SHOW_MILLISECONDS) {
+        return 3;
+    }
+    return 0;
 }
 
 char Timer::EmptyCharacter(ETimeStampDisplayFlag types)
@@ -282,43 +535,43 @@ char Timer::EmptyCharacter(ETimeStampDisplayFlag types)
 
 std::string Timer::ToStringDate(tm* param, ETimeStampDateOrder order, ETimeStampDisplayFlag types, char dateDelim)
 {
-    // "1900_MON_00" <= 12byte
-    char buffer[12] = { 0 };
+    // "1900_MON_00" <= 12byte, sized for any int: no truncation warning of snprintf
+    char buffer[40] = { 0 };
 
-    char day[3] = { 0 };
-    char mon[4] = { 0 };
+    char day[12] = { 0 };
+    char mon[12] = { 0 };
 
     if(types & ETimeStampDisplayFlag::USE_MONTH_AS_STRING) {
-        sprintf_s(mon, "%s", MONS[param->tm_mon]);
+        snprintf(mon, sizeof(mon), "%s", MONS[param->tm_mon]);
     }
 
     else {
         int nMon = param->tm_mon + 1;
         if(types & ETimeStampDisplayFlag::HIDE_ZERO) {
-            sprintf_s(mon, "%d", nMon);
+            snprintf(mon, sizeof(mon), "%d", nMon);
         }
         else {
-            sprintf_s(mon, "%02d", nMon);
+            snprintf(mon, sizeof(mon), "%02d", nMon);
         }
     }
 
     if(types & ETimeStampDisplayFlag::HIDE_ZERO) {
-        sprintf_s(day, "%d", param->tm_mday);
+        snprintf(day, sizeof(day), "%d", param->tm_mday);
     }
     else {
-        sprintf_s(day, "%02d", param->tm_mday);
+        snprintf(day, sizeof(day), "%02d", param->tm_mday);
     }
 
     if(types & HIDE_YEAR) {
         switch(order) {
             case ETimeStampDateOrder::YYYY_MM_DD:
-                sprintf_s(buffer, "%s%c%s", mon, dateDelim, day);
+                snprintf(buffer, sizeof(buffer), "%s%c%s", mon, dateDelim, day);
                 break;
             case ETimeStampDateOrder::MM_DD_YYYY:
-                sprintf_s(buffer, "%s%c%s", mon, dateDelim, day);
+                snprintf(buffer, sizeof(buffer), "%s%c%s", mon, dateDelim, day);
                 break;
             case ETimeStampDateOrder::DD_MM_YYYY:
-                sprintf_s(buffer, "%s%c%s", day, dateDelim, mon);
+                snprintf(buffer, sizeof(buffer), "%s%c%s", day, dateDelim, mon);
                 break;
         }
     }
@@ -326,13 +579,13 @@ std::string Timer::ToStringDate(tm* param, ETimeStampDateOrder order, ETimeStamp
         int year = param->tm_year + 1900;
         switch(order) {
             case ETimeStampDateOrder::YYYY_MM_DD:
-                sprintf_s(buffer, "%d%c%s%c%s", year, dateDelim, mon, dateDelim, day);
+                snprintf(buffer, sizeof(buffer), "%d%c%s%c%s", year, dateDelim, mon, dateDelim, day);
                 break;
             case ETimeStampDateOrder::MM_DD_YYYY:
-                sprintf_s(buffer, "%s%c%s%c%d", mon, dateDelim, day, dateDelim, year);
+                snprintf(buffer, sizeof(buffer), "%s%c%s%c%d", mon, dateDelim, day, dateDelim, year);
                 break;
             case ETimeStampDateOrder::DD_MM_YYYY:
-                sprintf_s(buffer, "%s%c%s%c%d", day, dateDelim, mon, dateDelim, year);
+                snprintf(buffer, sizeof(buffer), "%s%c%s%c%d", day, dateDelim, mon, dateDelim, year);
                 break;
         }
     }
@@ -346,10 +599,10 @@ std::string Timer::ToStringDate(tm* param, ETimeStampDateOrder order, ETimeStamp
     return result + DAYS[param->tm_wday];
 }
 
-std::string Timer::ToStringTime(tm* param, ETimeStampDisplayFlag types)
+std::string Timer::ToStringTime(tm* param, ETimeStampDisplayFlag types, uint32_t ns)
 {
-    // "00:00:00 AM" <= 12
-    char buffer[12] = { 0 };
+    // "00:00:00.000000000 AM" <= 22
+    char buffer[24] = { 0 };
 
     int         hour = param->tm_hour;
     const char* noon = "AM";
@@ -381,10 +634,10 @@ std::string Timer::ToStringTime(tm* param, ETimeStampDisplayFlag types)
 
         if(types & ETimeStampDisplayFlag::USE_12HOUR_CLOCK) {
             char empty = EmptyCharacter(types);
-            sprintf_s(buffer, (format + "%c%s").c_str(), hour, param->tm_min, empty, noon);
+            snprintf(buffer, sizeof(buffer), (format + "%c%s").c_str(), hour, param->tm_min, empty, noon);
         }
         else {
-            sprintf_s(buffer, format.c_str(), hour, param->tm_min);
+            snprintf(buffer, sizeof(buffer), format.c_str(), hour, param->tm_min);
         }
     }
     else {
@@ -395,12 +648,23 @@ std::string Timer::ToStringTime(tm* param, ETimeStampDisplayFlag types)
             format = "%02d:%02d:%02d";
         }
 
+        // sub-second: append digits (always zero filled)
+        int digits = FractionDigits(types);
+        if(digits) {
+            for(int i = digits; i < 9; ++i) {
+                ns /= 10;
+            }
+            char fraction[12];
+            snprintf(fraction, sizeof(fraction), ".%0*u", digits, ns);
+            format += fraction;
+        }
+
         if(types & ETimeStampDisplayFlag::USE_12HOUR_CLOCK) {
             char empty = EmptyCharacter(types);
-            sprintf_s(buffer, (format + "%c%s").c_str(), hour, param->tm_min, param->tm_sec, empty, noon);
+            snprintf(buffer, sizeof(buffer), (format + "%c%s").c_str(), hour, param->tm_min, param->tm_sec, empty, noon);
         }
         else {
-            sprintf_s(buffer, format.c_str(), hour, param->tm_min, param->tm_sec);
+            snprintf(buffer, sizeof(buffer), format.c_str(), hour, param->tm_min, param->tm_sec);
         }
     }
 
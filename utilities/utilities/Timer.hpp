@@ -13,6 +13,7 @@
 #define LWE__TIMER_HPP__
 
 #include "chrono"
+#include "Clock.hpp"
 #include "../../include/include/includes.hpp"
 
 /**
@@ -44,6 +45,9 @@ public:
         USE_EMPTY           = (1 << 4),
         HIDE_YEAR           = (1 << 5),
         HIDE_SECONDS        = (1 << 6),
+        SHOW_MILLISECONDS   = (1 << 7), // 23:59:59.999
+        SHOW_MICROSECONDS   = (1 << 8), // 23:59:59.999999
+        SHOW_NANOSECONDS    = (1 << 9), // 23:59:59.999999999
     };
 
 
@@ -91,6 +95,14 @@ public:
     float Stop();
     float GetLastStop();
 
+    /**
+     * @brief chronometer stop with integer resolution
+     *
+     * @return uint64_t (get current ns)
+     */
+    uint64_t StopNS();
+    uint64_t GetLastStopNS() const;
+
 public:
     /**
      * @brief calculate delta time
@@ -102,14 +114,14 @@ public:
     /**
      *  @brief get timestamp from duration (of last Stop() call)
      *
-     *  @return std::string (e.g. "999:59:59.99")
+     *  @return std::string (e.g. "999:59:59.999")
      */
     std::string Stamping() const;
 
     /**
      *  @brief get timestamp from duration (pre Stop() call)
      *
-     *  @return std::string (e.g. "999:59:59.99")
+     *  @return std::string (e.g. "999:59:59.999")
      */
     std::string StampingWithStop();
 
@@ -137,6 +149,15 @@ public:
      */
     std::string StampingFromSystemTime() const;
 
+    /**
+     *  @brief get timestamp from calendar time (time only)
+     *
+     *  @param sec [in] seconds since epoch
+     *  @param ns  [in] fractional part of second, shown by SHOW_MILLISECONDS ~ SHOW_NANOSECONDS
+     *  @return std::string (e.g. "23:59:59.999")
+     */
+    std::string StampingFromTime(IN time_t sec, IN uint32_t ns = 0) const;
+
 public:
     /**
      * @brief STATIC: get timestamp from system time
@@ -166,21 +187,29 @@ public:
      * @brief STATIC: get timestamp from seconds
      *
      * @param time [in] seconds, decimal part is sec, fractional part is ms
-     * @return std::string (e.g. "999:59:59.99")
+     * @return std::string (e.g. "999:59:59.999")
      *
      * @warning HIDE_SECONDS option not working
      */
     static std::string StampingFromSec(IN double time);
 
+    /**
+     * @brief STATIC: get timestamp from nanoseconds, full resolution
+     *
+     * @param ns [in] duration (e.g. Clock::Now() difference)
+     * @return std::string (e.g. "999:59:59.999999999")
+     */
+    static std::string StampingFromNS(IN uint64_t ns);
+
     /**
      * @brief get timestamp from seconds
      *
      * @param time [in] seconds for calculation
      * @param day  [out] date from the overflowed time [optional]
-     * @return std::string (e.g. "23:59:59.99")
+     * @return std::string (e.g. "23:59:59.999")
      *
      * @warning HIDE_SECONDS option not working
-     * @warning float max "23:59:58.00" based on day 0
+     * @warning float max "23:59:58.000" based on day 0
      */
     static std::string StampingFromSec24(IN double time, OUT OPT int* day = nullptr);
 
@@ -190,6 +219,13 @@ public:
     float GetDeltaTimeUS() const;
     float GetDeltaTimeNS() const;
 
+    /**
+     * @brief get last delta time with integer resolution
+     *
+     * @return uint64_t ns
+     */
+    uint64_t GetDeltaNS() const;
+
 public:
     prop(get = GetDeltaTimeMS) float DeltaMS;
     prop(get = GetDeltaTimeUS) float DeltaUS;
@@ -304,6 +340,106 @@ public:
      */
     static tm ReadSystemTime();
 
+    /**
+     * @brief read system time with sub-second
+     *
+     * @param ns [out] fractional part of second (0 ~ 999999999)
+     * @return tm (current system time)
+     */
+    static tm ReadSystemTime(OUT uint32_t* ns);
+
+public:
+    /**
+     * @brief   system timestamp cache, reformats only changed characters
+     * @note    date part is rebuilt when the day rolls, time part when the hour changes
+     * @warning not thread safe, use one per thread (or under lock)
+     */
+    class StampCache
+    {
+    public:
+        /**
+         * @brief Construct a new StampCache object
+         *
+         * @param Timer [in] follows order / types of the timer
+         */
+        StampCache(IN const Timer&);
+
+    public:
+        /**
+         * @brief read system time and refresh buffers
+         */
+        void Update();
+
+    public:
+        /**
+         * @brief get time part (e.g. "23:59:59")
+         */
+        const char*    GetTime() const;
+        const wchar_t* GetTimeW() const;
+        size_t         GetTimeLength() const;
+
+        /**
+         * @brief get date part (e.g. "1900-01-01")
+         */
+        const char*    GetDate() const;
+        const wchar_t* GetDateW() const;
+        size_t         GetDateLength() const;
+
+    private:
+        /**
+         * @brief reformat date part
+         */
+        void RebuildDate();
+
+        /**
+         * @brief reformat time part
+         */
+        void RebuildTime();
+
+        /**
+         * @brief overwrite 2 digits (narrow and wide)
+         *
+         * @param pos   [in] position in time part
+         * @param value [in] 0 ~ 99
+         */
+        void Digits(IN size_t pos, IN int value);
+
+        /**
+         * @brief overwrite sub-second digits, or rebuild when variable width
+         */
+        void Fraction();
+
+    private:
+        /**
+         * @brief READONLY: max length with null
+         */
+        static const size_t SIZE = 32;
+
+    private:
+        const Timer* owner;
+        time_t       last;
+        tm           current;
+        uint32_t     subsecond;
+
+    private:
+        /**
+         * @brief options of the last rebuild
+         */
+        ETimeStampDateOrder   order;
+        ETimeStampDisplayFlag types;
+
+    private:
+        /**
+         * @brief buffers
+         */
+        char    time[SIZE];
+        wchar_t timeW[SIZE];
+        size_t  timeLength;
+        char    date[SIZE];
+        wchar_t dateW[SIZE];
+        size_t  dateLength;
+    };
+
 private:
     /**
      * @brief get fractional part only
@@ -313,6 +449,22 @@ private:
      */
     static int FractionalToMS(IN double sec);
 
+    /**
+     * @brief read system clock
+     *
+     * @param ns [out] fractional part of second
+     * @return time_t
+     */
+    static time_t ReadSystemClock(OUT uint32_t* ns);
+
+    /**
+     * @brief get sub-second digit count from flag
+     *
+     * @param ETimeStampDisplayFlag [in] SHOW_MILLISECONDS / SHOW_MICROSECONDS / SHOW_NANOSECONDS
+     * @return int (0, 3, 6, 9)
+     */
+    static int FractionDigits(IN ETimeStampDisplayFlag);
+
 private:
     /**
      * @brief
@@ -339,9 +491,10 @@ private:
      *
      * @param tm                    [in] time info
      * @param ETimeStampDisplayFlag [in] options flag
+     * @param ns                    [in] sub-second, used with SHOW_MILLISECONDS / MICRO / NANO
      * @return std::string (e.g. "23:59:59")
      */
-    static std::string ToStringTime(IN tm*, IN ETimeStampDisplayFlag);
+    static std::string ToStringTime(IN tm*, IN ETimeStampDisplayFlag, IN uint32_t ns = 0);
 
 private:
     /**
@@ -350,14 +503,14 @@ private:
     static const std::chrono::steady_clock::time_point beginPoint;
 
     /**
-     * @brief last chronometer stop time point
+     * @brief last chronometer reset time point (Clock::Now(), ns)
      */
-    std::chrono::steady_clock::time_point chronometerPoint;
+    uint64_t chronometerPoint;
 
     /**
-     * @brief last updated delta time point
+     * @brief last updated delta time point (Clock::Now(), ns)
      */
-    std::chrono::high_resolution_clock::time_point lastUpdatePoint;
+    uint64_t lastUpdatePoint;
 
     /**
      * @brief last caluclated delta time (ns)
@@ -369,6 +522,11 @@ private:
      */
     float lastStopSec;
 
+    /**
+     * @brief saved at the last Stop() call (ns)
+     */
+    uint64_t lastStopNS;
+
 private:
     /**
      * @brief year, month, day order
@@ -0,0 +1,393 @@
+#include "TimerWheel.hpp"
+#include "bit"
+#include "climits"
+#include "stdexcept"
+#include "algorithm"
+
+const TimerWheel::Handle       TimerWheel::INVALID     = 0;
+const std::chrono::nanoseconds TimerWheel::DEF_TICK    = std::chrono::milliseconds(1);
+const size_t                   TimerWheel::DEF_RESERVE = 1 << 10;
+
+TimerWheel::TimerWheel(std::chrono::nanoseconds tick, size_t reserve):
+    freeHead(NIL), count(0), heads{}, occupied{}, base(Clock::Now()),
+    tickNS(tick.count() > 0 ? static_cast<uint64_t>(tick.count()) : 1), current(0)
+{
+    for(uint32_t i = 0; i < LEVELS; ++i) {
+        for(uint32_t j = 0; j < SLOTS; ++j) {
+            heads[i][j] = NIL;
+        }
+    }
+
+    nodes.reserve(reserve);
+}
+
+TimerWheel::~TimerWheel() {}
+
+TimerWheel::Handle TimerWheel::Add(std::chrono::nanoseconds delay,
+                                   Callback                 callback,
+                                   void*                    context,
+                                   std::chrono::nanoseconds period)
+{
+    uint64_t now      = Clock::Now();
+    uint64_t delayNS  = delay.count() > 0 ? static_cast<uint64_t>(delay.count()) : 0;
+    uint64_t periodNS = period.count() > 0 ? static_cast<uint64_t>(period.count()) : 0;
+
+    // round up: never earlier than requested
+    uint64_t expire = (now - base + delayNS + tickNS - 1) / tickNS;
+    uint64_t repeat = periodNS ? MAX((periodNS + tickNS - 1) / tickNS, 1) : 0;
+
+    LockGuard::Scoped guard(lock);
+
+    uint32_t index = Allocate();
+    Node&    node  = nodes[index];
+
+    node.expire   = MAX(expire, current + 1); // current slot is already processed
+    node.period   = repeat;
+    node.callback = callback;
+    node.context  = context;
+
+    Insert(index);
+    ++count;
+
+    return (static_cast<Handle>(node.generation) << 32) | index;
+}
+
+bool TimerWheel::Cancel(Handle handle, bool isWait)
+{
+    uint32_t index      = static_cast<uint32_t>(handle);
+    uint32_t generation = static_cast<uint32_t>(handle >> 32);
+    bool     result     = false;
+
+    if(handle == INVALID) {
+        return false;
+    }
+
+    LockGuard::Scoped guard(lock);
+
+    if(index < nodes.size() && nodes[index].generation == generation && nodes[index].slot != NIL) {
+        Remove(index);
+        Free(index);
+        result = true;
+    }
+
+    // collected, not called yet
+    for(Batch* batch : batches) {
+        for(size_t i = batch->next; i < batch->expired.size(); ++i) {
+            if(batch->expired[i].handle == handle && batch->expired[i].callback) {
+                batch->expired[i].callback = nullptr;
+                result                     = true;
+            }
+        }
+    }
+
+    if(isWait) {
+        std::thread::id self = std::this_thread::get_id();
+
+        // called on this thread (e.g. Cancel() in the callback): returns after this call
+        while(std::any_of(batches.begin(), batches.end(), [handle, self](const Batch* batch) {
+            return batch->calling == handle && batch->thread != self;
+        })) {
+            guard.Unlock();
+            std::this_thread::yield();
+            guard.Lock();
+        }
+    }
+    return result;
+}
+
+size_t TimerWheel::Advance()
+{
+    return Advance(Clock::Now());
+}
+
+size_t TimerWheel::Advance(uint64_t now)
+{
+    if(now < base) {
+        return 0;
+    }
+
+    uint64_t target = (now - base) / tickNS;
+    Batch    batch;
+
+    {
+        LockGuard::Scoped guard(lock);
+
+        batch.expired.swap(spare);
+
+        while(current < target) {
+            if(count == 0) {
+                current = target;
+                break;
+            }
+
+            // skip empty slots until the next occupied slot or cascade point
+            uint64_t next  = current + 1;
+            uint32_t index = static_cast<uint32_t>(next & MASK);
+            if(index != 0) {
+                next += MIN(Find(0, index), SLOTS - index);
+                if(next > target) {
+                    current = target;
+                    break;
+                }
+            }
+            current = next;
+
+            // cascade from upper level: lower level may receive it in same tick
+            for(uint32_t level = LEVELS - 1; level > 0; --level) {
+                uint32_t shift = BITS * level;
+                if((current & ((uint64_t(1) << shift) - 1)) == 0) {
+                    Cascade(level, static_cast<uint32_t>((current >> shift) & MASK));
+                }
+            }
+            Expire(batch.expired);
+        }
+
+        if(batch.expired.empty()) {
+            spare.swap(batch.expired);
+            return 0;
+        }
+
+        // visible to Cancel()
+        batch.next    = 0;
+        batch.calling = INVALID;
+        batch.thread  = std::this_thread::get_id();
+        batches.push_back(&batch);
+    }
+
+    // call without lock, one at a time: Cancel() skips the rest or waits for the running one
+    size_t called = 0;
+    while(true) {
+        Expired expired;
+        {
+            LockGuard::Scoped guard(lock);
+
+            batch.calling = INVALID;
+            if(batch.next == batch.expired.size()) {
+                batches.erase(std::find(batches.begin(), batches.end(), &batch));
+
+                // return buffer for reuse
+                batch.expired.clear();
+                if(spare.capacity() < batch.expired.capacity()) {
+                    spare.swap(batch.expired);
+                }
+                break;
+            }
+
+            expired       = batch.expired[batch.next++];
+            batch.calling = expired.handle;
+        }
+
+        if(expired.callback) {
+            expired.callback(expired.context);
+            ++called;
+        }
+    }
+
+    return called;
+}
+
+int TimerWheel::NextTimeout() const
+{
+    uint64_t ticks = UINT64_MAX;
+    uint64_t deadline;
+
+    {
+        LockGuard::Scoped guard(lock);
+
+        if(count == 0) {
+            return -1;
+        }
+
+        // level 0: exact expiry tick
+        uint32_t distance = Find(0, static_cast<uint32_t>((current + 1) & MASK));
+        if(distance != SLOTS) {
+            ticks = distance + 1;
+        }
+
+        // upper level: cascade tick
+        for(uint32_t level = 1; level < LEVELS; ++level) {
+            uint32_t shift = BITS * level;
+            uint64_t upper = current >> shift;
+
+            distance = Find(level, static_cast<uint32_t>((upper + 1) & MASK));
+            if(distance != SLOTS) {
+                ticks = MIN(ticks, ((upper + distance + 1) << shift) - current);
+            }
+        }
+
+        deadline = base + (current + ticks) * tickNS;
+    }
+
+    uint64_t now = Clock::Now();
+    if(deadline <= now) {
+        return 0;
+    }
+
+    uint64_t ms = (deadline - now + 999999) / 1000000;
+    return ms > INT_MAX ? INT_MAX : static_cast<int>(ms);
+}
+
+size_t TimerWheel::GetSize() const
+{
+    LockGuard::Scoped guard(lock);
+    return count;
+}
+
+std::chrono::nanoseconds TimerWheel::GetTick() const
+{
+    return std::chrono::nanoseconds(tickNS);
+}
+
+void TimerWheel::Insert(uint32_t index)
+{
+    Node&    node  = nodes[index];
+    uint64_t delta = node.expire - current;
+    uint32_t level = 0;
+    uint32_t slot;
+
+    while(level < LEVELS - 1 && delta >= (uint64_t(1) << (BITS * (level + 1)))) {
+        ++level;
+    }
+
+    // out of range: park on the last slot, recalculated when cascaded
+    if(level == LEVELS - 1 && delta >= (uint64_t(1) << (BITS * LEVELS))) {
+        slot = static_cast<uint32_t>(((current >> (BITS * level)) + MASK) & MASK);
+    }
+    else {
+        slot = static_cast<uint32_t>((node.expire >> (BITS * level)) & MASK);
+    }
+
+    uint32_t& head = heads[level][slot];
+
+    node.prev = NIL;
+    node.next = head;
+    node.slot = level * SLOTS + slot;
+    if(head != NIL) {
+        nodes[head].prev = index;
+    }
+    head = index;
+
+    occupied[level][slot >> 6] |= uint64_t(1) << (slot & 63);
+}
+
+void TimerWheel::Remove(uint32_t index)
+{
+    Node&    node  = nodes[index];
+    uint32_t level = node.slot / SLOTS;
+    uint32_t slot  = node.slot % SLOTS;
+
+    if(node.prev != NIL) {
+        nodes[node.prev].next = node.next;
+    }
+    else {
+        heads[level][slot] = node.next;
+    }
+
+    if(node.next != NIL) {
+        nodes[node.next].prev = node.prev;
+    }
+
+    if(heads[level][slot] == NIL) {
+        occupied[level][slot >> 6] &= ~(uint64_t(1) << (slot & 63));
+    }
+}
+
+uint32_t TimerWheel::Allocate()
+{
+    if(freeHead == NIL) {
+        size_t size = nodes.size();
+        size_t grow = MAX(size, nodes.capacity());
+        grow        = MAX(grow, static_cast<size_t>(64));
+        if(size + grow >= NIL) {
+            throw std::runtime_error("timer wheel overflow");
+        }
+
+        nodes.resize(size + grow);
+        for(size_t i = size + grow; i > size; --i) {
+            Node& node      = nodes[i - 1];
+            node.slot       = NIL;
+            node.generation = 1;
+            node.next       = freeHead;
+            freeHead        = static_cast<uint32_t>(i - 1);
+        }
+    }
+
+    uint32_t index = freeHead;
+    freeHead       = nodes[index].next;
+    return index;
+}
+
+void TimerWheel::Free(uint32_t index)
+{
+    Node& node = nodes[index];
+
+    // invalidate handle, skip 0
+    if(++node.generation == 0) {
+        node.generation = 1;
+    }
+    node.slot = NIL;
+    node.next = freeHead;
+    freeHead  = index;
+
+    --count;
+}
+
+void TimerWheel::Cascade(uint32_t level, uint32_t slot)
+{
+    uint32_t index = heads[level][slot];
+
+    heads[level][slot] = NIL;
+    occupied[level][slot >> 6] &= ~(uint64_t(1) << (slot & 63));
+
+    while(index != NIL) {
+        uint32_t next = nodes[index].next;
+        Insert(index);
+        index = next;
+    }
+}
+
+void TimerWheel::Expire(std::vector<Expired>& out)
+{
+    uint32_t slot  = static_cast<uint32_t>(current & MASK);
+    uint32_t index = heads[0][slot];
+
+    heads[0][slot] = NIL;
+    occupied[0][slot >> 6] &= ~(uint64_t(1) << (slot & 63));
+
+    while(index != NIL) {
+        Node&    node = nodes[index];
+        uint32_t next = node.next;
+
+        out.push_back({ node.callback, node.context, (static_cast<Handle>(node.generation) << 32) | index });
+
+        // periodic: keep handle
+        if(node.period) {
+            node.expire = MAX(node.expire + node.period, current + 1);
+            Insert(index);
+        }
+        else {
+            Free(index);
+        }
+
+        index = next;
+    }
+}
+
+uint32_t TimerWheel::Find(uint32_t level, uint32_t from) const
+{
+    const uint32_t WORDS = SLOTS / 64;
+
+    uint32_t word = from >> 6;
+    uint64_t bits = occupied[level][word] & (~uint64_t(0) << (from & 63));
+
+    // wraps once, then rechecks lower bits of the first word
+    for(uint32_t i = 0; i <= WORDS; ++i) {
+        if(bits) {
+            uint32_t found = (word << 6) + static_cast<uint32_t>(std::countr_zero(bits));
+            return (found - from) & MASK;
+        }
+        word = (word + 1) & (WORDS - 1);
+        bits = occupied[level][word];
+    }
+    return SLOTS;
+}
@@ -0,0 +1,256 @@
+/**
+ * @file    TimerWheel.hpp
+ * @author  LaverWinEmpty@google.com
+ * @brief   hierarchical timer wheel
+ * @version 0.0.1
+ * @date    2026-10-17
+ *
+ * @copyright Copyright (c) 2023
+ *
+ */
+
+#ifndef LWE__TIMERWHEEL_HPP__
+#define LWE__TIMERWHEEL_HPP__
+
+#include "vector"
+#include "chrono"
+#include "thread"
+#include "Clock.hpp"
+#include "LockGuard.hpp"
+#include "../../include/include/includes.hpp"
+
+/**
+ * @brief hierarchical timer wheel for timeouts and periodic tasks (e.g. idle, retransmit, keepalive)
+ * @note  4 levels x 256 slots: 2^32 ticks range, farther timers are parked on the last level
+ *        Add() / Cancel(): O(1), any thread
+ *        Advance(): expired callbacks are collected under the lock and called outside of it
+ *        Cancel(handle, true): also waits for the callback running on another thread (e.g. before freeing the context)
+ *        NextTimeout(): wait timeout for event loop (e.g. epoll_wait(..., wheel.NextTimeout()))
+ */
+class TimerWheel
+{
+public:
+    /**
+     * @brief callback, called by the thread that calls Advance()
+     */
+    using Callback = void (*)(void* context);
+
+    /**
+     * @brief timer id for Cancel(), 0: invalid
+     */
+    using Handle = uint64_t;
+
+public:
+    /**
+     * @brief READONLY: invalid handle
+     */
+    static const Handle INVALID;
+
+    /**
+     * @brief READONLY: default tick
+     */
+    static const std::chrono::nanoseconds DEF_TICK;
+
+    /**
+     * @brief READONLY: default reserved timer count
+     */
+    static const size_t DEF_RESERVE;
+
+public:
+    /**
+     * @brief Construct a new TimerWheel object
+     *
+     * @param tick    [in] granularity, expiry is rounded up to it
+     * @param reserve [in] timer count to allocate first
+     */
+    TimerWheel(IN std::chrono::nanoseconds tick = DEF_TICK, IN size_t reserve = DEF_RESERVE);
+
+    /**
+     * @brief Destroy the TimerWheel object, remaining timers are discarded without call
+     */
+    ~TimerWheel();
+
+public:
+    DECLARE_NO_COPY(TimerWheel);
+
+public:
+    /**
+     * @brief add timer
+     *
+     * @param delay    [in] time until first call
+     * @param callback [in] function
+     * @param context  [in] argument of the callback
+     * @param period   [opt] repeat interval, 0: once
+     * @return Handle
+     */
+    Handle Add(IN std::chrono::nanoseconds delay,
+               IN Callback                 callback,
+               IN void*                    context,
+               OPT std::chrono::nanoseconds period = std::chrono::nanoseconds(0));
+
+    /**
+     * @brief remove timer, collected callbacks of running Advance() calls are not called any more
+     * @warning without isWait, a callback already running on another thread may not have returned yet
+     *
+     * @param handle [in] from Add()
+     * @param isWait [opt] true: wait for the running callback of another thread, the context can be freed after
+     * @return true: removed / false: expired (once), already canceled or invalid
+     */
+    bool Cancel(IN Handle handle, OPT bool isWait = false);
+
+    /**
+     * @brief process ticks until now and call expired callbacks
+     * @note  callbacks can Add() / Cancel()
+     *
+     * @return size_t called count
+     */
+    size_t Advance();
+
+    /**
+     * @brief process ticks until the given time and call expired callbacks
+     *
+     * @param now [in] Clock::Now() nanoseconds
+     * @return size_t called count
+     */
+    size_t Advance(IN uint64_t now);
+
+public:
+    /**
+     * @brief get wait time until the next Advance() is needed
+     * @note  never later than the nearest expiry, may be earlier (far timers cascade first)
+     *
+     * @return int milliseconds (-1: no timer, infinite wait)
+     */
+    int NextTimeout() const;
+
+    /**
+     * @brief get pending timer count
+     *
+     * @return size_t
+     */
+    size_t GetSize() const;
+
+    /**
+     * @brief get tick
+     *
+     * @return std::chrono::nanoseconds
+     */
+    std::chrono::nanoseconds GetTick() const;
+
+private:
+    /**
+     * @brief link to slot
+     *
+     * @param index [in] node index
+     */
+    void Insert(IN uint32_t index);
+
+    /**
+     * @brief unlink from slot
+     *
+     * @param index [in] node index
+     */
+    void Remove(IN uint32_t index);
+
+    /**
+     * @brief get node from free list, grow pool if empty
+     *
+     * @return uint32_t node index
+     */
+    uint32_t Allocate();
+
+    /**
+     * @brief return node to free list, invalidate handle
+     *
+     * @param index [in] node index
+     */
+    void Free(IN uint32_t index);
+
+    /**
+     * @brief move timers of the slot to lower levels
+     *
+     * @param level [in] 1 ~ LEVELS - 1
+     * @param slot  [in]
+     */
+    void Cascade(IN uint32_t level, IN uint32_t slot);
+
+    /**
+     * @brief find occupied slot, circular
+     *
+     * @param level [in]
+     * @param from  [in] first slot to check
+     * @return uint32_t distance from "from" (SLOTS: empty level)
+     */
+    uint32_t Find(IN uint32_t level, IN uint32_t from) const;
+
+private:
+    static const uint32_t BITS   = 8;
+    static const uint32_t SLOTS  = 1 << BITS;
+    static const uint32_t MASK   = SLOTS - 1;
+    static const uint32_t LEVELS = 4;
+    static const uint32_t NIL    = UINT32_MAX;
+
+private:
+    /**
+     * @brief timer, intrusive list node
+     */
+    struct Node
+    {
+        uint64_t expire; // tick
+        uint64_t period; // tick, 0: once
+        Callback callback;
+        void*    context;
+        uint32_t prev;
+        uint32_t next;
+        uint32_t slot;       // level * SLOTS + index, NIL: free
+        uint32_t generation; // handle validation
+    };
+
+    /**
+     * @brief collected callback
+     */
+    struct Expired
+    {
+        Callback callback; // nullptr: canceled after collected
+        void*    context;
+        Handle   handle;
+    };
+
+    /**
+     * @brief callbacks of a running Advance() call
+     */
+    struct Batch
+    {
+        std::vector<Expired> expired;
+        size_t               next;    // index of the next callback
+        Handle               calling; // running callback, INVALID: none
+        std::thread::id      thread;
+    };
+
+private:
+    /**
+     * @brief collect timers of the current tick, reinsert periodic timers
+     *
+     * @param std::vector<Expired> [out] appended
+     */
+    void Expire(OUT std::vector<Expired>&);
+
+private:
+    std::vector<Node> nodes;
+    uint32_t          freeHead;
+    size_t            count;
+
+    uint32_t heads[LEVELS][SLOTS];
+    uint64_t occupied[LEVELS][SLOTS / 64];
+
+    uint64_t base;    // Clock::Now() at construction
+    uint64_t tickNS;  // tick as nanoseconds
+    uint64_t current; // processed tick
+
+    std::vector<Expired> spare;   // reused collecting buffer
+    std::vector<Batch*>  batches; // running Advance() calls
+
+    mutable LockGuard::WrappedAdaptive lock;
+};
+
+#endif